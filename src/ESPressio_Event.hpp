@@ -7,9 +7,12 @@
 #include <ESPressio_TimeTraits.hpp>
 
 #include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
 #include "ESPressio_EventEnums.hpp"
 #include "ESPressio_EventObserver.hpp"
 #include "ESPressio_EventManager.hpp"
+#include "ESPressio_EventScheduler.hpp"
+#include "ESPressio_EventSpan.hpp"
 
 namespace ESPressio {
 
@@ -106,6 +109,79 @@ namespace ESPressio {
                 EventDispatchContext
                     _dispatchContext{};
 
+                std::atomic<uint64_t>
+                    _timeToLiveNanoseconds{0};
+
+                std::atomic<EventManager*>
+                    _eventBus{nullptr};
+
+
+                static EventManager*
+                GetTargetBus(
+                    const IEvent* event
+                ) {
+                    EventManager* bus =
+                        event == nullptr
+                            ? nullptr
+                            : event->GetEventBus();
+
+                    return
+                        bus == nullptr
+                            ? EventManager::
+                                GetInstance()
+                            : bus;
+                }
+
+
+                /*
+                 * Calls add(bus, run) for each run of consecutive Events
+                 * in events that target the same bus.
+                 */
+                template<typename TAdd>
+                static void ForEachBusRun(
+                    EventSpan events,
+                    TAdd&& add
+                ) {
+                    size_t start = 0;
+
+                    while (start < events.size()) {
+                        EventManager* bus =
+                            GetTargetBus(
+                                events[start]
+                            );
+
+                        size_t end = start + 1;
+
+                        while (
+                            end < events.size() &&
+                            GetTargetBus(
+                                events[end]
+                            ) == bus
+                        ) {
+                            ++end;
+                        }
+
+                        add(
+                            bus,
+                            EventSpan(
+                                events.data() + start,
+                                end - start
+                            )
+                        );
+
+                        start = end;
+                    }
+                }
+
+
+                EventManager*
+                GetTargetBus() const {
+                    return
+                        GetTargetBus(
+                            this
+                        );
+                }
+
 
                 static uint64_t
                 GetResolutionNanoseconds() {
@@ -134,6 +210,18 @@ namespace ESPressio {
 
                 static uint64_t
                 GetNowNanoseconds() {
+#if ESPRESSIO_EVENT_SIMULATION
+                    if (
+                        EventClock::
+                            GetOverride() !=
+                        nullptr
+                    ) {
+                        return
+                            EventClock::
+                                GetNowNanoseconds();
+                    }
+#endif
+
                     auto& clock =
                         Timing::SystemClock<
                             TTime
@@ -275,8 +363,7 @@ namespace ESPressio {
                     EventPriority priority =
                         EventPriority::Normal
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    GetTargetBus()->
                         QueueEvent(
                             this,
                             priority
@@ -288,8 +375,7 @@ namespace ESPressio {
                     EventPriority priority =
                         EventPriority::Normal
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    GetTargetBus()->
                         StackEvent(
                             this,
                             priority
@@ -297,6 +383,196 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Targets bus (see EventManager::CreateBus) for Queue(),
+                 * Stack(), Dispatch() and delayed queueing. nullptr, the
+                 * default, targets the default bus.
+                 */
+                void SetEventBus(
+                    EventManager* bus
+                ) noexcept {
+                    _eventBus.store(
+                        bus,
+                        std::memory_order_relaxed
+                    );
+                }
+
+
+                EventManager*
+                GetEventBus()
+                    const override {
+                    return
+                        _eventBus.load(
+                            std::memory_order_relaxed
+                        );
+                }
+
+
+                /*
+                 * Delivers this Event to its receivers from the calling
+                 * thread through EventManager::DispatchNow, skipping the
+                 * EventManager queue and its wake-up. Intended for
+                 * latency-critical local Events; see DispatchNow for the
+                 * ordering consequences.
+                 */
+                void Dispatch(
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod dispatchMethod =
+                        EventDispatchMethod::Queue
+                ) {
+                    GetTargetBus()->
+                        DispatchNow(
+                            this,
+                            priority,
+                            dispatchMethod
+                        );
+                }
+
+
+                /*
+                 * Queue/Stack with a time-to-live. Receivers that drain the
+                 * Event after the TTL has passed release it without
+                 * dispatching it to any listener.
+                 */
+                void Queue(
+                    EventPriority priority,
+                    TTime timeToLive
+                ) {
+                    SetTimeToLive(
+                        timeToLive
+                    );
+
+                    Queue(
+                        priority
+                    );
+                }
+
+
+                void Stack(
+                    EventPriority priority,
+                    TTime timeToLive
+                ) {
+                    SetTimeToLive(
+                        timeToLive
+                    );
+
+                    Stack(
+                        priority
+                    );
+                }
+
+
+                /*
+                 * Queues this Event once delay has passed, without a Thread
+                 * per timer. Delays are rounded up to the scheduler's timer
+                 * wheel tick. Cancel the returned handle to drop the Event
+                 * before it is queued.
+                 */
+                EventScheduleHandle QueueAfter(
+                    TTime delay,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) {
+                    return
+                        EventScheduler::
+                            GetInstance()->
+                            ScheduleAfter(
+                                this,
+                                Timing::TimeTraits<
+                                    TTime
+                                >::template
+                                    ToNanoseconds<
+                                        uint64_t
+                                    >(
+                                        delay
+                                    ),
+                                priority
+                            );
+                }
+
+
+                /*
+                 * Queues this Event at time on the SystemClock of TTime. A
+                 * time already passed queues it on the scheduler's next
+                 * wake-up.
+                 */
+                EventScheduleHandle QueueAt(
+                    TTime time,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) {
+                    const uint64_t target =
+                        Timing::TimeTraits<
+                            TTime
+                        >::template
+                            ToNanoseconds<
+                                uint64_t
+                            >(
+                                time
+                            );
+
+                    const uint64_t now =
+                        GetNowNanoseconds();
+
+                    return
+                        EventScheduler::
+                            GetInstance()->
+                            ScheduleAfter(
+                                this,
+                                target > now
+                                    ? target - now
+                                    : 0,
+                                priority
+                            );
+                }
+
+
+                /*
+                 * Queue a burst of Events through the EventManager with a
+                 * single lock acquisition and a single manager wake-up per
+                 * run of consecutive Events targeting the same bus.
+                 */
+                static void QueueAll(
+                    EventSpan events,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) {
+                    ForEachBusRun(
+                        events,
+                        [priority](
+                            EventManager* bus,
+                            EventSpan run
+                        ) {
+                            bus->QueueEvents(
+                                run,
+                                priority
+                            );
+                        }
+                    );
+                }
+
+
+                static void StackAll(
+                    EventSpan events,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) {
+                    ForEachBusRun(
+                        events,
+                        [priority](
+                            EventManager* bus,
+                            EventSpan run
+                        ) {
+                            bus->StackEvents(
+                                run,
+                                priority
+                            );
+                        }
+                    );
+                }
+
+
                 uint64_t
                 GetDispatchTimeNanoseconds()
                     const override {
@@ -337,6 +613,47 @@ namespace ESPressio {
                 }
 
 
+                uint64_t
+                GetTimeToLiveNanoseconds()
+                    const override {
+
+                    return
+                        _timeToLiveNanoseconds.load(
+                            std::memory_order_relaxed
+                        );
+                }
+
+
+                /*
+                 * Zero clears the time-to-live. Set it before the Event is
+                 * queued; receivers capture the expiry when they accept it.
+                 */
+                void SetTimeToLiveNanoseconds(
+                    uint64_t timeToLive
+                ) noexcept {
+                    _timeToLiveNanoseconds.store(
+                        timeToLive,
+                        std::memory_order_relaxed
+                    );
+                }
+
+
+                void SetTimeToLive(
+                    TTime timeToLive
+                ) {
+                    SetTimeToLiveNanoseconds(
+                        Timing::TimeTraits<
+                            TTime
+                        >::template
+                            ToNanoseconds<
+                                uint64_t
+                            >(
+                                timeToLive
+                            )
+                    );
+                }
+
+
                 TTime GetDispatchTime() const {
                     return
                         CreateTime(
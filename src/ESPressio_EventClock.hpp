@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <ESPressio_SystemClock.hpp>
+#include <ESPressio_TimeTraits.hpp>
+
+#include "ESPressio_IEvent.hpp"
+
+/*
+ * Enables the deterministic simulation mode (see EventSimulation). When
+ * zero (the default) the Event engine reads the System Clock directly and
+ * every Thread runs as usual.
+ */
+#ifndef ESPRESSIO_EVENT_SIMULATION
+    #define ESPRESSIO_EVENT_SIMULATION 0
+#endif
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * The clock the Event engine reads for lifecycle timestamps, drain
+         * budgets, time-to-live, latency histograms and delayed or periodic
+         * Events.
+         *
+         * In simulation builds an installed override replaces the System
+         * Clock for all of them at once, so a virtual clock drives every
+         * timing decision. Otherwise this is the System Clock.
+         */
+        class EventClock {
+            private:
+#if ESPRESSIO_EVENT_SIMULATION
+                static std::atomic<Timing::ISystemClock<EventTime>*>& Override() {
+                    static std::atomic<Timing::ISystemClock<EventTime>*> clock{nullptr};
+                    return clock;
+                }
+#endif
+
+            public:
+                /*
+                 * Installs clock for the whole process; nullptr restores the
+                 * System Clock. Returns the previous override. Always
+                 * nullptr, and ignored, outside simulation builds.
+                 */
+                static Timing::ISystemClock<EventTime>* SetOverride(
+                    Timing::ISystemClock<EventTime>* clock
+                ) noexcept {
+#if ESPRESSIO_EVENT_SIMULATION
+                    return Override().exchange(clock, std::memory_order_acq_rel);
+#else
+                    (void)clock;
+                    return nullptr;
+#endif
+                }
+
+                static Timing::ISystemClock<EventTime>* GetOverride() noexcept {
+#if ESPRESSIO_EVENT_SIMULATION
+                    return Override().load(std::memory_order_acquire);
+#else
+                    return nullptr;
+#endif
+                }
+
+                static Timing::ISystemClock<EventTime>& Get() noexcept {
+                    Timing::ISystemClock<EventTime>* clock = GetOverride();
+                    return clock == nullptr
+                        ? Timing::SystemClock<EventTime>::GetInstance()
+                        : *clock;
+                }
+
+                static uint64_t GetNowNanoseconds() {
+                    return Timing::TimeTraits<EventTime>::template
+                        ToNanoseconds<uint64_t>(Get().GetTime());
+                }
+        };
+
+    }
+
+}
@@ -1,19 +1,55 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
 #include "ESPressio_IEvent.hpp"
 #include "ESPressio_EventReceiver.hpp"
+#include "ESPressio_EventRingBuffer.hpp"
+#include "ESPressio_EventSpan.hpp"
+#include "ESPressio_EventTypeID.hpp"
+
+#ifndef ESPRESSIO_EVENT_DISPATCH_WORKER_QUEUE_CAPACITY
+    #define ESPRESSIO_EVENT_DISPATCH_WORKER_QUEUE_CAPACITY 64
+#endif
+
+/*
+ * Reader slots of an EventDispatcher's routing table, and as many again
+ * for deliveries in flight: enough for the dispatching thread, each
+ * dispatch worker and a nested dispatch. Readers never wait for a slot;
+ * when all are taken they share one overflow counter, and retired tables
+ * or buckets are only freed once it drops to zero.
+ */
+#ifndef ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT
+    #define ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT 4
+#endif
 
 namespace ESPressio {
 
     namespace Event {
 
+        /*
+         * Discard drops an Event that has no receiver and whose type is not
+         * observed (see EventDispatcher::RegisterObservedEventType) when it
+         * is queued, before it is stamped, referenced or woken for.
+         */
+        enum class UnobservedEventPolicy : uint8_t {
+            Dispatch,
+            Discard
+        };
+
+
         class IEventDispatcher {
             public:
                 virtual ~IEventDispatcher() =
@@ -41,246 +77,2439 @@ namespace ESPressio {
                         IEventReceiver*
                     >;
 
+                /*
+                 * Shared between successive routing tables, so a
+                 * registration only copies the bucket it changes.
+                 */
                 using EventReceiverBucketSnapshot =
                     std::shared_ptr<
                         const EventReceiverBucket
                     >;
 
-                using EventReceiverTypeMap =
+                /*
+                 * Receivers subscribed to one Event type and routing key.
+                 */
+                using KeyedEventReceiverIndex =
                     std::unordered_map<
-                        std::type_index,
-                        EventReceiverBucketSnapshot
+                        uint64_t,
+                        EventReceiverBucket
+                    >;
+
+                using KeyedEventReceiverIndexSnapshot =
+                    std::shared_ptr<
+                        const KeyedEventReceiverIndex
                     >;
 
+                /*
+                 * Receivers of one concrete Event type. While polymorphic
+                 * subscriptions exist, an unresolved route holds only the
+                 * exact-type receivers and is completed on first dispatch.
+                 * Keyed receivers are exact-type only and always resolved.
+                 */
+                struct EventReceiverRoute {
+                    EventReceiverBucketSnapshot receivers;
+                    KeyedEventReceiverIndexSnapshot keyedReceivers;
+                    bool resolved = false;
+                    bool observed = false;
+                    uint32_t observerInterest = 0;
+                };
+
+                /*
+                 * routes is indexed by EventTypeID; entry 0 is never used.
+                 */
+                struct EventReceiverTypeTable {
+                    std::vector<EventReceiverRoute> routes;
+                    bool polymorphic = false;
+                };
+
+                struct PolymorphicEventReceiver {
+                    EventTypeID baseType = 0;
+                    EventTypeMatcher matcher = nullptr;
+                    IEventReceiver* receiver = nullptr;
+                };
+
+
+                /*
+                 * Registrations the published routes are built from; only
+                 * touched under _eventReceiversMutex.
+                 */
+                std::vector<EventReceiverBucket>
+                    _exactEventReceivers;
+
+                std::vector<PolymorphicEventReceiver>
+                    _polymorphicEventReceivers;
+
+                std::vector<KeyedEventReceiverIndex>
+                    _keyedEventReceivers;
+
+                /*
+                 * Registrations per EventTypeID of consumers outside the
+                 * receiver routes, and the interest bits they declared.
+                 */
+                struct ObservedEventType {
+                    uint32_t registrations = 0;
+                    uint32_t observerInterest = 0;
+                };
+
+                std::vector<ObservedEventType>
+                    _observedEventTypes;
+
+
+                std::atomic<UnobservedEventPolicy>
+                    _unobservedEventPolicy{
+                        UnobservedEventPolicy::Dispatch
+                    };
+
+                std::atomic<uint64_t>
+                    _discardedUnobservedEventCount{
+                        0
+                    };
+
+
+                /*
+                 * The routing table is immutable once published. Readers
+                 * announce the epoch they entered in a reader slot and load
+                 * the table without locks or reference counts. Writers,
+                 * serialised by _eventReceiversMutex, publish a modified
+                 * copy, advance the epoch and retire the previous table
+                 * until every reader that could still see it has left.
+                 * Deliveries announce their epoch in a delivery slot and
+                 * use raw bucket pointers; a freed table's buckets are
+                 * kept until every delivery that could use them is done.
+                 */
+                std::atomic<
+                    const EventReceiverTypeTable*
+                > _eventReceivers{
+                    nullptr
+                };
+
+                std::atomic<uint64_t>
+                    _routingEpoch{
+                        1
+                    };
+
+                /*
+                 * Zero while the slot is free, otherwise the epoch its
+                 * reader entered.
+                 */
+                mutable std::array<
+                    std::atomic<uint64_t>,
+                    ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT
+                > _routingReaders{};
+
+                /*
+                 * Readers that found every slot taken. While non-zero no
+                 * retired table is freed, since their epochs are unknown.
+                 */
+                mutable std::atomic<size_t>
+                    _overflowRoutingReaders{
+                        0
+                    };
+
+                mutable std::array<
+                    std::atomic<uint64_t>,
+                    ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT
+                > _deliveryReaders{};
+
+                mutable std::atomic<size_t>
+                    _overflowDeliveryReaders{
+                        0
+                    };
+
+                struct RetiredEventReceiverTypeTable {
+                    std::unique_ptr<
+                        const EventReceiverTypeTable
+                    > table;
+                    uint64_t epoch = 0;
+                };
+
+                std::vector<
+                    RetiredEventReceiverTypeTable
+                > _retiredEventReceivers;
+
+                std::atomic<size_t>
+                    _retiredEventReceiverCount{
+                        0
+                    };
+
+                /*
+                 * Buckets of a freed routing table that a delivery which
+                 * entered before epoch may still be walking.
+                 */
+                struct RetiredEventReceiverBuckets {
+                    std::vector<
+                        EventReceiverBucketSnapshot
+                    > receivers;
+                    std::vector<
+                        KeyedEventReceiverIndexSnapshot
+                    > keyedReceivers;
+                    uint64_t epoch = 0;
+                };
+
+                std::vector<
+                    RetiredEventReceiverBuckets
+                > _retiredEventReceiverBuckets;
 
-                EventReceiverTypeMap
-                    _eventReceivers;
+                std::atomic<size_t>
+                    _retiredEventReceiverBucketCount{
+                        0
+                    };
 
                 mutable std::mutex
                     _eventReceiversMutex;
 
 
-                EventReceiverBucketSnapshot
-                GetEventTypeBucketSnapshot(
-                    std::type_index type
-                ) const {
-                    std::lock_guard<
-                        std::mutex
-                    > lock(
-                        _eventReceiversMutex
-                    );
+                struct DispatchWorkItem {
+                    IEvent* event = nullptr;
+                    EventTypeID type = 0;
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue;
+                    EventPriority priority =
+                        EventPriority::Normal;
+                };
 
-                    const auto found =
-                        _eventReceivers.find(
-                            type
-                        );
 
-                    return
-                        found ==
-                            _eventReceivers.end()
-                            ? EventReceiverBucketSnapshot{}
-                            : found->second;
-                }
+                /*
+                 * Bounded FIFO feeding one dispatch worker. items is filled
+                 * by the dispatching thread; the worker swaps it with its
+                 * equally sized batch, so neither side allocates once the
+                 * workers are started.
+                 */
+                struct DispatchWorker {
+                    mutable std::mutex mutex;
+                    std::condition_variable itemsAvailable;
+                    std::condition_variable spaceAvailable;
+                    EventRingBuffer<DispatchWorkItem> items;
+                    EventRingBuffer<DispatchWorkItem> batch;
+                    uint64_t deliveredEventCount = 0;
+                    bool stopping = false;
+                };
 
 
-            protected:
-                virtual void OnEventDispatched(
-                    IEvent*,
-                    EventDispatchMethod,
-                    EventPriority
+                std::unique_ptr<DispatchWorker[]>
+                    _dispatchWorkers;
+
+                size_t _dispatchWorkerCount = 0;
+
+                size_t _dispatchWorkerQueueCapacity = 0;
+
+
+                /*
+                 * Claims a free slot of slots, starting at hint, and
+                 * announces epoch in it. When every slot is taken the
+                 * reader joins overflow instead and null is returned, so
+                 * claiming never waits.
+                 */
+                static std::atomic<uint64_t>* ClaimReaderSlot(
+                    std::array<
+                        std::atomic<uint64_t>,
+                        ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT
+                    >& slots,
+                    std::atomic<size_t>& overflow,
+                    uint64_t epoch,
+                    size_t hint
                 ) {
-                }
+                    const size_t count =
+                        slots.size();
 
+                    for (
+                        size_t offset = 0;
+                        offset < count;
+                        ++offset
+                    ) {
+                        std::atomic<uint64_t>& slot =
+                            slots[
+                                (hint + offset) % count
+                            ];
+                        uint64_t expected = 0;
 
-                void ClearEventReceivers() {
-                    std::lock_guard<
-                        std::mutex
-                    > lock(
-                        _eventReceiversMutex
+                        if (
+                            slot.compare_exchange_strong(
+                                expected,
+                                epoch
+                            )
+                        ) {
+                            return &slot;
+                        }
+                    }
+
+                    overflow.fetch_add(
+                        1
                     );
+                    return nullptr;
+                }
 
-                    _eventReceivers.clear();
+
+                static void ReleaseReaderSlot(
+                    std::atomic<uint64_t>* slot,
+                    std::atomic<size_t>& overflow
+                ) {
+                    if (slot == nullptr) {
+                        overflow.fetch_sub(
+                            1,
+                            std::memory_order_release
+                        );
+                    } else {
+                        slot->store(
+                            0,
+                            std::memory_order_release
+                        );
+                    }
                 }
 
 
-                void DispatchEvents() {
-                    WithEvents(
-                        [&](
-                            IEvent* event,
-                            EventDispatchMethod
-                                dispatchMethod,
-                            EventPriority priority
-                        ) {
-                            event->__dispatch();
+                /*
+                 * Keeps every routing table loaded while it is alive from
+                 * being reclaimed, by announcing the current epoch in a
+                 * reader slot.
+                 */
+                class RoutingReadGuard final {
+                    private:
+                        const EventDispatcher& _dispatcher;
+                        std::atomic<uint64_t>* _slot;
 
-                            OnEventDispatched(
-                                event,
-                                dispatchMethod,
-                                priority
+                    public:
+                        RoutingReadGuard(
+                            const EventDispatcher& dispatcher,
+                            size_t hint
+                        ) :
+                            _dispatcher(dispatcher),
+                            _slot(
+                                ClaimReaderSlot(
+                                    dispatcher._routingReaders,
+                                    dispatcher._overflowRoutingReaders,
+                                    dispatcher._routingEpoch.load(),
+                                    hint
+                                )
+                            ) { }
+
+                        ~RoutingReadGuard() {
+                            ReleaseReaderSlot(
+                                _slot,
+                                _dispatcher._overflowRoutingReaders
                             );
+                        }
 
-                            const auto receivers =
-                                GetEventTypeBucketSnapshot(
-                                    std::type_index(
-                                        typeid(*event)
-                                    )
-                                );
+                        RoutingReadGuard(const RoutingReadGuard&) = delete;
+                        RoutingReadGuard& operator=(
+                            const RoutingReadGuard&
+                        ) = delete;
+                };
 
-                            if (!receivers) {
-                                return;
-                            }
 
-                            for (
-                                IEventReceiver*
-                                    receiver :
-                                *receivers
-                            ) {
-                                if (
-                                    receiver ==
-                                    nullptr
-                                ) {
-                                    continue;
-                                }
+                /*
+                 * Keeps the receiver buckets of every routing table loaded
+                 * by a RoutingReadGuard entered while it is alive, so an
+                 * Event can be delivered from raw bucket pointers after
+                 * the routing read is left. Only buckets are held back; a
+                 * receiver that blocks never delays freeing the tables.
+                 */
+                class DeliveryGuard final {
+                    private:
+                        const EventDispatcher& _dispatcher;
+                        std::atomic<uint64_t>* _slot;
 
-                                if (
-                                    dispatchMethod ==
-                                    EventDispatchMethod::
-                                        Queue
-                                ) {
-                                    receiver->
-                                        QueueEvent(
-                                            event,
-                                            priority
-                                        );
-                                } else {
-                                    receiver->
-                                        StackEvent(
-                                            event,
-                                            priority
-                                        );
-                                }
-                            }
+                    public:
+                        DeliveryGuard(
+                            const EventDispatcher& dispatcher,
+                            size_t hint
+                        ) :
+                            _dispatcher(dispatcher),
+                            _slot(
+                                ClaimReaderSlot(
+                                    dispatcher._deliveryReaders,
+                                    dispatcher._overflowDeliveryReaders,
+                                    dispatcher._routingEpoch.load(),
+                                    hint
+                                )
+                            ) { }
+
+                        ~DeliveryGuard() {
+                            ReleaseReaderSlot(
+                                _slot,
+                                _dispatcher._overflowDeliveryReaders
+                            );
                         }
-                    );
-                }
 
+                        DeliveryGuard(const DeliveryGuard&) = delete;
+                        DeliveryGuard& operator=(
+                            const DeliveryGuard&
+                        ) = delete;
+                };
 
-            public:
-                EventDispatcher() =
-                    default;
 
+                /*
+                 * Only valid inside a RoutingReadGuard. The load is
+                 * sequentially consistent with the guard's slot claim and
+                 * the writer's publish, so either the writer sees this
+                 * reader's slot or this reader sees the new table.
+                 */
+                const EventReceiverBucket*
+                GetEventTypeBucket(
+                    IEvent* event,
+                    EventTypeID type
+                ) {
+                    const EventReceiverTypeTable* table =
+                        _eventReceivers.load();
 
-                ~EventDispatcher()
-                    override {
-                    ClearEventReceivers();
-                }
+                    if (table == nullptr) {
+                        return nullptr;
+                    }
 
+                    if (type < table->routes.size()) {
+                        const EventReceiverRoute& route =
+                            table->routes[
+                                type
+                            ];
 
-                void RegisterReceiver(
-                    std::type_index type,
-                    IEventReceiver* receiver
-                ) override {
-                    if (receiver == nullptr) {
-                        return;
+                        if (
+                            route.resolved ||
+                            !table->polymorphic
+                        ) {
+                            return
+                                route.receivers.get();
+                        }
+                    } else if (!table->polymorphic) {
+                        return nullptr;
                     }
 
+                    return
+                        ResolveEventTypeBucket(
+                            event,
+                            type
+                        );
+                }
+
+
+                /*
+                 * Completes the route of event's concrete type with every
+                 * polymorphic subscription whose base it derives from and
+                 * publishes it, so each concrete type pays for the
+                 * hierarchy check once. Only valid inside a
+                 * RoutingReadGuard.
+                 */
+                const EventReceiverBucket*
+                ResolveEventTypeBucket(
+                    IEvent* event,
+                    EventTypeID type
+                ) {
                     std::lock_guard<
                         std::mutex
                     > lock(
                         _eventReceiversMutex
                     );
 
-                    EventReceiverBucket bucket;
-
-                    const auto found =
-                        _eventReceivers.find(
-                            type
+                    const EventReceiverTypeTable* current =
+                        _eventReceivers.load(
+                            std::memory_order_relaxed
                         );
 
+                    if (current == nullptr) {
+                        return nullptr;
+                    }
+
                     if (
-                        found !=
-                            _eventReceivers.end() &&
-                        found->second
+                        type < current->routes.size() &&
+                        (
+                            current->routes[type].resolved ||
+                            !current->polymorphic
+                        )
                     ) {
+                        return
+                            current->routes[
+                                type
+                            ].receivers.get();
+                    }
+
+                    EventReceiverBucket bucket;
+
+                    if (type < _exactEventReceivers.size()) {
                         bucket =
-                            *found->second;
+                            _exactEventReceivers[
+                                type
+                            ];
                     }
 
-                    if (
-                        std::find(
-                            bucket.begin(),
-                            bucket.end(),
-                            receiver
-                        ) !=
-                        bucket.end()
+                    for (
+                        const PolymorphicEventReceiver&
+                            subscription :
+                        _polymorphicEventReceivers
                     ) {
-                        return;
+                        if (
+                            std::find(
+                                bucket.begin(),
+                                bucket.end(),
+                                subscription.receiver
+                            ) ==
+                                bucket.end() &&
+                            subscription.matcher(
+                                event
+                            )
+                        ) {
+                            bucket.push_back(
+                                subscription.receiver
+                            );
+                        }
                     }
 
-                    bucket.push_back(
-                        receiver
-                    );
+                    std::unique_ptr<EventReceiverTypeTable> table =
+                        CopyEventReceiversLocked(
+                            type + 1
+                        );
+
+                    EventReceiverRoute& route =
+                        table->routes[
+                            type
+                        ];
 
-                    _eventReceivers[
+                    route.receivers =
+                        bucket.empty()
+                            ? EventReceiverBucketSnapshot{}
+                            : std::make_shared<
+                                const EventReceiverBucket
+                              >(
+                                std::move(bucket)
+                              );
+                    route.resolved =
+                        true;
+                    ApplyObservedEventTypeLocked(
+                        route,
                         type
-                    ] =
-                        std::make_shared<
-                            const EventReceiverBucket
-                        >(
-                            std::move(bucket)
+                    );
+
+                    const EventReceiverBucket* receivers =
+                        route.receivers.get();
+
+                    PublishEventReceiversLocked(
+                        std::move(table)
+                    );
+
+                    return receivers;
+                }
+
+
+                /*
+                 * The receivers subscribed to event's type and routing
+                 * key, or null. Only valid inside a RoutingReadGuard.
+                 */
+                const EventReceiverBucket*
+                GetKeyedEventTypeBucket(
+                    IEvent* event,
+                    EventTypeID type
+                ) const {
+                    const EventReceiverTypeTable* table =
+                        _eventReceivers.load();
+
+                    if (
+                        table == nullptr ||
+                        type >= table->routes.size() ||
+                        !table->routes[type].keyedReceivers
+                    ) {
+                        return nullptr;
+                    }
+
+                    uint64_t key = 0;
+
+                    if (!event->GetRoutingKey(key)) {
+                        return nullptr;
+                    }
+
+                    const KeyedEventReceiverIndexSnapshot& keyed =
+                        table->routes[
+                            type
+                        ].keyedReceivers;
+
+                    const auto found =
+                        keyed->find(
+                            key
                         );
+
+                    if (found == keyed->end()) {
+                        return nullptr;
+                    }
+
+                    return
+                        &found->second;
                 }
 
 
-                void UnregisterReceiver(
-                    std::type_index type,
-                    IEventReceiver* receiver
-                ) override {
-                    std::lock_guard<
-                        std::mutex
-                    > lock(
-                        _eventReceiversMutex
+                /*
+                 * Publishes table in place of the current routing table
+                 * and retires the previous one. Caller holds
+                 * _eventReceiversMutex.
+                 */
+                void PublishEventReceiversLocked(
+                    std::unique_ptr<
+                        const EventReceiverTypeTable
+                    > table
+                ) {
+                    std::unique_ptr<
+                        const EventReceiverTypeTable
+                    > previous(
+                        _eventReceivers.exchange(
+                            table.release()
+                        )
                     );
 
-                    const auto found =
-                        _eventReceivers.find(
-                            type
+                    const uint64_t retiredEpoch =
+                        _routingEpoch.fetch_add(1) + 1;
+
+                    if (previous) {
+                        _retiredEventReceivers.push_back(
+                            RetiredEventReceiverTypeTable{
+                                std::move(previous),
+                                retiredEpoch
+                            }
                         );
+                    }
 
-                    if (
-                        found ==
-                            _eventReceivers.end() ||
-                        !found->second
+                    ReclaimEventReceiversLocked();
+                }
+
+
+                /*
+                 * The epoch every reader in slots entered at or after, or
+                 * zero while an overflow reader of unknown epoch exists.
+                 */
+                static uint64_t OldestReaderEpoch(
+                    const std::array<
+                        std::atomic<uint64_t>,
+                        ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT
+                    >& slots,
+                    const std::atomic<size_t>& overflow
+                ) {
+                    if (overflow.load() != 0) {
+                        return 0;
+                    }
+
+                    uint64_t oldestReader =
+                        std::numeric_limits<uint64_t>::max();
+
+                    for (
+                        const std::atomic<uint64_t>& slot :
+                        slots
                     ) {
-                        return;
+                        const uint64_t epoch =
+                            slot.load();
+
+                        if (
+                            epoch != 0 &&
+                            epoch < oldestReader
+                        ) {
+                            oldestReader =
+                                epoch;
+                        }
                     }
 
-                    EventReceiverBucket bucket =
-                        *found->second;
+                    return oldestReader;
+                }
 
-                    bucket.erase(
-                        std::remove(
-                            bucket.begin(),
-                            bucket.end(),
-                            receiver
+
+                /*
+                 * Frees retired tables no reader can still hold: a table
+                 * retired at epoch E is only reachable by readers that
+                 * entered before E. An overflow reader may hold any of
+                 * them. Buckets of a freed table are kept while a delivery
+                 * that entered before E is in flight. Routing slots are
+                 * read before delivery slots, since a reader claims its
+                 * delivery slot before leaving its routing slot. Caller
+                 * holds _eventReceiversMutex.
+                 */
+                void ReclaimEventReceiversLocked() {
+                    const uint64_t oldestReader =
+                        OldestReaderEpoch(
+                            _routingReaders,
+                            _overflowRoutingReaders
+                        );
+
+                    const uint64_t oldestDelivery =
+                        OldestReaderEpoch(
+                            _deliveryReaders,
+                            _overflowDeliveryReaders
+                        );
+
+                    _retiredEventReceivers.erase(
+                        std::remove_if(
+                            _retiredEventReceivers.begin(),
+                            _retiredEventReceivers.end(),
+                            [&](
+                                RetiredEventReceiverTypeTable&
+                                    retired
+                            ) {
+                                if (retired.epoch > oldestReader) {
+                                    return false;
+                                }
+
+                                if (retired.epoch > oldestDelivery) {
+                                    RetainEventReceiverBucketsLocked(
+                                        *retired.table,
+                                        retired.epoch
+                                    );
+                                }
+
+                                return true;
+                            }
                         ),
-                        bucket.end()
+                        _retiredEventReceivers.end()
                     );
 
-                    if (bucket.empty()) {
-                        _eventReceivers.erase(
-                            found
-                        );
-                    } else {
-                        _eventReceivers[
-                            type
-                        ] =
-                            std::make_shared<
-                                const EventReceiverBucket
-                            >(
-                                std::move(bucket)
+                    _retiredEventReceiverBuckets.erase(
+                        std::remove_if(
+                            _retiredEventReceiverBuckets.begin(),
+                            _retiredEventReceiverBuckets.end(),
+                            [&](
+                                const RetiredEventReceiverBuckets&
+                                    retired
+                            ) {
+                                return
+                                    retired.epoch <=
+                                    oldestDelivery;
+                            }
+                        ),
+                        _retiredEventReceiverBuckets.end()
+                    );
+
+                    _retiredEventReceiverCount.store(
+                        _retiredEventReceivers.size()
+                    );
+                    _retiredEventReceiverBucketCount.store(
+                        _retiredEventReceiverBuckets.size()
+                    );
+                }
+
+
+                /*
+                 * Keeps the buckets of table, retired at epoch, for the
+                 * deliveries still in flight. Caller holds
+                 * _eventReceiversMutex.
+                 */
+                void RetainEventReceiverBucketsLocked(
+                    const EventReceiverTypeTable& table,
+                    uint64_t epoch
+                ) {
+                    RetiredEventReceiverBuckets retired;
+                    retired.epoch =
+                        epoch;
+
+                    for (
+                        const EventReceiverRoute& route :
+                        table.routes
+                    ) {
+                        if (route.receivers) {
+                            retired.receivers.push_back(
+                                route.receivers
                             );
+                        }
+
+                        if (route.keyedReceivers) {
+                            retired.keyedReceivers.push_back(
+                                route.keyedReceivers
+                            );
+                        }
                     }
+
+                    if (
+                        !retired.receivers.empty() ||
+                        !retired.keyedReceivers.empty()
+                    ) {
+                        _retiredEventReceiverBuckets.push_back(
+                            std::move(retired)
+                        );
+                    }
+                }
+
+
+                /*
+                 * Called by readers after leaving their guard, so tables
+                 * retired while they read are freed without waiting for
+                 * the next registration.
+                 */
+                void ReclaimEventReceivers() {
+                    if (
+                        _retiredEventReceiverCount.load(
+                            std::memory_order_relaxed
+                        ) == 0 &&
+                        _retiredEventReceiverBucketCount.load(
+                            std::memory_order_relaxed
+                        ) == 0
+                    ) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    ReclaimEventReceiversLocked();
+                }
+
+
+                /*
+                 * A modifiable copy of the current routing table, with at
+                 * least minimumSize entries. Caller holds
+                 * _eventReceiversMutex.
+                 */
+                std::unique_ptr<EventReceiverTypeTable>
+                CopyEventReceiversLocked(
+                    size_t minimumSize
+                ) const {
+                    const EventReceiverTypeTable* current =
+                        _eventReceivers.load(
+                            std::memory_order_relaxed
+                        );
+
+                    std::unique_ptr<EventReceiverTypeTable> table(
+                        current != nullptr
+                            ? new EventReceiverTypeTable(*current)
+                            : new EventReceiverTypeTable()
+                    );
+
+                    if (table->routes.size() < minimumSize) {
+                        table->routes.resize(
+                            minimumSize
+                        );
+                    }
+
+                    return table;
+                }
+
+
+                void ApplyObservedEventTypeLocked(
+                    EventReceiverRoute& route,
+                    EventTypeID type
+                ) const {
+                    if (type < _observedEventTypes.size()) {
+                        route.observed =
+                            _observedEventTypes[type].registrations > 0;
+                        route.observerInterest =
+                            _observedEventTypes[type].observerInterest;
+                    } else {
+                        route.observed = false;
+                        route.observerInterest = 0;
+                    }
+                }
+
+
+                /*
+                 * Publishes type's route rebuilt from its exact-type
+                 * receivers. Caller holds _eventReceiversMutex.
+                 */
+                void PublishEventReceiverRouteLocked(
+                    EventTypeID type
+                ) {
+                    std::unique_ptr<EventReceiverTypeTable> table =
+                        CopyEventReceiversLocked(
+                            type + 1
+                        );
+
+                    EventReceiverRoute& route =
+                        table->routes[
+                            type
+                        ];
+
+                    route.receivers =
+                        type >= _exactEventReceivers.size() ||
+                        _exactEventReceivers[type].empty()
+                            ? EventReceiverBucketSnapshot{}
+                            : std::make_shared<
+                                const EventReceiverBucket
+                              >(
+                                _exactEventReceivers[
+                                    type
+                                ]
+                              );
+                    route.resolved =
+                        !table->polymorphic;
+                    ApplyObservedEventTypeLocked(
+                        route,
+                        type
+                    );
+
+                    PublishEventReceiversLocked(
+                        std::move(table)
+                    );
+                }
+
+
+                /*
+                 * Publishes type's route with its keyed receiver index
+                 * rebuilt. Caller holds _eventReceiversMutex.
+                 */
+                void PublishKeyedEventReceiversLocked(
+                    EventTypeID type
+                ) {
+                    std::unique_ptr<EventReceiverTypeTable> table =
+                        CopyEventReceiversLocked(
+                            type + 1
+                        );
+
+                    table->routes[
+                        type
+                    ].keyedReceivers =
+                        _keyedEventReceivers[type].empty()
+                            ? KeyedEventReceiverIndexSnapshot{}
+                            : std::make_shared<
+                                const KeyedEventReceiverIndex
+                              >(
+                                _keyedEventReceivers[
+                                    type
+                                ]
+                              );
+
+                    PublishEventReceiversLocked(
+                        std::move(table)
+                    );
+                }
+
+
+                /*
+                 * Publishes a table with every route unresolved, after the
+                 * polymorphic subscriptions changed. Exact-type buckets are
+                 * shared with the previous table. Caller holds
+                 * _eventReceiversMutex.
+                 */
+                void PublishUnresolvedEventReceiversLocked() {
+                    std::unique_ptr<EventReceiverTypeTable> table(
+                        new EventReceiverTypeTable()
+                    );
+
+                    const EventReceiverTypeTable* current =
+                        _eventReceivers.load(
+                            std::memory_order_relaxed
+                        );
+
+                    table->polymorphic =
+                        !_polymorphicEventReceivers.empty();
+                    table->routes.resize(
+                        std::max({
+                            _exactEventReceivers.size(),
+                            _observedEventTypes.size(),
+                            _keyedEventReceivers.size()
+                        })
+                    );
+
+                    for (
+                        EventTypeID type = 0;
+                        type < table->routes.size();
+                        ++type
+                    ) {
+                        EventReceiverRoute& route =
+                            table->routes[
+                                type
+                            ];
+
+                        if (
+                            current != nullptr &&
+                            type < current->routes.size() &&
+                            (
+                                !current->polymorphic ||
+                                !current->routes[type].resolved
+                            )
+                        ) {
+                            route.receivers =
+                                current->routes[
+                                    type
+                                ].receivers;
+                        } else if (
+                            type < _exactEventReceivers.size() &&
+                            !_exactEventReceivers[type].empty()
+                        ) {
+                            route.receivers =
+                                std::make_shared<
+                                    const EventReceiverBucket
+                                >(
+                                    _exactEventReceivers[
+                                        type
+                                    ]
+                                );
+                        }
+
+                        if (
+                            current != nullptr &&
+                            type < current->routes.size()
+                        ) {
+                            route.keyedReceivers =
+                                current->routes[
+                                    type
+                                ].keyedReceivers;
+                        }
+
+                        route.resolved =
+                            !table->polymorphic;
+                        ApplyObservedEventTypeLocked(
+                            route,
+                            type
+                        );
+                    }
+
+                    PublishEventReceiversLocked(
+                        std::move(table)
+                    );
+                }
+
+
+                /*
+                 * Applies UnobservedEventPolicy::Discard to an Event being
+                 * queued. A discarded Event is referenced and released
+                 * once, so an Event nothing else holds is deleted.
+                 */
+                bool DiscardIfUnobserved(
+                    IEvent* event
+                ) {
+                    if (
+                        event == nullptr ||
+                        _unobservedEventPolicy.load(
+                            std::memory_order_relaxed
+                        ) !=
+                            UnobservedEventPolicy::Discard ||
+                        HasSubscribers(
+                            event
+                        )
+                    ) {
+                        return false;
+                    }
+
+                    _discardedUnobservedEventCount.fetch_add(
+                        1,
+                        std::memory_order_relaxed
+                    );
+
+                    event->__ref();
+                    event->__unref();
+                    return true;
+                }
+
+
+                template<typename TAdd>
+                void AddObservedEvents(
+                    EventSpan events,
+                    TAdd&& add
+                ) {
+                    constexpr size_t ChunkSize = 16;
+                    IEvent* chunk[ChunkSize];
+                    size_t count = 0;
+
+                    for (IEvent* event : events) {
+                        if (
+                            event == nullptr ||
+                            DiscardIfUnobserved(
+                                event
+                            )
+                        ) {
+                            continue;
+                        }
+
+                        chunk[count++] = event;
+
+                        if (count == ChunkSize) {
+                            add(
+                                EventSpan(
+                                    chunk,
+                                    count
+                                )
+                            );
+                            count = 0;
+                        }
+                    }
+
+                    if (count > 0) {
+                        add(
+                            EventSpan(
+                                chunk,
+                                count
+                            )
+                        );
+                    }
+                }
+
+
+                /*
+                 * The receivers of event, taken inside a RoutingReadGuard
+                 * and valid while the DeliveryGuard entered before it is
+                 * alive.
+                 */
+                struct EventDelivery {
+                    const EventReceiverBucket* receivers = nullptr;
+                    const EventReceiverBucket* keyedReceivers = nullptr;
+                };
+
+
+                // Only valid inside a RoutingReadGuard
+                EventDelivery GetEventDelivery(
+                    IEvent* event,
+                    EventTypeID type
+                ) {
+                    EventDelivery delivery;
+
+                    delivery.receivers =
+                        GetEventTypeBucket(
+                            event,
+                            type
+                        );
+
+                    delivery.keyedReceivers =
+                        GetKeyedEventTypeBucket(
+                            event,
+                            type
+                        );
+
+                    return delivery;
+                }
+
+
+                void DeliverEvent(
+                    IEvent* event,
+                    const EventDelivery& delivery,
+                    EventDispatchMethod dispatchMethod,
+                    EventPriority priority
+                ) {
+                    if (delivery.receivers != nullptr) {
+                        DeliverEventToBucket(
+                            event,
+                            *delivery.receivers,
+                            nullptr,
+                            dispatchMethod,
+                            priority
+                        );
+                    }
+
+                    if (delivery.keyedReceivers != nullptr) {
+                        DeliverEventToBucket(
+                            event,
+                            *delivery.keyedReceivers,
+                            delivery.receivers,
+                            dispatchMethod,
+                            priority
+                        );
+                    }
+                }
+
+
+
+                /*
+                 * Hands event to every receiver in bucket, skipping those
+                 * in delivered, so a receiver subscribed both to the type
+                 * and to a key receives each Event once.
+                 */
+                void DeliverEventToBucket(
+                    IEvent* event,
+                    const EventReceiverBucket& bucket,
+                    const EventReceiverBucket* delivered,
+                    EventDispatchMethod dispatchMethod,
+                    EventPriority priority
+                ) {
+                    for (
+                        IEventReceiver*
+                            receiver :
+                        bucket
+                    ) {
+                        if (
+                            receiver ==
+                                nullptr ||
+                            (
+                                delivered != nullptr &&
+                                std::find(
+                                    delivered->begin(),
+                                    delivered->end(),
+                                    receiver
+                                ) != delivered->end()
+                            )
+                        ) {
+                            continue;
+                        }
+
+                        if (
+                            dispatchMethod ==
+                            EventDispatchMethod::
+                                Queue
+                        ) {
+                            receiver->
+                                QueueEvent(
+                                    event,
+                                    priority
+                                );
+                        } else {
+                            receiver->
+                                StackEvent(
+                                    event,
+                                    priority
+                                );
+                        }
+                    }
+                }
+
+
+                /*
+                 * Hands the Event to the worker owning its type, waiting
+                 * while that worker's queue is full. Returns false once the
+                 * workers are stopping, in which case the caller delivers
+                 * the Event itself.
+                 */
+                bool ForwardToDispatchWorker(
+                    IEvent* event,
+                    EventTypeID type,
+                    EventDispatchMethod dispatchMethod,
+                    EventPriority priority
+                ) {
+                    DispatchWorker& worker =
+                        _dispatchWorkers[
+                            type %
+                            _dispatchWorkerCount
+                        ];
+
+                    {
+                        std::unique_lock<
+                            std::mutex
+                        > lock(
+                            worker.mutex
+                        );
+
+                        worker.spaceAvailable.wait(
+                            lock,
+                            [&]() {
+                                return
+                                    worker.stopping ||
+                                    worker.items.size() <
+                                        _dispatchWorkerQueueCapacity;
+                            }
+                        );
+
+                        if (worker.stopping) {
+                            return false;
+                        }
+
+                        event->__ref();
+
+                        worker.items.push_back(
+                            DispatchWorkItem{
+                                event,
+                                type,
+                                dispatchMethod,
+                                priority
+                            }
+                        );
+                    }
+
+                    worker.itemsAvailable.notify_one();
+                    return true;
+                }
+
+
+            protected:
+                /*
+                 * Runs inside a routing read, so overrides may call
+                 * GetEventTypeObserverInterestRouted().
+                 */
+                virtual void OnEventDispatched(
+                    IEvent*,
+                    EventDispatchMethod,
+                    EventPriority
+                ) {
+                }
+
+
+                /*
+                 * The observer interest bits registered for type, read
+                 * from the routing snapshot. Only valid inside a routing
+                 * read, i.e. from OnEventDispatched.
+                 */
+                uint32_t GetEventTypeObserverInterestRouted(
+                    EventTypeID type
+                ) const {
+                    const EventReceiverTypeTable* table =
+                        _eventReceivers.load();
+
+                    return
+                        table == nullptr ||
+                        type >= table->routes.size()
+                            ? 0
+                            : table->routes[type].observerInterest;
+                }
+
+
+                void ClearEventReceivers() {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    _exactEventReceivers.clear();
+                    _polymorphicEventReceivers.clear();
+                    _keyedEventReceivers.clear();
+                    _observedEventTypes.clear();
+
+                    PublishEventReceiversLocked(
+                        nullptr
+                    );
+                }
+
+
+                /*
+                 * With dispatch workers running, draining and
+                 * OnEventDispatched still run here, serially and in drain
+                 * order; only the receiver fan-out moves to the worker
+                 * owning the Event's type. Each Event's routing read
+                 * covers OnEventDispatched and the route lookup only, so
+                 * waiting for worker queue space or on a full receiver
+                 * never holds one; delivery only holds a DeliveryGuard.
+                 */
+                void DispatchEvents() {
+                    WithEvents(
+                        [&](
+                            IEvent* event,
+                            EventDispatchMethod
+                                dispatchMethod,
+                            EventPriority priority
+                        ) {
+                            event->__dispatch();
+
+                            const EventTypeID type =
+                                event->GetEventTypeID();
+
+                            const bool forwarding =
+                                _dispatchWorkerCount > 0;
+
+                            if (forwarding) {
+                                {
+                                    RoutingReadGuard routing(
+                                        *this,
+                                        0
+                                    );
+
+                                    OnEventDispatched(
+                                        event,
+                                        dispatchMethod,
+                                        priority
+                                    );
+                                }
+
+                                if (
+                                    ForwardToDispatchWorker(
+                                        event,
+                                        type,
+                                        dispatchMethod,
+                                        priority
+                                    )
+                                ) {
+                                    return;
+                                }
+                            }
+
+                            DeliveryGuard delivering(
+                                *this,
+                                0
+                            );
+
+                            EventDelivery delivery;
+                            {
+                                RoutingReadGuard routing(
+                                    *this,
+                                    0
+                                );
+
+                                if (!forwarding) {
+                                    OnEventDispatched(
+                                        event,
+                                        dispatchMethod,
+                                        priority
+                                    );
+                                }
+
+                                delivery =
+                                    GetEventDelivery(
+                                        event,
+                                        type
+                                    );
+                            }
+
+                            DeliverEvent(
+                                event,
+                                delivery,
+                                dispatchMethod,
+                                priority
+                            );
+                        }
+                    );
+
+                    ReclaimEventReceivers();
+                }
+
+
+                /*
+                 * Partitions receiver fan-out across workerCount dispatch
+                 * workers by EventTypeID. Each type always maps to the
+                 * same worker, and each worker delivers in FIFO order, so
+                 * per-type ordering matches single-threaded dispatch. The
+                 * caller runs ProcessDispatchWorker(index) for every worker
+                 * on threads of its choosing. Must be called before Events
+                 * are dispatched; returns false if workers already exist.
+                 */
+                bool StartDispatchWorkers(
+                    size_t workerCount,
+                    size_t queueCapacity =
+                        ESPRESSIO_EVENT_DISPATCH_WORKER_QUEUE_CAPACITY
+                ) {
+                    if (
+                        _dispatchWorkerCount > 0 ||
+                        workerCount == 0 ||
+                        queueCapacity == 0
+                    ) {
+                        return false;
+                    }
+
+                    std::unique_ptr<DispatchWorker[]> workers(
+                        new DispatchWorker[workerCount]
+                    );
+
+                    for (
+                        size_t index = 0;
+                        index < workerCount;
+                        ++index
+                    ) {
+                        workers[index].items.reserve(
+                            queueCapacity
+                        );
+                        workers[index].batch.reserve(
+                            queueCapacity
+                        );
+                    }
+
+                    _dispatchWorkers =
+                        std::move(workers);
+                    _dispatchWorkerQueueCapacity =
+                        queueCapacity;
+                    _dispatchWorkerCount =
+                        workerCount;
+                    return true;
+                }
+
+
+                /*
+                 * Waits for work on one dispatch worker and delivers
+                 * everything queued to it. Returns false once the worker has
+                 * been stopped and has nothing left to deliver.
+                 */
+                bool ProcessDispatchWorker(
+                    size_t workerIndex
+                ) {
+                    if (workerIndex >= _dispatchWorkerCount) {
+                        return false;
+                    }
+
+                    DispatchWorker& worker =
+                        _dispatchWorkers[
+                            workerIndex
+                        ];
+
+                    {
+                        std::unique_lock<
+                            std::mutex
+                        > lock(
+                            worker.mutex
+                        );
+
+                        worker.itemsAvailable.wait(
+                            lock,
+                            [&]() {
+                                return
+                                    worker.stopping ||
+                                    !worker.items.empty();
+                            }
+                        );
+
+                        if (worker.items.empty()) {
+                            return false;
+                        }
+
+                        worker.batch.swap(
+                            worker.items
+                        );
+                    }
+
+                    worker.spaceAvailable.notify_all();
+
+                    class BatchReferences final {
+                        private:
+                            EventRingBuffer<DispatchWorkItem>& _batch;
+                        public:
+                            explicit BatchReferences(
+                                EventRingBuffer<DispatchWorkItem>& batch
+                            ) : _batch(batch) { }
+                            ~BatchReferences() {
+                                while (!_batch.empty()) {
+                                    _batch.front().event->__unref();
+                                    _batch.pop_front();
+                                }
+                            }
+                    } references(worker.batch);
+
+                    size_t delivered = 0;
+                    while (!worker.batch.empty()) {
+                        const DispatchWorkItem item =
+                            worker.batch.front();
+
+                        {
+                            DeliveryGuard delivering(
+                                *this,
+                                workerIndex + 1
+                            );
+
+                            EventDelivery delivery;
+                            {
+                                RoutingReadGuard routing(
+                                    *this,
+                                    workerIndex + 1
+                                );
+
+                                delivery =
+                                    GetEventDelivery(
+                                        item.event,
+                                        item.type
+                                    );
+                            }
+
+                            DeliverEvent(
+                                item.event,
+                                delivery,
+                                item.method,
+                                item.priority
+                            );
+                        }
+
+                        worker.batch.pop_front();
+                        item.event->__unref();
+                        ++delivered;
+                    }
+
+                    ReclaimEventReceivers();
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        worker.mutex
+                    );
+
+                    worker.deliveredEventCount +=
+                        delivered;
+                    return true;
+                }
+
+
+                /*
+                 * Wakes every worker. Queued Events are still delivered by
+                 * ProcessDispatchWorker; Events dispatched afterwards are
+                 * delivered by the dispatching thread.
+                 */
+                void StopDispatchWorkers() {
+                    for (
+                        size_t index = 0;
+                        index < _dispatchWorkerCount;
+                        ++index
+                    ) {
+                        DispatchWorker& worker =
+                            _dispatchWorkers[
+                                index
+                            ];
+
+                        {
+                            std::lock_guard<
+                                std::mutex
+                            > lock(
+                                worker.mutex
+                            );
+
+                            worker.stopping =
+                                true;
+                        }
+
+                        worker.itemsAvailable.notify_all();
+                        worker.spaceAvailable.notify_all();
+                    }
+                }
+
+
+            public:
+                EventDispatcher() =
+                    default;
+
+
+                ~EventDispatcher()
+                    override {
+                    StopDispatchWorkers();
+
+                    for (
+                        size_t index = 0;
+                        index < _dispatchWorkerCount;
+                        ++index
+                    ) {
+                        EventRingBuffer<DispatchWorkItem>& items =
+                            _dispatchWorkers[
+                                index
+                            ].items;
+
+                        while (!items.empty()) {
+                            items.front().event->__unref();
+                            items.pop_front();
+                        }
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    delete _eventReceivers.exchange(
+                        nullptr
+                    );
+                    _retiredEventReceivers.clear();
+                    _retiredEventReceiverBuckets.clear();
+                }
+
+
+                /*
+                 * Routing tables replaced by a registration change but not
+                 * yet freed because a reader may still hold them.
+                 */
+                size_t GetRetiredRoutingTableCount() const {
+                    return
+                        _retiredEventReceiverCount.load();
+                }
+
+
+                /*
+                 * Freed routing tables whose receiver buckets are still
+                 * kept for deliveries in flight.
+                 */
+                size_t GetRetiredDeliveryBucketCount() const {
+                    return
+                        _retiredEventReceiverBucketCount.load();
+                }
+
+
+                /*
+                 * Delivers event to its receivers on the calling thread,
+                 * bypassing this dispatcher's own queue and wake-up. The
+                 * Event is stamped and observed exactly as a queued Event
+                 * would be, then routed through the same routing snapshot
+                 * straight into each receiver's queue. It may therefore
+                 * overtake Events still waiting in this dispatcher, and is
+                 * never handed to a dispatch worker. An Event no receiver
+                 * keeps is released before this returns.
+                 */
+                void DispatchNow(
+                    IEvent* event,
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod dispatchMethod =
+                        EventDispatchMethod::Queue
+                ) {
+                    if (event == nullptr) {
+                        return;
+                    }
+
+                    class EventReference final {
+                        private:
+                            IEvent* _event;
+                        public:
+                            explicit EventReference(
+                                IEvent* event
+                            ) : _event(event) {
+                                _event->__ref();
+                            }
+                            ~EventReference() {
+                                _event->__unref();
+                            }
+                    } reference(event);
+
+                    event->__dispatch();
+
+                    const size_t hint =
+                        std::hash<std::thread::id>()(
+                            std::this_thread::get_id()
+                        );
+
+                    {
+                        DeliveryGuard delivering(
+                            *this,
+                            hint
+                        );
+
+                        EventDelivery delivery;
+                        {
+                            RoutingReadGuard routing(
+                                *this,
+                                hint
+                            );
+
+                            OnEventDispatched(
+                                event,
+                                dispatchMethod,
+                                priority
+                            );
+
+                            delivery =
+                                GetEventDelivery(
+                                    event,
+                                    event->GetEventTypeID()
+                                );
+                        }
+
+                        /*
+                         * Outside the routing read: a receiver blocking
+                         * this producer under BlockProducer holds nothing
+                         * other dispatching threads need.
+                         */
+                        DeliverEvent(
+                            event,
+                            delivery,
+                            dispatchMethod,
+                            priority
+                        );
+                    }
+
+                    ReclaimEventReceivers();
+                }
+
+
+                void QueueEvent(
+                    IEvent* event,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) override {
+                    if (!DiscardIfUnobserved(event)) {
+                        EventReceiver::QueueEvent(
+                            event,
+                            priority
+                        );
+                    }
+                }
+
+
+                void StackEvent(
+                    IEvent* event,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) override {
+                    if (!DiscardIfUnobserved(event)) {
+                        EventReceiver::StackEvent(
+                            event,
+                            priority
+                        );
+                    }
+                }
+
+
+                void QueueEvents(
+                    EventSpan events,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) override {
+                    if (
+                        _unobservedEventPolicy.load(
+                            std::memory_order_relaxed
+                        ) !=
+                        UnobservedEventPolicy::Discard
+                    ) {
+                        EventReceiver::QueueEvents(
+                            events,
+                            priority
+                        );
+                        return;
+                    }
+
+                    AddObservedEvents(
+                        events,
+                        [&](EventSpan observed) {
+                            EventReceiver::QueueEvents(
+                                observed,
+                                priority
+                            );
+                        }
+                    );
+                }
+
+
+                void StackEvents(
+                    EventSpan events,
+                    EventPriority priority =
+                        EventPriority::Normal
+                ) override {
+                    if (
+                        _unobservedEventPolicy.load(
+                            std::memory_order_relaxed
+                        ) !=
+                        UnobservedEventPolicy::Discard
+                    ) {
+                        EventReceiver::StackEvents(
+                            events,
+                            priority
+                        );
+                        return;
+                    }
+
+                    AddObservedEvents(
+                        events,
+                        [&](EventSpan observed) {
+                            EventReceiver::StackEvents(
+                                observed,
+                                priority
+                            );
+                        }
+                    );
+                }
+
+
+                /*
+                 * Whether an Event of type would reach anyone: a receiver
+                 * registered for it, or a consumer that registered it as
+                 * observed. Reads the routing snapshot without locks. A
+                 * type not yet matched against polymorphic subscriptions
+                 * is reported as subscribed; HasSubscribers(event)
+                 * resolves it exactly.
+                 */
+                bool HasSubscribers(
+                    EventTypeID type
+                ) const {
+                    RoutingReadGuard routing(
+                        *this,
+                        std::hash<std::thread::id>()(
+                            std::this_thread::get_id()
+                        )
+                    );
+
+                    const EventReceiverTypeTable* table =
+                        _eventReceivers.load();
+
+                    if (table == nullptr) {
+                        return false;
+                    }
+
+                    if (type >= table->routes.size()) {
+                        return table->polymorphic;
+                    }
+
+                    const EventReceiverRoute& route =
+                        table->routes[
+                            type
+                        ];
+
+                    return
+                        route.observed ||
+                        route.observerInterest != 0 ||
+                        route.receivers ||
+                        route.keyedReceivers ||
+                        (
+                            table->polymorphic &&
+                            !route.resolved
+                        );
+                }
+
+
+                template<typename TEvent>
+                bool HasSubscribers() const {
+                    return
+                        HasSubscribers(
+                            EventTypeRegistry::Of<
+                                TEvent
+                            >()
+                        );
+                }
+
+
+                bool HasSubscribers(
+                    IEvent* event
+                ) {
+                    const EventTypeID type =
+                        event->GetEventTypeID();
+
+                    bool subscribed = false;
+                    {
+                        RoutingReadGuard routing(
+                            *this,
+                            std::hash<std::thread::id>()(
+                                std::this_thread::get_id()
+                            )
+                        );
+
+                        const EventReceiverTypeTable* table =
+                            _eventReceivers.load();
+
+                        subscribed =
+                            table != nullptr &&
+                            (
+                                (
+                                    type < table->routes.size() &&
+                                    (
+                                        table->routes[type].observed ||
+                                        table->routes[type]
+                                            .observerInterest != 0
+                                    )
+                                ) ||
+                                GetEventTypeBucket(
+                                    event,
+                                    type
+                                ) != nullptr ||
+                                GetKeyedEventTypeBucket(
+                                    event,
+                                    type
+                                ) != nullptr
+                            );
+                    }
+
+                    ReclaimEventReceivers();
+                    return subscribed;
+                }
+
+
+                void SetUnobservedEventPolicy(
+                    UnobservedEventPolicy policy
+                ) {
+                    _unobservedEventPolicy.store(
+                        policy
+                    );
+                }
+
+
+                UnobservedEventPolicy GetUnobservedEventPolicy() const {
+                    return
+                        _unobservedEventPolicy.load();
+                }
+
+
+                /*
+                 * Events dropped by UnobservedEventPolicy::Discard, i.e.
+                 * producer work that reached nobody.
+                 */
+                uint64_t GetDiscardedUnobservedEventCount() const {
+                    return
+                        _discardedUnobservedEventCount.load(
+                            std::memory_order_relaxed
+                        );
+                }
+
+
+                /*
+                 * Marks type as consumed outside the receiver routes, for
+                 * example by an EventManager observer such as the Event
+                 * Transport, so UnobservedEventPolicy::Discard keeps it.
+                 * Registrations are counted. observerInterest bits are
+                 * ORed into the type's route for
+                 * GetEventTypeObserverInterestRouted(); each bit must be
+                 * registered at most once per type.
+                 */
+                void RegisterObservedEventType(
+                    EventTypeID type,
+                    uint32_t observerInterest = 0
+                ) {
+                    if (type == 0) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (type >= _observedEventTypes.size()) {
+                        _observedEventTypes.resize(
+                            type + 1
+                        );
+                    }
+
+                    ObservedEventType& observed =
+                        _observedEventTypes[
+                            type
+                        ];
+
+                    const bool changed =
+                        observed.registrations++ == 0 ||
+                        (observed.observerInterest | observerInterest) !=
+                            observed.observerInterest;
+
+                    observed.observerInterest |=
+                        observerInterest;
+
+                    if (changed) {
+                        PublishEventReceiverRouteLocked(
+                            type
+                        );
+                    }
+                }
+
+
+                void UnregisterObservedEventType(
+                    EventTypeID type,
+                    uint32_t observerInterest = 0
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (
+                        type >= _observedEventTypes.size() ||
+                        _observedEventTypes[type].registrations == 0
+                    ) {
+                        return;
+                    }
+
+                    ObservedEventType& observed =
+                        _observedEventTypes[
+                            type
+                        ];
+
+                    const bool changed =
+                        --observed.registrations == 0 ||
+                        (observed.observerInterest & observerInterest) != 0;
+
+                    observed.observerInterest &=
+                        ~observerInterest;
+
+                    if (observed.registrations == 0) {
+                        observed.observerInterest = 0;
+                    }
+
+                    if (changed) {
+                        PublishEventReceiverRouteLocked(
+                            type
+                        );
+                    }
+                }
+
+
+                size_t GetDispatchWorkerCount() const {
+                    return _dispatchWorkerCount;
+                }
+
+
+                uint64_t GetDispatchWorkerEventCount(
+                    size_t workerIndex
+                ) const {
+                    if (workerIndex >= _dispatchWorkerCount) {
+                        return 0;
+                    }
+
+                    const DispatchWorker& worker =
+                        _dispatchWorkers[
+                            workerIndex
+                        ];
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        worker.mutex
+                    );
+
+                    return
+                        worker.deliveredEventCount;
+                }
+
+
+                void RegisterReceiver(
+                    std::type_index type,
+                    IEventReceiver* receiver
+                ) override {
+                    RegisterReceiver(
+                        EventTypeRegistry::Resolve(
+                            type
+                        ),
+                        receiver
+                    );
+                }
+
+
+                void RegisterReceiver(
+                    EventTypeID type,
+                    IEventReceiver* receiver
+                ) {
+                    if (
+                        receiver == nullptr ||
+                        type == 0
+                    ) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (
+                        type >=
+                        _exactEventReceivers.size()
+                    ) {
+                        _exactEventReceivers.resize(
+                            type + 1
+                        );
+                    }
+
+                    EventReceiverBucket& bucket =
+                        _exactEventReceivers[
+                            type
+                        ];
+
+                    if (
+                        std::find(
+                            bucket.begin(),
+                            bucket.end(),
+                            receiver
+                        ) !=
+                        bucket.end()
+                    ) {
+                        return;
+                    }
+
+                    bucket.push_back(
+                        receiver
+                    );
+
+                    PublishEventReceiverRouteLocked(
+                        type
+                    );
+                }
+
+
+                void UnregisterReceiver(
+                    std::type_index type,
+                    IEventReceiver* receiver
+                ) override {
+                    UnregisterReceiver(
+                        EventTypeRegistry::Resolve(
+                            type
+                        ),
+                        receiver
+                    );
+                }
+
+
+                void UnregisterReceiver(
+                    EventTypeID type,
+                    IEventReceiver* receiver
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (
+                        type >=
+                        _exactEventReceivers.size()
+                    ) {
+                        return;
+                    }
+
+                    EventReceiverBucket& bucket =
+                        _exactEventReceivers[
+                            type
+                        ];
+
+                    const size_t previousSize =
+                        bucket.size();
+
+                    bucket.erase(
+                        std::remove(
+                            bucket.begin(),
+                            bucket.end(),
+                            receiver
+                        ),
+                        bucket.end()
+                    );
+
+                    if (bucket.size() == previousSize) {
+                        return;
+                    }
+
+                    PublishEventReceiverRouteLocked(
+                        type
+                    );
+                }
+
+
+                /*
+                 * Routes Events of type whose IEvent::GetRoutingKey()
+                 * yields key to receiver. Delivery looks the key up in a
+                 * per-type hash index, so its cost depends on the
+                 * receivers of that key rather than on every keyed
+                 * receiver of the type. A receiver also registered for the
+                 * whole type receives each Event once.
+                 */
+                void RegisterKeyedReceiver(
+                    EventTypeID type,
+                    uint64_t key,
+                    IEventReceiver* receiver
+                ) {
+                    if (
+                        receiver == nullptr ||
+                        type == 0
+                    ) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (
+                        type >=
+                        _keyedEventReceivers.size()
+                    ) {
+                        _keyedEventReceivers.resize(
+                            type + 1
+                        );
+                    }
+
+                    EventReceiverBucket& bucket =
+                        _keyedEventReceivers[
+                            type
+                        ][
+                            key
+                        ];
+
+                    if (
+                        std::find(
+                            bucket.begin(),
+                            bucket.end(),
+                            receiver
+                        ) !=
+                        bucket.end()
+                    ) {
+                        return;
+                    }
+
+                    bucket.push_back(
+                        receiver
+                    );
+
+                    PublishKeyedEventReceiversLocked(
+                        type
+                    );
+                }
+
+
+                template<typename TEvent>
+                void RegisterKeyedReceiver(
+                    uint64_t key,
+                    IEventReceiver* receiver
+                ) {
+                    RegisterKeyedReceiver(
+                        EventTypeRegistry::Of<
+                            TEvent
+                        >(),
+                        key,
+                        receiver
+                    );
+                }
+
+
+                void UnregisterKeyedReceiver(
+                    EventTypeID type,
+                    uint64_t key,
+                    IEventReceiver* receiver
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    if (
+                        type >=
+                        _keyedEventReceivers.size()
+                    ) {
+                        return;
+                    }
+
+                    KeyedEventReceiverIndex& index =
+                        _keyedEventReceivers[
+                            type
+                        ];
+
+                    const auto found =
+                        index.find(
+                            key
+                        );
+
+                    if (found == index.end()) {
+                        return;
+                    }
+
+                    EventReceiverBucket& bucket =
+                        found->second;
+
+                    const size_t previousSize =
+                        bucket.size();
+
+                    bucket.erase(
+                        std::remove(
+                            bucket.begin(),
+                            bucket.end(),
+                            receiver
+                        ),
+                        bucket.end()
+                    );
+
+                    if (bucket.size() == previousSize) {
+                        return;
+                    }
+
+                    if (bucket.empty()) {
+                        index.erase(
+                            found
+                        );
+                    }
+
+                    PublishKeyedEventReceiversLocked(
+                        type
+                    );
+                }
+
+
+                template<typename TEvent>
+                void UnregisterKeyedReceiver(
+                    uint64_t key,
+                    IEventReceiver* receiver
+                ) {
+                    UnregisterKeyedReceiver(
+                        EventTypeRegistry::Of<
+                            TEvent
+                        >(),
+                        key,
+                        receiver
+                    );
+                }
+
+
+                /*
+                 * Routes every Event whose dynamic type is, or derives
+                 * from, baseType to receiver. matcher performs the
+                 * hierarchy test; it runs once per concrete Event type
+                 * on first dispatch and the outcome is cached in the
+                 * routing table until the polymorphic subscriptions change.
+                 * A receiver matched by several subscriptions, or also
+                 * registered for the exact type, receives each Event once.
+                 */
+                void RegisterPolymorphicReceiver(
+                    EventTypeID baseType,
+                    EventTypeMatcher matcher,
+                    IEventReceiver* receiver
+                ) {
+                    if (
+                        receiver == nullptr ||
+                        matcher == nullptr ||
+                        baseType == 0
+                    ) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    for (
+                        const PolymorphicEventReceiver&
+                            subscription :
+                        _polymorphicEventReceivers
+                    ) {
+                        if (
+                            subscription.baseType == baseType &&
+                            subscription.receiver == receiver
+                        ) {
+                            return;
+                        }
+                    }
+
+                    _polymorphicEventReceivers.push_back(
+                        PolymorphicEventReceiver{
+                            baseType,
+                            matcher,
+                            receiver
+                        }
+                    );
+
+                    PublishUnresolvedEventReceiversLocked();
+                }
+
+
+                template<typename TBaseEvent>
+                void RegisterPolymorphicReceiver(
+                    IEventReceiver* receiver
+                ) {
+                    RegisterPolymorphicReceiver(
+                        EventTypeRegistry::Of<
+                            TBaseEvent
+                        >(),
+                        &IsEventOfType<
+                            TBaseEvent
+                        >,
+                        receiver
+                    );
+                }
+
+
+                void UnregisterPolymorphicReceiver(
+                    EventTypeID baseType,
+                    IEventReceiver* receiver
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventReceiversMutex
+                    );
+
+                    const size_t previousSize =
+                        _polymorphicEventReceivers.size();
+
+                    _polymorphicEventReceivers.erase(
+                        std::remove_if(
+                            _polymorphicEventReceivers.begin(),
+                            _polymorphicEventReceivers.end(),
+                            [&](
+                                const PolymorphicEventReceiver&
+                                    subscription
+                            ) {
+                                return
+                                    subscription.baseType ==
+                                        baseType &&
+                                    subscription.receiver ==
+                                        receiver;
+                            }
+                        ),
+                        _polymorphicEventReceivers.end()
+                    );
+
+                    if (
+                        _polymorphicEventReceivers.size() ==
+                        previousSize
+                    ) {
+                        return;
+                    }
+
+                    PublishUnresolvedEventReceiversLocked();
+                }
+
+
+                template<typename TBaseEvent>
+                void UnregisterPolymorphicReceiver(
+                    IEventReceiver* receiver
+                ) {
+                    UnregisterPolymorphicReceiver(
+                        EventTypeRegistry::Of<
+                            TBaseEvent
+                        >(),
+                        receiver
+                    );
                 }
         };
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ESPressio_EventJournalTypes.hpp"
+
+namespace ESPressio::Event {
+
+/*
+ * In-memory index of a journal, by timestamp and by transport type ID.
+ *
+ * Entries are kept in journal order, which is timestamp order because
+ * writers never record a timestamp earlier than the previous one. Time
+ * lookups are binary searches; each type keeps the positions of its
+ * entries, also in timestamp order.
+ */
+class EventJournalIndex {
+private:
+    std::vector<EventJournalEntry> _entries;
+    std::unordered_map<uint64_t, std::vector<size_t>> _entriesByType;
+
+public:
+    void Add(const EventJournalEntry& entry) {
+        _entriesByType[entry.EventTypeID].push_back(_entries.size());
+        _entries.push_back(entry);
+    }
+
+    void Clear() {
+        _entries.clear();
+        _entriesByType.clear();
+    }
+
+    size_t GetCount() const noexcept { return _entries.size(); }
+
+    const EventJournalEntry& operator[](size_t position) const noexcept {
+        return _entries[position];
+    }
+
+    const std::vector<EventJournalEntry>& GetEntries() const noexcept {
+        return _entries;
+    }
+
+    // Timestamp of the last entry, or zero for an empty index
+    uint64_t GetLastTimestampNanoseconds() const noexcept {
+        return _entries.empty() ? 0 : _entries.back().TimestampNanoseconds;
+    }
+
+    // Position of the first entry at or after timestampNanoseconds
+    size_t LowerBound(uint64_t timestampNanoseconds) const noexcept {
+        return static_cast<size_t>(std::lower_bound(
+            _entries.begin(),
+            _entries.end(),
+            timestampNanoseconds,
+            [](const EventJournalEntry& entry, uint64_t timestamp) {
+                return entry.TimestampNanoseconds < timestamp;
+            }
+        ) - _entries.begin());
+    }
+
+    /*
+     * Positions of every entry of one transport type, in timestamp order,
+     * or nullptr when the journal holds none.
+     */
+    const std::vector<size_t>* GetEntriesOfType(uint64_t eventTypeID) const {
+        const auto found = _entriesByType.find(eventTypeID);
+        return found == _entriesByType.end() ? nullptr : &found->second;
+    }
+
+    /*
+     * Position within GetEntriesOfType(eventTypeID) of the first entry of
+     * that type at or after timestampNanoseconds.
+     */
+    size_t LowerBoundOfType(
+        uint64_t eventTypeID,
+        uint64_t timestampNanoseconds
+    ) const {
+        const std::vector<size_t>* positions = GetEntriesOfType(eventTypeID);
+        if (positions == nullptr) {
+            return 0;
+        }
+        return static_cast<size_t>(std::lower_bound(
+            positions->begin(),
+            positions->end(),
+            timestampNanoseconds,
+            [this](size_t position, uint64_t timestamp) {
+                return _entries[position].TimestampNanoseconds < timestamp;
+            }
+        ) - positions->begin());
+    }
+};
+
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define ESPRESSIO_EVENT_JOURNAL_MMAP 1
+#endif
+
+#include "ESPressio_EventJournalIndex.hpp"
+#include "ESPressio_EventJournalTypes.hpp"
+
+namespace ESPressio::Event {
+
+/*
+ * Read-only view of a journal with its index rebuilt on open.
+ *
+ * POSIX hosts memory-map the file; other targets read it into RAM. A
+ * record cut short by a crash mid-write ends the journal: everything
+ * before it is indexed and HasTruncatedTail() reports the loss.
+ */
+class EventJournalReader {
+private:
+    const uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+    std::vector<uint8_t> _buffer;
+    EventJournalIndex _index;
+    bool _truncatedTail = false;
+#ifdef ESPRESSIO_EVENT_JOURNAL_MMAP
+    void* _mapping = nullptr;
+#endif
+
+    bool Load(const char* path) {
+#ifdef ESPRESSIO_EVENT_JOURNAL_MMAP
+        const int file = ::open(path, O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+        struct stat status;
+        if (::fstat(file, &status) != 0) {
+            ::close(file);
+            return false;
+        }
+        _size = static_cast<std::size_t>(status.st_size);
+        if (_size == 0) {
+            ::close(file);
+            return false;
+        }
+        void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (mapping == MAP_FAILED) {
+            _size = 0;
+            return false;
+        }
+        _mapping = mapping;
+        _data = static_cast<const uint8_t*>(mapping);
+        return true;
+#else
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        uint8_t chunk[512];
+        std::size_t read;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            _buffer.insert(_buffer.end(), chunk, chunk + read);
+        }
+        std::fclose(file);
+        _data = _buffer.data();
+        _size = _buffer.size();
+        return true;
+#endif
+    }
+
+    bool BuildIndex() {
+        EventJournalFileHeader header;
+        if (_size < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, _data, sizeof(header));
+        if (
+            header.Magic != EventJournalFileHeader::MagicValue ||
+            header.Version != EventJournalFileHeader::CurrentVersion
+        ) {
+            return false;
+        }
+        std::size_t offset = sizeof(header);
+        uint64_t last = 0;
+        while (offset < _size) {
+            EventJournalRecordHeader record;
+            EventJournalEntry entry;
+            if (_size - offset < sizeof(record)) {
+                _truncatedTail = true;
+                break;
+            }
+            std::memcpy(&record, _data + offset, sizeof(record));
+            offset += sizeof(record);
+            if (
+                record.Magic != EventJournalRecordHeader::MagicValue ||
+                _size - offset < record.PacketLength ||
+                !ReadEventJournalEnvelope(_data + offset, record.PacketLength, entry)
+            ) {
+                _truncatedTail = true;
+                break;
+            }
+            last = record.TimestampNanoseconds < last ? last : record.TimestampNanoseconds;
+            entry.TimestampNanoseconds = last;
+            entry.Offset = offset;
+            _index.Add(entry);
+            offset += record.PacketLength;
+        }
+        return true;
+    }
+
+public:
+    EventJournalReader() = default;
+    EventJournalReader(const EventJournalReader&) = delete;
+    EventJournalReader& operator=(const EventJournalReader&) = delete;
+
+    ~EventJournalReader() { Close(); }
+
+    bool Open(const char* path) {
+        Close();
+        if (!Load(path) || !BuildIndex()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * Indexes a journal already in memory. data must outlive the reader
+     * or the next Open()/Close().
+     */
+    bool Open(const uint8_t* data, std::size_t size) {
+        Close();
+        _data = data;
+        _size = size;
+        if (!BuildIndex()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close() {
+#ifdef ESPRESSIO_EVENT_JOURNAL_MMAP
+        if (_mapping != nullptr) {
+            ::munmap(_mapping, _size);
+            _mapping = nullptr;
+        }
+#endif
+        std::vector<uint8_t>().swap(_buffer);
+        _data = nullptr;
+        _size = 0;
+        _index.Clear();
+        _truncatedTail = false;
+    }
+
+    bool IsOpen() const noexcept { return _data != nullptr; }
+
+    bool HasTruncatedTail() const noexcept { return _truncatedTail; }
+
+    const EventJournalIndex& GetIndex() const noexcept { return _index; }
+
+    size_t GetRecordCount() const noexcept { return _index.GetCount(); }
+
+    // The journaled EVTT packet of entry, valid until the reader is closed
+    EventTransportPacket GetPacket(const EventJournalEntry& entry) const noexcept {
+        EventTransportPacket packet;
+        packet.Data = _data + entry.Offset;
+        packet.Size = entry.Size;
+        packet.MessageID = entry.MessageID;
+        return packet;
+    }
+};
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "ESPressio_EventJournalReader.hpp"
+#include "ESPressio_IEventTransport.hpp"
+
+namespace ESPressio::Event {
+
+/*
+ * Speed is a multiple of the recorded pace: 1 replays at the original
+ * speed, 10 ten times faster. Zero or less replays as fast as possible.
+ * EventTypeID, when non-zero, replays only that transport type.
+ */
+struct EventJournalReplayOptions {
+    static constexpr double AsFastAsPossible = 0.0;
+
+    double Speed = 1.0;
+    uint64_t FromNanoseconds = 0;
+    uint64_t ToNanoseconds = std::numeric_limits<uint64_t>::max();
+    uint64_t EventTypeID = 0;
+};
+
+/*
+ * MaximumLagNanoseconds is how far the replay fell behind its schedule at
+ * worst, for judging whether consumers kept up with the requested speed.
+ */
+struct EventJournalReplayResult {
+    size_t ReplayedCount = 0;
+    uint64_t ElapsedNanoseconds = 0;
+    uint64_t MaximumLagNanoseconds = 0;
+    bool Stopped = false;
+};
+
+/*
+ * Re-emits journaled packets with their recorded spacing, scaled by the
+ * requested speed, on the calling thread. Pacing is anchored to the start
+ * of the replay, so a slow sink does not stretch the remaining schedule;
+ * it is reported as lag instead. Stop() may be called from another
+ * thread.
+ */
+class EventJournalReplay {
+private:
+    std::atomic<bool> _stopping{false};
+
+public:
+    void Stop() noexcept { _stopping.store(true, std::memory_order_relaxed); }
+
+    /*
+     * Calls sink(const EventTransportPacket&, const EventJournalEntry&) for
+     * each selected record, in journal order.
+     */
+    template<typename TSink>
+    EventJournalReplayResult Replay(
+        const EventJournalReader& reader,
+        const EventJournalReplayOptions& options,
+        TSink&& sink
+    ) {
+        using Clock = std::chrono::steady_clock;
+
+        _stopping.store(false, std::memory_order_relaxed);
+        EventJournalReplayResult result;
+        const EventJournalIndex& index = reader.GetIndex();
+        const std::vector<size_t>* positions = nullptr;
+        size_t cursor;
+        size_t end;
+        if (options.EventTypeID != 0) {
+            positions = index.GetEntriesOfType(options.EventTypeID);
+            cursor = index.LowerBoundOfType(options.EventTypeID, options.FromNanoseconds);
+            end = positions == nullptr ? 0 : positions->size();
+        } else {
+            cursor = index.LowerBound(options.FromNanoseconds);
+            end = index.GetCount();
+        }
+
+        const Clock::time_point started = Clock::now();
+        uint64_t firstTimestamp = 0;
+        bool first = true;
+        for (; cursor < end; ++cursor) {
+            if (_stopping.load(std::memory_order_relaxed)) {
+                result.Stopped = true;
+                break;
+            }
+            const EventJournalEntry& entry = index[positions == nullptr ? cursor : (*positions)[cursor]];
+            if (entry.TimestampNanoseconds > options.ToNanoseconds) {
+                break;
+            }
+            if (first) {
+                firstTimestamp = entry.TimestampNanoseconds;
+                first = false;
+            }
+            if (options.Speed > 0.0) {
+                const Clock::time_point due = started + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::nano>(
+                        static_cast<double>(entry.TimestampNanoseconds - firstTimestamp) / options.Speed
+                    )
+                );
+                const Clock::time_point now = Clock::now();
+                if (now < due) {
+                    std::this_thread::sleep_until(due);
+                } else {
+                    const uint64_t lag = static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count()
+                    );
+                    if (lag > result.MaximumLagNanoseconds) {
+                        result.MaximumLagNanoseconds = lag;
+                    }
+                }
+            }
+            sink(reader.GetPacket(entry), entry);
+            ++result.ReplayedCount;
+        }
+        result.ElapsedNanoseconds = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count()
+        );
+        return result;
+    }
+
+    /*
+     * Hands each record to receiver as an inbound packet from transport,
+     * normally EventTransportManager and the journal transport. Only types
+     * registered as inbound for that transport are re-dispatched.
+     */
+    EventJournalReplayResult Replay(
+        const EventJournalReader& reader,
+        const EventJournalReplayOptions& options,
+        IEventTransportReceiver* receiver,
+        IEventTransport* transport
+    ) {
+        if (receiver == nullptr) {
+            return EventJournalReplayResult{};
+        }
+        return Replay(reader, options, [&](const EventTransportPacket& packet, const EventJournalEntry&) {
+            receiver->ReceiveEventTransportPacket(transport, packet.Data, packet.Size);
+        });
+    }
+};
+
+}
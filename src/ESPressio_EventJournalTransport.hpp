@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <ESPressio_SystemClock.hpp>
+#include <ESPressio_TimeTraits.hpp>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
+#include "ESPressio_IEventTransport.hpp"
+#include "ESPressio_EventJournalReader.hpp"
+#include "ESPressio_EventJournalReplay.hpp"
+#include "ESPressio_EventJournalWriter.hpp"
+
+namespace ESPressio::Event {
+
+/*
+ * Event journal as an IEventTransport.
+ *
+ * Register it with EventTransportManager and route Serializable Event types
+ * outbound to it: every matching local Event is then appended, as the EVTT
+ * packet the manager produced, with its EventClock time. Replay() feeds a
+ * journal back through the receiver the manager installed, so types
+ * registered inbound for this transport are deserialized and dispatched
+ * exactly as if they had arrived from a peer.
+ */
+class EventJournalTransport final : public IEventTransport {
+private:
+    mutable std::mutex _mutex;
+    EventJournalWriter _writer;
+    std::atomic<IEventTransportReceiver*> _receiver{nullptr};
+    Timing::ISystemClock<EventTime>* _clock;
+    EventJournalReplay _replay;
+
+    uint64_t GetNowNanoseconds() const {
+        if (_clock == nullptr) {
+            return EventClock::GetNowNanoseconds();
+        }
+        return Timing::TimeTraits<EventTime>::template
+            ToNanoseconds<uint64_t>(_clock->GetTime());
+    }
+
+public:
+    // nullptr timestamps records with the EventClock
+    explicit EventJournalTransport(Timing::ISystemClock<EventTime>* clock = nullptr) :
+        _clock(clock) {
+    }
+
+    bool Open(const char* path) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writer.Open(path);
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _writer.Close();
+    }
+
+    bool Flush() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writer.Flush();
+    }
+
+    bool Send(const EventTransportPacket& packet) override {
+        const uint64_t now = GetNowNanoseconds();
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writer.Append(now, packet.Data, packet.Size);
+    }
+
+    void SetReceiver(IEventTransportReceiver* receiver) override {
+        _receiver.store(receiver, std::memory_order_release);
+    }
+
+    /*
+     * Replays reader on the calling thread; see EventJournalReplay for
+     * pacing. Call StopReplay() from another thread to end it early.
+     */
+    EventJournalReplayResult Replay(
+        const EventJournalReader& reader,
+        const EventJournalReplayOptions& options = {}
+    ) {
+        return _replay.Replay(
+            reader,
+            options,
+            _receiver.load(std::memory_order_acquire),
+            this
+        );
+    }
+
+    void StopReplay() noexcept { _replay.Stop(); }
+
+    size_t GetRecordCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writer.GetRecordCount();
+    }
+
+    uint64_t GetFailedAppendCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writer.GetFailedAppendCount();
+    }
+
+    /*
+     * The index of everything written since Open(), by timestamp and
+     * type. The reference is only safe while no Send() can run.
+     */
+    const EventJournalIndex& GetIndex() const noexcept { return _writer.GetIndex(); }
+};
+
+}
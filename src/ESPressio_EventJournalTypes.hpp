@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ESPressio_EventTransportTypes.hpp"
+
+namespace ESPressio::Event {
+
+/*
+ * On-disk layout of an Event journal:
+ *
+ *   EventJournalFileHeader
+ *   { EventJournalRecordHeader, EVTT envelope, ESPB payload } ...
+ *
+ * Each record stores the packet exactly as EventTransportManager handed it
+ * to a transport, so the journal needs no knowledge of Event types and a
+ * replayed packet goes back through the normal inbound path.
+ */
+#pragma pack(push, 1)
+struct EventJournalFileHeader {
+    static constexpr uint32_t MagicValue =
+        0x45564A4Cu; // EVJL
+
+    static constexpr uint8_t CurrentVersion = 1;
+
+    uint32_t Magic = MagicValue;
+    uint8_t Version = CurrentVersion;
+    uint8_t Reserved[3] = {0, 0, 0};
+};
+
+struct EventJournalRecordHeader {
+    static constexpr uint32_t MagicValue =
+        0x45564A52u; // EVJR
+
+    uint32_t Magic = MagicValue;
+    uint32_t PacketLength = 0;
+    uint64_t TimestampNanoseconds = 0;
+};
+#pragma pack(pop)
+
+static_assert(
+    sizeof(EventJournalFileHeader) == 8,
+    "EventJournalFileHeader layout changed; increment journal version deliberately."
+);
+
+static_assert(
+    sizeof(EventJournalRecordHeader) == 16,
+    "EventJournalRecordHeader layout changed; increment journal version deliberately."
+);
+
+/*
+ * One journaled packet. Offset is the position of the EVTT envelope in the
+ * journal file.
+ */
+struct EventJournalEntry {
+    uint64_t TimestampNanoseconds = 0;
+    uint64_t EventTypeID = 0;
+    uint64_t MessageID = 0;
+    uint64_t Offset = 0;
+    uint32_t Size = 0;
+    EventDispatchMethod DispatchMethod = EventDispatchMethod::Queue;
+    EventPriority Priority = EventPriority::Normal;
+};
+
+/*
+ * Validates an EVTT packet and fills the routing fields of entry from its
+ * envelope. Journals accept only packets the transport inbound path would.
+ */
+inline bool ReadEventJournalEnvelope(
+    const uint8_t* packet,
+    std::size_t size,
+    EventJournalEntry& entry
+) noexcept {
+    if (packet == nullptr || size < sizeof(EventTransportEnvelope)) {
+        return false;
+    }
+    EventTransportEnvelope envelope;
+    std::memcpy(&envelope, packet, sizeof(envelope));
+    if (
+        envelope.Magic != EventTransportEnvelope::MagicValue ||
+        envelope.Version != EventTransportEnvelope::CurrentVersion ||
+        envelope.PayloadLength != size - sizeof(EventTransportEnvelope)
+    ) {
+        return false;
+    }
+    entry.EventTypeID = envelope.EventTypeID;
+    entry.MessageID = envelope.MessageID;
+    entry.Size = static_cast<uint32_t>(size);
+    entry.DispatchMethod = static_cast<EventDispatchMethod>(envelope.DispatchMethod);
+    entry.Priority = static_cast<EventPriority>(envelope.Priority);
+    return true;
+}
+
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "ESPressio_EventJournalIndex.hpp"
+#include "ESPressio_EventJournalTypes.hpp"
+
+/*
+ * stdio buffer of an open journal. Records reach the file when the buffer
+ * fills or on Flush().
+ */
+#ifndef ESPRESSIO_EVENT_JOURNAL_WRITE_BUFFER_SIZE
+    #define ESPRESSIO_EVENT_JOURNAL_WRITE_BUFFER_SIZE 65536
+#endif
+
+namespace ESPressio::Event {
+
+/*
+ * Appends EVTT packets to a journal file through buffered stdio, so it
+ * works on any target with a file system, and indexes them as it goes.
+ *
+ * Timestamps are clamped to never go backwards, keeping the file in
+ * timestamp order. A failed write closes the journal; records written
+ * before it remain readable. Not thread-safe.
+ */
+class EventJournalWriter {
+private:
+    std::FILE* _file = nullptr;
+    EventJournalIndex _index;
+    uint64_t _offset = 0;
+    uint64_t _failedAppendCount = 0;
+
+    bool Write(const void* data, std::size_t size) {
+        if (std::fwrite(data, 1, size, _file) != size) {
+            Close();
+            return false;
+        }
+        _offset += size;
+        return true;
+    }
+
+public:
+    EventJournalWriter() = default;
+    EventJournalWriter(const EventJournalWriter&) = delete;
+    EventJournalWriter& operator=(const EventJournalWriter&) = delete;
+
+    ~EventJournalWriter() { Close(); }
+
+    // Creates the journal at path, replacing any existing file
+    bool Open(const char* path) {
+        Close();
+        _index.Clear();
+        _offset = 0;
+        _file = std::fopen(path, "wb");
+        if (_file == nullptr) {
+            return false;
+        }
+        std::setvbuf(_file, nullptr, _IOFBF, ESPRESSIO_EVENT_JOURNAL_WRITE_BUFFER_SIZE);
+        const EventJournalFileHeader header{};
+        return Write(&header, sizeof(header));
+    }
+
+    void Close() {
+        if (_file != nullptr) {
+            std::fclose(_file);
+            _file = nullptr;
+        }
+    }
+
+    bool IsOpen() const noexcept { return _file != nullptr; }
+
+    bool Flush() {
+        return _file != nullptr && std::fflush(_file) == 0;
+    }
+
+    /*
+     * Appends one EVTT packet recorded at timestampNanoseconds. Returns
+     * false, and counts the failure, for a closed journal, a packet that
+     * is not a valid EVTT packet, or a failed write.
+     */
+    bool Append(
+        uint64_t timestampNanoseconds,
+        const uint8_t* packet,
+        std::size_t size
+    ) {
+        EventJournalEntry entry;
+        if (
+            _file == nullptr ||
+            size > UINT32_MAX ||
+            !ReadEventJournalEnvelope(packet, size, entry)
+        ) {
+            ++_failedAppendCount;
+            return false;
+        }
+        const uint64_t last = _index.GetLastTimestampNanoseconds();
+        entry.TimestampNanoseconds = timestampNanoseconds < last ? last : timestampNanoseconds;
+
+        EventJournalRecordHeader header;
+        header.PacketLength = static_cast<uint32_t>(size);
+        header.TimestampNanoseconds = entry.TimestampNanoseconds;
+        if (!Write(&header, sizeof(header))) {
+            ++_failedAppendCount;
+            return false;
+        }
+        entry.Offset = _offset;
+        if (!Write(packet, size)) {
+            ++_failedAppendCount;
+            return false;
+        }
+        _index.Add(entry);
+        return true;
+    }
+
+    const EventJournalIndex& GetIndex() const noexcept { return _index; }
+
+    size_t GetRecordCount() const noexcept { return _index.GetCount(); }
+
+    // Bytes written so far, including the file header
+    uint64_t GetSize() const noexcept { return _offset; }
+
+    uint64_t GetFailedAppendCount() const noexcept { return _failedAppendCount; }
+};
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Enables per-receiver queueing latency histograms. When zero (the
+ * default) pending Events carry no enqueue timestamp and no clock is read
+ * on their behalf; the snapshot APIs then report empty histograms.
+ */
+#ifndef ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+    #define ESPRESSIO_EVENT_LATENCY_HISTOGRAMS 0
+#endif
+
+namespace ESPressio {
+
+    namespace Event {
+
+        struct EventLatencySnapshot {
+            uint64_t SampleCount = 0;
+            uint64_t P50Nanoseconds = 0;
+            uint64_t P99Nanoseconds = 0;
+            uint64_t MaximumNanoseconds = 0;
+        };
+
+        /*
+         * Log2-bucketed latency histogram. Bucket 0 holds zero latencies and
+         * bucket b holds [2^(b-1), 2^b) nanoseconds; the last bucket also
+         * absorbs everything longer. Percentiles therefore report the upper
+         * bound of the matching bucket (never more than the recorded
+         * maximum), which is within a factor of two of the exact value.
+         */
+        template<typename TCount = uint64_t>
+        class EventLatencyHistogram {
+            public:
+                static constexpr size_t BucketCount = 40;
+
+            private:
+                std::array<TCount, BucketCount> _buckets{};
+                uint64_t _sampleCount = 0;
+                uint64_t _maximumNanoseconds = 0;
+
+                static size_t BucketIndex(uint64_t nanoseconds) noexcept {
+                    if (nanoseconds == 0) {
+                        return 0;
+                    }
+#if defined(__GNUC__)
+                    const size_t index = static_cast<size_t>(
+                        64 - __builtin_clzll(nanoseconds)
+                    );
+#else
+                    size_t index = 0;
+                    for (; nanoseconds != 0; nanoseconds >>= 1) {
+                        ++index;
+                    }
+#endif
+                    return std::min(index, BucketCount - 1);
+                }
+
+                static uint64_t BucketUpperBound(size_t index) noexcept {
+                    return index == 0
+                        ? 0
+                        : (uint64_t(1) << index) - 1;
+                }
+
+                template<typename TOther>
+                friend class EventLatencyHistogram;
+
+            public:
+                void Record(uint64_t nanoseconds) noexcept {
+                    ++_buckets[BucketIndex(nanoseconds)];
+                    ++_sampleCount;
+                    _maximumNanoseconds =
+                        std::max(_maximumNanoseconds, nanoseconds);
+                }
+
+                template<typename TOther>
+                void Merge(const EventLatencyHistogram<TOther>& other) noexcept {
+                    for (size_t index = 0; index < BucketCount; ++index) {
+                        _buckets[index] += other._buckets[index];
+                    }
+                    _sampleCount += other._sampleCount;
+                    _maximumNanoseconds = std::max(
+                        _maximumNanoseconds, other._maximumNanoseconds
+                    );
+                }
+
+                void Reset() noexcept {
+                    _buckets.fill(0);
+                    _sampleCount = 0;
+                    _maximumNanoseconds = 0;
+                }
+
+                uint64_t GetSampleCount() const noexcept {
+                    return _sampleCount;
+                }
+
+                uint64_t GetMaximumNanoseconds() const noexcept {
+                    return _maximumNanoseconds;
+                }
+
+                uint64_t GetPercentileNanoseconds(
+                    unsigned percentile
+                ) const noexcept {
+                    if (_sampleCount == 0) {
+                        return 0;
+                    }
+                    const uint64_t rank = std::max<uint64_t>(
+                        1,
+                        (_sampleCount * std::min(percentile, 100u) + 99) / 100
+                    );
+                    uint64_t cumulative = 0;
+                    for (size_t index = 0; index < BucketCount; ++index) {
+                        cumulative += _buckets[index];
+                        if (cumulative >= rank) {
+                            return index == BucketCount - 1
+                                ? _maximumNanoseconds
+                                : std::min(
+                                    BucketUpperBound(index),
+                                    _maximumNanoseconds
+                                );
+                        }
+                    }
+                    return _maximumNanoseconds;
+                }
+
+                EventLatencySnapshot GetSnapshot() const noexcept {
+                    EventLatencySnapshot snapshot;
+                    snapshot.SampleCount = _sampleCount;
+                    snapshot.P50Nanoseconds = GetPercentileNanoseconds(50);
+                    snapshot.P99Nanoseconds = GetPercentileNanoseconds(99);
+                    snapshot.MaximumNanoseconds = _maximumNanoseconds;
+                    return snapshot;
+                }
+        };
+
+    }
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -16,6 +17,7 @@
 #include "ESPressio_IEvent.hpp"
 #include "ESPressio_EventEnums.hpp"
 #include "ESPressio_EventObserver.hpp"
+#include "ESPressio_EventTypeID.hpp"
 
 namespace ESPressio {
 
@@ -229,6 +231,22 @@ namespace ESPressio {
                         handler
                     );
                 }
+
+
+                virtual void
+                UnregisterKeyedListener(
+                    std::type_index eventType,
+                    uint64_t key,
+                    IEventListenerHandle*
+                        handler
+                ) {
+                    (void)key;
+
+                    UnregisterListener(
+                        eventType,
+                        handler
+                    );
+                }
         };
 
 
@@ -249,6 +267,14 @@ namespace ESPressio {
                 IEventListener*
                     _listener;
 
+                bool
+                    _keyed =
+                        false;
+
+                uint64_t
+                    _key =
+                        0;
+
 
             public:
                 EventListenerHandle(
@@ -260,6 +286,18 @@ namespace ESPressio {
                 }
 
 
+                EventListenerHandle(
+                    std::type_index eventType,
+                    uint64_t key,
+                    IEventListener* listener
+                ) :
+                    _eventType(eventType),
+                    _listener(listener),
+                    _keyed(true),
+                    _key(key) {
+                }
+
+
                 ~EventListenerHandle()
                     noexcept override {
                     try {
@@ -278,11 +316,20 @@ namespace ESPressio {
                         return;
                     }
 
-                    _listener->
-                        UnregisterListener(
-                            _eventType,
-                            this
-                        );
+                    if (_keyed) {
+                        _listener->
+                            UnregisterKeyedListener(
+                                _eventType,
+                                _key,
+                                this
+                            );
+                    } else {
+                        _listener->
+                            UnregisterListener(
+                                _eventType,
+                                this
+                            );
+                    }
 
                     _isRegistered.Set(
                         false
@@ -507,16 +554,64 @@ namespace ESPressio {
                         const EventListeners
                     >;
 
-                using EventListenersMap =
-                    std::unordered_map<
-                        std::type_index,
+                /*
+                 * Indexed by EventTypeID; entry 0 is never used.
+                 */
+                using EventListenersTable =
+                    std::vector<
                         EventListenersSnapshot
                     >;
 
 
-                EventListenersMap
+                EventListenersTable
                     _eventListeners;
 
+                size_t
+                    _eventListenerTypeCount =
+                        0;
+
+
+                struct PolymorphicEventListener {
+                    EventTypeID baseType = 0;
+                    EventTypeMatcher matcher = nullptr;
+                    std::shared_ptr<
+                        IEventListenerContainer
+                    > listener;
+                };
+
+                std::vector<
+                    PolymorphicEventListener
+                > _polymorphicListeners;
+
+                /*
+                 * Exact and matching polymorphic listeners per concrete
+                 * Event type, indexed by EventTypeID. Filled on first
+                 * dispatch of each type while polymorphic listeners exist
+                 * and cleared whenever any registration changes.
+                 */
+                EventListenersTable
+                    _resolvedListeners;
+
+                /*
+                 * Keyed listeners per routing key, indexed by EventTypeID.
+                 * Each key's listeners are a snapshot, as for
+                 * _eventListeners; the maps change only under the write
+                 * lock.
+                 */
+                using KeyedEventListeners =
+                    std::unordered_map<
+                        uint64_t,
+                        EventListenersSnapshot
+                    >;
+
+                std::vector<
+                    KeyedEventListeners
+                > _keyedListeners;
+
+                size_t
+                    _keyedListenerTypeCount =
+                        0;
+
                 mutable
                     std::shared_mutex
                         _eventListenersMutex;
@@ -526,28 +621,132 @@ namespace ESPressio {
                     EventListeners
                 >
                 CopyListenersForEventType(
-                    std::type_index eventType
+                    EventTypeID eventType
                 ) const {
-                    const auto found =
-                        _eventListeners.find(
-                            eventType
-                        );
-
                     return
-                        found ==
-                            _eventListeners.end() ||
-                        !found->second
+                        eventType >=
+                            _eventListeners.size() ||
+                        !_eventListeners[eventType]
                             ? std::make_shared<
                                 EventListeners
                               >()
                             : std::make_shared<
                                 EventListeners
                               >(
-                                *found->second
+                                *_eventListeners[eventType]
                               );
                 }
 
 
+                void StoreListenersLocked(
+                    EventTypeID eventType,
+                    std::shared_ptr<
+                        EventListeners
+                    > listeners
+                ) {
+                    if (
+                        eventType >=
+                        _eventListeners.size()
+                    ) {
+                        _eventListeners.resize(
+                            eventType + 1
+                        );
+                    }
+
+                    if (!_eventListeners[eventType]) {
+                        ++_eventListenerTypeCount;
+                    }
+
+                    _resolvedListeners.clear();
+
+                    _eventListeners[
+                        eventType
+                    ] = std::move(
+                        listeners
+                    );
+                }
+
+
+                void RemoveListenersLocked(
+                    EventTypeID eventType
+                ) {
+                    _eventListeners[
+                        eventType
+                    ].reset();
+
+                    --_eventListenerTypeCount;
+
+                    _resolvedListeners.clear();
+                }
+
+
+                /*
+                 * Builds and caches the listeners for event's concrete
+                 * type, evaluating each polymorphic listener's matcher
+                 * once for that type.
+                 */
+                EventListenersSnapshot
+                ResolveListeners(
+                    IEvent* event,
+                    EventTypeID eventType
+                ) {
+                    std::unique_lock<
+                        std::shared_mutex
+                    > lock(
+                        _eventListenersMutex
+                    );
+
+                    if (
+                        eventType <
+                            _resolvedListeners.size() &&
+                        _resolvedListeners[eventType]
+                    ) {
+                        return
+                            _resolvedListeners[
+                                eventType
+                            ];
+                    }
+
+                    std::shared_ptr<
+                        EventListeners
+                    > listeners =
+                        CopyListenersForEventType(
+                            eventType
+                        );
+
+                    for (
+                        const PolymorphicEventListener&
+                            polymorphicListener :
+                        _polymorphicListeners
+                    ) {
+                        if (
+                            polymorphicListener.matcher(
+                                event
+                            )
+                        ) {
+                            listeners->push_back(
+                                polymorphicListener.listener
+                            );
+                        }
+                    }
+
+                    if (
+                        eventType >=
+                        _resolvedListeners.size()
+                    ) {
+                        _resolvedListeners.resize(
+                            eventType + 1
+                        );
+                    }
+
+                    _resolvedListeners[
+                        eventType
+                    ] = listeners;
+
+                    return listeners;
+                }
+
+
             protected:
                 virtual void
                 OnListenerRegistered(
@@ -563,14 +762,117 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Called when the first polymorphic listener for baseType
+                 * is registered, and when the last one is removed, so an
+                 * Event thread can subscribe to the whole family at its
+                 * dispatcher.
+                 */
+                virtual void
+                OnPolymorphicListenerRegistered(
+                    EventTypeID,
+                    EventTypeMatcher
+                ) {
+                }
+
+
+                virtual void
+                OnPolymorphicListenerUnregistered(
+                    EventTypeID
+                ) {
+                }
+
+
+                /*
+                 * Called when the first listener for an Event type and
+                 * routing key is registered, and when the last one is
+                 * removed, so an Event thread can subscribe to that key
+                 * alone at its dispatcher.
+                 */
+                virtual void
+                OnKeyedListenerRegistered(
+                    EventTypeID,
+                    uint64_t
+                ) {
+                }
+
+
+                virtual void
+                OnKeyedListenerUnregistered(
+                    EventTypeID,
+                    uint64_t
+                ) {
+                }
+
+
                 void
                 UnregisterAllListeners()
                     noexcept {
                     for (;;) {
-                        std::type_index
-                            eventType(
-                                typeid(void)
+                        EventTypeID
+                            eventType =
+                                0;
+
+                        {
+                            std::unique_lock<
+                                std::shared_mutex
+                            > lock(
+                                _eventListenersMutex
+                            );
+
+                            if (
+                                _eventListenerTypeCount ==
+                                0
+                            ) {
+                                break;
+                            }
+
+                            while (
+                                !_eventListeners[
+                                    eventType
+                                ]
+                            ) {
+                                ++eventType;
+                            }
+
+                            for (
+                                const auto&
+                                    listener :
+                                *_eventListeners[
+                                    eventType
+                                ]
+                            ) {
+                                static_cast<
+                                    EventListenerHandle*
+                                >(
+                                    listener->
+                                        GetListenerHandler()
+                                )->ForceUnregister();
+                            }
+
+                            RemoveListenersLocked(
+                                eventType
+                            );
+                        }
+
+                        try {
+                            OnListenerUnregistered(
+                                EventTypeRegistry::TypeOf(
+                                    eventType
+                                )
                             );
+                        } catch (...) {
+                        }
+                    }
+
+                    for (;;) {
+                        EventTypeID
+                            keyedType =
+                                0;
+
+                        uint64_t
+                            key =
+                                0;
 
                         {
                             std::unique_lock<
@@ -580,21 +882,32 @@ namespace ESPressio {
                             );
 
                             if (
-                                _eventListeners.empty()
+                                _keyedListenerTypeCount ==
+                                0
                             ) {
-                                return;
+                                break;
+                            }
+
+                            while (
+                                _keyedListeners[
+                                    keyedType
+                                ].empty()
+                            ) {
+                                ++keyedType;
                             }
 
-                            const auto entry =
-                                _eventListeners.begin();
+                            const auto keyed =
+                                _keyedListeners[
+                                    keyedType
+                                ].begin();
 
-                            eventType =
-                                entry->first;
+                            key =
+                                keyed->first;
 
                             for (
                                 const auto&
                                     listener :
-                                *entry->second
+                                *keyed->second
                             ) {
                                 static_cast<
                                     EventListenerHandle*
@@ -604,14 +917,51 @@ namespace ESPressio {
                                 )->ForceUnregister();
                             }
 
-                            _eventListeners.erase(
-                                entry
+                            RemoveKeyedListenersLocked(
+                                keyedType,
+                                keyed
                             );
                         }
 
                         try {
-                            OnListenerUnregistered(
-                                eventType
+                            OnKeyedListenerUnregistered(
+                                keyedType,
+                                key
+                            );
+                        } catch (...) {
+                        }
+                    }
+
+                    for (;;) {
+                        EventTypeID
+                            baseType =
+                                0;
+
+                        {
+                            std::unique_lock<
+                                std::shared_mutex
+                            > lock(
+                                _eventListenersMutex
+                            );
+
+                            if (
+                                _polymorphicListeners.empty()
+                            ) {
+                                return;
+                            }
+
+                            baseType =
+                                _polymorphicListeners.front().baseType;
+
+                            RemovePolymorphicListenersLocked(
+                                baseType,
+                                nullptr
+                            );
+                        }
+
+                        try {
+                            OnPolymorphicListenerUnregistered(
+                                baseType
                             );
                         } catch (...) {
                         }
@@ -619,6 +969,101 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Removes the polymorphic listeners for baseType owned by
+                 * handler, or all of them when handler is null. Returns
+                 * whether any were removed. Caller holds the write lock.
+                 */
+                bool RemovePolymorphicListenersLocked(
+                    EventTypeID baseType,
+                    IEventListenerHandle* handler
+                ) noexcept {
+                    const size_t previousSize =
+                        _polymorphicListeners.size();
+
+                    _polymorphicListeners.erase(
+                        std::remove_if(
+                            _polymorphicListeners.begin(),
+                            _polymorphicListeners.end(),
+                            [&](
+                                const PolymorphicEventListener&
+                                    polymorphicListener
+                            ) {
+                                IEventListenerHandle*
+                                    listenerHandler =
+                                        polymorphicListener.listener->
+                                            GetListenerHandler();
+
+                                if (
+                                    polymorphicListener.baseType !=
+                                        baseType ||
+                                    (
+                                        handler != nullptr &&
+                                        listenerHandler != handler
+                                    )
+                                ) {
+                                    return false;
+                                }
+
+                                static_cast<
+                                    EventListenerHandle*
+                                >(
+                                    listenerHandler
+                                )->ForceUnregister();
+
+                                return true;
+                            }
+                        ),
+                        _polymorphicListeners.end()
+                    );
+
+                    if (
+                        _polymorphicListeners.size() ==
+                        previousSize
+                    ) {
+                        return false;
+                    }
+
+                    _resolvedListeners.clear();
+                    return true;
+                }
+
+
+                void RemoveKeyedListenersLocked(
+                    EventTypeID eventType,
+                    KeyedEventListeners::iterator keyed
+                ) noexcept {
+                    _keyedListeners[
+                        eventType
+                    ].erase(
+                        keyed
+                    );
+
+                    if (_keyedListeners[eventType].empty()) {
+                        --_keyedListenerTypeCount;
+                    }
+                }
+
+
+                bool HasPolymorphicListenersLocked(
+                    EventTypeID baseType
+                ) const {
+                    return
+                        std::any_of(
+                            _polymorphicListeners.begin(),
+                            _polymorphicListeners.end(),
+                            [&](
+                                const PolymorphicEventListener&
+                                    polymorphicListener
+                            ) {
+                                return
+                                    polymorphicListener.baseType ==
+                                    baseType;
+                            }
+                        );
+                }
+
+
             public:
                 ~EventListener() override {
                     UnregisterAllListeners();
@@ -648,6 +1093,12 @@ namespace ESPressio {
                         customInterestCallback =
                             nullptr
                 ) override {
+                    const EventTypeID
+                        eventTypeID =
+                            EventTypeRegistry::Resolve(
+                                eventType
+                            );
+
                     std::unique_ptr<
                         EventListenerHandle
                     > handler(
@@ -672,7 +1123,7 @@ namespace ESPressio {
                             EventListeners
                         > listeners =
                             CopyListenersForEventType(
-                                eventType
+                                eventTypeID
                             );
 
                         firstListener =
@@ -696,9 +1147,10 @@ namespace ESPressio {
                             )
                         );
 
-                        _eventListeners[
-                            eventType
-                        ] = listeners;
+                        StoreListenersLocked(
+                            eventTypeID,
+                            listeners
+                        );
                     }
 
                     if (firstListener) {
@@ -742,6 +1194,12 @@ namespace ESPressio {
                             typeid(EventType)
                         );
 
+                    const EventTypeID
+                        eventTypeID =
+                            EventTypeRegistry::Of<
+                                EventType
+                            >();
+
                     std::unique_ptr<
                         EventListenerHandle
                     > handler(
@@ -797,7 +1255,7 @@ namespace ESPressio {
                             EventListeners
                         > listeners =
                             CopyListenersForEventType(
-                                eventType
+                                eventTypeID
                             );
 
                         firstListener =
@@ -821,9 +1279,10 @@ namespace ESPressio {
                             )
                         );
 
-                        _eventListeners[
-                            eventType
-                        ] = listeners;
+                        StoreListenersLocked(
+                            eventTypeID,
+                            listeners
+                        );
                     }
 
                     if (firstListener) {
@@ -839,31 +1298,352 @@ namespace ESPressio {
                 }
 
 
-                void UnregisterListener(
-                    std::type_index eventType,
-                    IEventListenerHandle*
-                        handler
-                ) override {
-                    bool
-                        removedLast =
-                            false;
-
-                    {
-                        std::unique_lock<
-                            std::shared_mutex
-                        > lock(
-                            _eventListenersMutex
-                        );
-
-                        const auto found =
-                            _eventListeners.find(
-                                eventType
+                /*
+                 * Registers callback for every Event whose dynamic type is
+                 * TBaseEvent or derives from it. Which concrete types match
+                 * is decided once per type, on its first dispatch, and
+                 * cached until the registrations change.
+                 */
+                template<typename TBaseEvent>
+                EventListenerHandlePtr
+                RegisterPolymorphicListener(
+                    std::function<
+                        void(
+                            TBaseEvent*,
+                            EventDispatchMethod,
+                            EventPriority
+                        )
+                    > callback,
+                    EventListenerInterest
+                        interest =
+                            EventListenerInterest::
+                                All,
+                    EventTime
+                        maximumTimeSinceDispatch =
+                            EventTime(0),
+                    std::function<
+                        bool(TBaseEvent*)
+                    >
+                        customInterestCallback =
+                            nullptr
+                ) {
+                    const EventTypeID
+                        baseType =
+                            EventTypeRegistry::Of<
+                                TBaseEvent
+                            >();
+
+                    std::unique_ptr<
+                        EventListenerHandle
+                    > handler(
+                        new EventListenerHandle(
+                            std::type_index(
+                                typeid(TBaseEvent)
+                            ),
+                            this
+                        )
+                    );
+
+                    std::function<
+                        bool(IEvent*)
+                    >
+                        erasedInterest =
+                            nullptr;
+
+                    if (
+                        customInterestCallback !=
+                        nullptr
+                    ) {
+                        erasedInterest =
+                            [
+                                customInterestCallback
+                            ](
+                                IEvent* event
+                            ) {
+                                TBaseEvent*
+                                    typedEvent =
+                                        dynamic_cast<
+                                            TBaseEvent*
+                                        >(event);
+
+                                return
+                                    typedEvent !=
+                                        nullptr &&
+                                    customInterestCallback(
+                                        typedEvent
+                                    );
+                            };
+                    }
+
+                    bool
+                        firstListener =
+                            false;
+
+                    {
+                        std::unique_lock<
+                            std::shared_mutex
+                        > lock(
+                            _eventListenersMutex
+                        );
+
+                        firstListener =
+                            !HasPolymorphicListenersLocked(
+                                baseType
+                            );
+
+                        _polymorphicListeners.push_back(
+                            PolymorphicEventListener{
+                                baseType,
+                                &IsEventOfType<
+                                    TBaseEvent
+                                >,
+                                std::make_shared<
+                                    EventListenerContainer<
+                                        TBaseEvent
+                                    >
+                                >(
+                                    std::move(
+                                        callback
+                                    ),
+                                    handler.get(),
+                                    interest,
+                                    maximumTimeSinceDispatch,
+                                    std::move(
+                                        erasedInterest
+                                    )
+                                )
+                            }
+                        );
+
+                        _resolvedListeners.clear();
+                    }
+
+                    if (firstListener) {
+                        OnPolymorphicListenerRegistered(
+                            baseType,
+                            &IsEventOfType<
+                                TBaseEvent
+                            >
+                        );
+                    }
+
+                    return
+                        EventListenerHandlePtr(
+                            handler.release()
+                        );
+                }
+
+
+                /*
+                 * Registers callback for Events of EventType whose
+                 * IEvent::GetRoutingKey() yields key. Matching listeners
+                 * are found through a hash index on the key, so dispatch
+                 * cost follows the listeners of that key rather than
+                 * every keyed listener of the type. interest still
+                 * filters within the key.
+                 */
+                template<typename EventType>
+                EventListenerHandlePtr
+                RegisterKeyedListener(
+                    uint64_t key,
+                    std::function<
+                        void(
+                            EventType*,
+                            EventDispatchMethod,
+                            EventPriority
+                        )
+                    > callback,
+                    EventListenerInterest
+                        interest =
+                            EventListenerInterest::
+                                All,
+                    EventTime
+                        maximumTimeSinceDispatch =
+                            EventTime(0),
+                    std::function<
+                        bool(EventType*)
+                    >
+                        customInterestCallback =
+                            nullptr
+                ) {
+                    const EventTypeID
+                        eventTypeID =
+                            EventTypeRegistry::Of<
+                                EventType
+                            >();
+
+                    std::unique_ptr<
+                        EventListenerHandle
+                    > handler(
+                        new EventListenerHandle(
+                            std::type_index(
+                                typeid(EventType)
+                            ),
+                            key,
+                            this
+                        )
+                    );
+
+                    std::function<
+                        bool(IEvent*)
+                    >
+                        erasedInterest =
+                            nullptr;
+
+                    if (
+                        customInterestCallback !=
+                        nullptr
+                    ) {
+                        erasedInterest =
+                            [
+                                customInterestCallback
+                            ](
+                                IEvent* event
+                            ) {
+                                EventType*
+                                    typedEvent =
+                                        dynamic_cast<
+                                            EventType*
+                                        >(event);
+
+                                return
+                                    typedEvent !=
+                                        nullptr &&
+                                    customInterestCallback(
+                                        typedEvent
+                                    );
+                            };
+                    }
+
+                    bool
+                        firstListener =
+                            false;
+
+                    {
+                        std::unique_lock<
+                            std::shared_mutex
+                        > lock(
+                            _eventListenersMutex
+                        );
+
+                        if (
+                            eventTypeID >=
+                            _keyedListeners.size()
+                        ) {
+                            _keyedListeners.resize(
+                                eventTypeID + 1
+                            );
+                        }
+
+                        KeyedEventListeners& keyedListeners =
+                            _keyedListeners[
+                                eventTypeID
+                            ];
+
+                        const auto keyed =
+                            keyedListeners.find(
+                                key
+                            );
+
+                        firstListener =
+                            keyed == keyedListeners.end();
+
+                        std::shared_ptr<
+                            EventListeners
+                        > listeners =
+                            firstListener
+                                ? std::make_shared<
+                                    EventListeners
+                                  >()
+                                : std::make_shared<
+                                    EventListeners
+                                  >(
+                                    *keyed->second
+                                  );
+
+                        listeners->push_back(
+                            std::make_shared<
+                                EventListenerContainer<
+                                    EventType
+                                >
+                            >(
+                                std::move(
+                                    callback
+                                ),
+                                handler.get(),
+                                interest,
+                                maximumTimeSinceDispatch,
+                                std::move(
+                                    erasedInterest
+                                )
+                            )
+                        );
+
+                        if (keyedListeners.empty()) {
+                            ++_keyedListenerTypeCount;
+                        }
+
+                        keyedListeners[
+                            key
+                        ] = std::move(
+                            listeners
+                        );
+                    }
+
+                    if (firstListener) {
+                        OnKeyedListenerRegistered(
+                            eventTypeID,
+                            key
+                        );
+                    }
+
+                    return
+                        EventListenerHandlePtr(
+                            handler.release()
+                        );
+                }
+
+
+                void UnregisterKeyedListener(
+                    std::type_index eventType,
+                    uint64_t key,
+                    IEventListenerHandle*
+                        handler
+                ) override {
+                    const EventTypeID
+                        eventTypeID =
+                            EventTypeRegistry::Resolve(
+                                eventType
+                            );
+
+                    bool
+                        removedLast =
+                            false;
+
+                    {
+                        std::unique_lock<
+                            std::shared_mutex
+                        > lock(
+                            _eventListenersMutex
+                        );
+
+                        if (
+                            eventTypeID >=
+                            _keyedListeners.size()
+                        ) {
+                            return;
+                        }
+
+                        const auto keyed =
+                            _keyedListeners[
+                                eventTypeID
+                            ].find(
+                                key
                             );
 
                         if (
-                            found ==
-                                _eventListeners.end() ||
-                            !found->second
+                            keyed ==
+                            _keyedListeners[eventTypeID].end()
                         ) {
                             return;
                         }
@@ -872,46 +1652,154 @@ namespace ESPressio {
                             std::make_shared<
                                 EventListeners
                             >(
-                                *found->second
+                                *keyed->second
                             );
 
-                        for (
-                            auto it =
-                                listeners->begin();
-                            it !=
-                                listeners->end();
-                            ++it
-                        ) {
-                            if (
-                                (*it)->
-                                    GetListenerHandler() ==
-                                handler
-                            ) {
-                                static_cast<
-                                    EventListenerHandle*
-                                >(
-                                    handler
-                                )->ForceUnregister();
-
-                                listeners->erase(
-                                    it
-                                );
+                        const size_t previousSize =
+                            listeners->size();
+
+                        listeners->erase(
+                            std::remove_if(
+                                listeners->begin(),
+                                listeners->end(),
+                                [&](
+                                    const std::shared_ptr<
+                                        IEventListenerContainer
+                                    >& listener
+                                ) {
+                                    return
+                                        listener->
+                                            GetListenerHandler() ==
+                                        handler;
+                                }
+                            ),
+                            listeners->end()
+                        );
 
-                                break;
-                            }
+                        if (listeners->size() == previousSize) {
+                            return;
                         }
 
+                        static_cast<
+                            EventListenerHandle*
+                        >(
+                            handler
+                        )->ForceUnregister();
+
                         removedLast =
                             listeners->empty();
 
                         if (removedLast) {
-                            _eventListeners.erase(
-                                found
+                            RemoveKeyedListenersLocked(
+                                eventTypeID,
+                                keyed
                             );
                         } else {
-                            _eventListeners[
+                            keyed->second =
+                                listeners;
+                        }
+                    }
+
+                    if (removedLast) {
+                        OnKeyedListenerUnregistered(
+                            eventTypeID,
+                            key
+                        );
+                    }
+                }
+
+
+                void UnregisterListener(
+                    std::type_index eventType,
+                    IEventListenerHandle*
+                        handler
+                ) override {
+                    const EventTypeID
+                        eventTypeID =
+                            EventTypeRegistry::Resolve(
                                 eventType
-                            ] = listeners;
+                            );
+
+                    bool
+                        removedLast =
+                            false;
+
+                    bool
+                        removedLastPolymorphic =
+                            false;
+
+                    {
+                        std::unique_lock<
+                            std::shared_mutex
+                        > lock(
+                            _eventListenersMutex
+                        );
+
+                        if (
+                            RemovePolymorphicListenersLocked(
+                                eventTypeID,
+                                handler
+                            )
+                        ) {
+                            removedLastPolymorphic =
+                                !HasPolymorphicListenersLocked(
+                                    eventTypeID
+                                );
+                        } else {
+                            if (
+                                eventTypeID >=
+                                    _eventListeners.size() ||
+                                !_eventListeners[eventTypeID]
+                            ) {
+                                return;
+                            }
+
+                            auto listeners =
+                                std::make_shared<
+                                    EventListeners
+                                >(
+                                    *_eventListeners[eventTypeID]
+                                );
+
+                            for (
+                                auto it =
+                                    listeners->begin();
+                                it !=
+                                    listeners->end();
+                                ++it
+                            ) {
+                                if (
+                                    (*it)->
+                                        GetListenerHandler() ==
+                                    handler
+                                ) {
+                                    static_cast<
+                                        EventListenerHandle*
+                                    >(
+                                        handler
+                                    )->ForceUnregister();
+
+                                    listeners->erase(
+                                        it
+                                    );
+
+                                    break;
+                                }
+                            }
+
+                            removedLast =
+                                listeners->empty();
+
+                            if (removedLast) {
+                                RemoveListenersLocked(
+                                    eventTypeID
+                                );
+                            } else {
+                                _eventListeners[
+                                    eventTypeID
+                                ] = listeners;
+                                _resolvedListeners.clear();
+                            }
                         }
                     }
 
@@ -920,6 +1808,12 @@ namespace ESPressio {
                             eventType
                         );
                     }
+
+                    if (removedLastPolymorphic) {
+                        OnPolymorphicListenerUnregistered(
+                            eventTypeID
+                        );
+                    }
                 }
 
 
@@ -932,6 +1826,17 @@ namespace ESPressio {
                     EventListenersSnapshot
                         listeners;
 
+                    EventListenersSnapshot
+                        keyedListeners;
+
+                    const EventTypeID
+                        eventType =
+                            event->GetEventTypeID();
+
+                    bool
+                        resolve =
+                            false;
+
                     {
                         std::shared_lock<
                             std::shared_mutex
@@ -939,35 +1844,93 @@ namespace ESPressio {
                             _eventListenersMutex
                         );
 
-                        const auto found =
-                            _eventListeners.find(
-                                std::type_index(
-                                    typeid(*event)
-                                )
-                            );
+                        uint64_t
+                            key =
+                                0;
 
                         if (
-                            found ==
-                                _eventListeners.end() ||
-                            !found->second
+                            eventType <
+                                _keyedListeners.size() &&
+                            !_keyedListeners[eventType].empty() &&
+                            event->GetRoutingKey(
+                                key
+                            )
                         ) {
-                            return;
+                            const auto keyed =
+                                _keyedListeners[
+                                    eventType
+                                ].find(
+                                    key
+                                );
+
+                            if (
+                                keyed !=
+                                _keyedListeners[eventType].end()
+                            ) {
+                                keyedListeners =
+                                    keyed->second;
+                            }
                         }
 
+                        if (!_polymorphicListeners.empty()) {
+                            if (
+                                eventType <
+                                    _resolvedListeners.size() &&
+                                _resolvedListeners[eventType]
+                            ) {
+                                listeners =
+                                    _resolvedListeners[
+                                        eventType
+                                    ];
+                            } else {
+                                resolve =
+                                    true;
+                            }
+                        } else if (
+                            eventType <
+                            _eventListeners.size()
+                        ) {
+                            listeners =
+                                _eventListeners[
+                                    eventType
+                                ];
+                        }
+                    }
+
+                    if (resolve) {
                         listeners =
-                            found->second;
+                            ResolveListeners(
+                                event,
+                                eventType
+                            );
                     }
 
-                    for (
-                        const auto&
-                            listener :
-                        *listeners
-                    ) {
-                        listener->ProcessEvent(
-                            event,
-                            dispatchMethod,
-                            priority
-                        );
+                    if (listeners) {
+                        for (
+                            const auto&
+                                listener :
+                            *listeners
+                        ) {
+                            listener->ProcessEvent(
+                                event,
+                                dispatchMethod,
+                                priority
+                            );
+                        }
+                    }
+
+                    if (keyedListeners) {
+                        for (
+                            const auto&
+                                listener :
+                            *keyedListeners
+                        ) {
+                            listener->ProcessEvent(
+                                event,
+                                dispatchMethod,
+                                priority
+                            );
+                        }
                     }
                 }
         };
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -8,6 +16,7 @@
 #include <ESPressio_Thread.hpp>
 #include "ESPressio_EventDispatcher.hpp"
 #include "ESPressio_EventManagerObservable.hpp"
+#include "ESPressio_EventSimulation.hpp"
 
 #ifndef ESPRESSIO_EVENT_MANAGER_PRIORITY
     #define ESPRESSIO_EVENT_MANAGER_PRIORITY 2
@@ -17,13 +26,67 @@
     #define ESPRESSIO_EVENT_MANAGER_CORE_ID 0
 #endif
 
+/*
+ * Number of dispatch worker Threads fanning Events out to receivers. Zero
+ * (the default) keeps all fan-out on the EventManager Thread.
+ */
+#ifndef ESPRESSIO_EVENT_MANAGER_WORKER_COUNT
+    #define ESPRESSIO_EVENT_MANAGER_WORKER_COUNT 0
+#endif
+
+#ifndef ESPRESSIO_EVENT_MANAGER_WORKER_PRIORITY
+    #define ESPRESSIO_EVENT_MANAGER_WORKER_PRIORITY ESPRESSIO_EVENT_MANAGER_PRIORITY
+#endif
+
+/*
+ * Worker n is pinned to core (n % ESPRESSIO_EVENT_MANAGER_WORKER_CORE_COUNT),
+ * spreading workers over both ESP32 cores by default.
+ */
+#ifndef ESPRESSIO_EVENT_MANAGER_WORKER_CORE_COUNT
+    #define ESPRESSIO_EVENT_MANAGER_WORKER_CORE_COUNT 2
+#endif
+
 using namespace ESPressio::Threads;
 
 namespace ESPressio {
 
     namespace Event {
 
-        class EventManager : public Thread, public EventDispatcher {
+        /*
+         * Dispatcher Thread and queue settings of a named Event bus. The
+         * queue defaults to the receiver default bound
+         * (ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT); zero
+         * MaximumPendingEventCount leaves it unbounded.
+         */
+        struct EventBusOptions {
+            uint8_t Priority = ESPRESSIO_EVENT_MANAGER_PRIORITY;
+            int CoreID = ESPRESSIO_EVENT_MANAGER_CORE_ID;
+            size_t WorkerCount = 0;
+            uint8_t WorkerPriority = ESPRESSIO_EVENT_MANAGER_WORKER_PRIORITY;
+            size_t MaximumPendingEventCount =
+                ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT;
+            EventQueueOverflowPolicy OverflowPolicy =
+                EventQueueOverflowPolicy::BlockProducer;
+        };
+
+        /*
+         * An EventManager is one Event bus: a queue, its dispatcher Thread
+         * and the receivers registered with it. GetInstance() is the
+         * default bus; CreateBus() adds named buses that share nothing
+         * with it, so a chatty subsystem cannot exhaust another's queue
+         * or delay its dispatch.
+         *
+         * In simulation builds (ESPRESSIO_EVENT_SIMULATION) the EventManager
+         * starts no Thread or dispatch workers; an EventSimulation it is
+         * added to dispatches whenever Events are pending.
+         */
+        class EventManager :
+            public Thread,
+            public EventDispatcher
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
             private:
                 std::atomic<TaskHandle_t>
                     _notificationTask{
@@ -33,16 +96,166 @@ namespace ESPressio {
                 std::shared_ptr<EventManagerObservable> _observable =
                     CreateEventManagerObservable();
 
-            protected:
-                EventManager() : Thread(true) {
+                /*
+                 * Each observer declaring Event type interest owns one bit
+                 * of the per-type interest mask kept in the routing
+                 * snapshot. Bits are assigned process-wide, so an observer
+                 * keeps its bit on every bus, and stored in the observer
+                 * so notification tests it without a lookup.
+                 */
+                static constexpr size_t ObserverInterestSlotCount = 32;
+
+                struct ObserverInterest {
+                    IEventManagerObserver* observer = nullptr;
+                    uint32_t bit = 0;
+                    std::vector<EventTypeID> types;
+                };
+
+                struct ObserverInterestBits {
+                    std::mutex mutex;
+                    uint32_t assigned = 0;
+                };
+
+                std::mutex _observerInterestMutex;
+
+                std::vector<ObserverInterest> _observerInterests;
+
+                /*
+                 * Observers notified of every Event type. Observers
+                 * unregistered through their handle rather than
+                 * UnregisterObserver() stay counted, which only costs the
+                 * fast path.
+                 */
+                std::vector<IEventManagerObserver*> _unfilteredObservers;
+
+                std::atomic<size_t>
+                    _unfilteredObserverCount{
+                        0
+                    };
+
+                class DispatchWorkerThread final : public Thread {
+                    private:
+                        EventManager& _manager;
+                        size_t _workerIndex;
+
+                    protected:
+                        void OnLoop() override {
+                            if (
+                                !_manager.ProcessDispatchWorker(
+                                    _workerIndex
+                                )
+                            ) {
+                                Terminate();
+                            }
+                        }
+
+                    public:
+                        DispatchWorkerThread(
+                            EventManager& manager,
+                            size_t workerIndex
+                        ) :
+                            Thread(false),
+                            _manager(manager),
+                            _workerIndex(workerIndex) {
+                        }
+                };
+
+                std::unique_ptr<
+                    std::unique_ptr<DispatchWorkerThread>[]
+                > _dispatchWorkerThreads;
+
+                const std::string _busName;
+
+                const uint8_t _workerPriority;
+
+                // Named buses live as long as the program, like the default
+                static std::mutex& GetBusesMutex() {
+                    static std::mutex mutex;
+                    return mutex;
+                }
+
+                static std::vector<EventManager*>& GetBuses() {
+                    static std::vector<EventManager*> buses;
+                    return buses;
+                }
+
+                EventManager(
+                    const char* busName,
+                    const EventBusOptions& options
+                ) :
+                    Thread(true),
+                    _busName(busName),
+                    _workerPriority(options.WorkerPriority) {
                     SetPriority(
-                        ESPRESSIO_EVENT_MANAGER_PRIORITY
+                        options.Priority
                     );
                     SetCoreID(
-                        ESPRESSIO_EVENT_MANAGER_CORE_ID
+                        options.CoreID
+                    );
+                    SetMaximumPendingEventCount(
+                        options.MaximumPendingEventCount
+                    );
+                    SetEventQueueOverflowPolicy(
+                        options.OverflowPolicy
+                    );
+#if !ESPRESSIO_EVENT_SIMULATION
+                    StartDispatchWorkerThreads(
+                        options.WorkerCount
                     );
                     Initialize();
                     Start();
+#endif
+                }
+
+                static EventBusOptions CreateDefaultBusOptions() {
+                    EventBusOptions options;
+                    options.WorkerCount =
+                        ESPRESSIO_EVENT_MANAGER_WORKER_COUNT;
+                    return options;
+                }
+
+            protected:
+                EventManager() :
+                    EventManager(
+                        "",
+                        CreateDefaultBusOptions()
+                    ) {
+                }
+
+                void StartDispatchWorkerThreads(size_t workerCount) {
+                    if (!StartDispatchWorkers(workerCount)) {
+                        return;
+                    }
+
+                    _dispatchWorkerThreads.reset(
+                        new std::unique_ptr<DispatchWorkerThread>[
+                            workerCount
+                        ]
+                    );
+
+                    for (
+                        size_t index = 0;
+                        index < workerCount;
+                        ++index
+                    ) {
+                        DispatchWorkerThread* worker =
+                            new DispatchWorkerThread(
+                                *this,
+                                index
+                            );
+                        _dispatchWorkerThreads[index].reset(worker);
+                        worker->SetPriority(
+                            _workerPriority
+                        );
+                        worker->SetCoreID(
+                            static_cast<int>(
+                                index %
+                                ESPRESSIO_EVENT_MANAGER_WORKER_CORE_COUNT
+                            )
+                        );
+                        worker->Initialize();
+                        worker->Start();
+                    }
                 }
 
                 void OnLoop() override {
@@ -90,35 +303,485 @@ namespace ESPressio {
                     EventDispatchMethod method,
                     EventPriority priority
                 ) override {
+                    const uint32_t interest =
+                        GetEventTypeObserverInterestRouted(
+                            event->GetEventTypeID()
+                        );
+
+                    if (
+                        interest == 0 &&
+                        _unfilteredObserverCount.load(
+                            std::memory_order_acquire
+                        ) == 0
+                    ) {
+                        return;
+                    }
+
                     _observable->EventDispatched(
                         event, method, priority,
-                        event->__getDispatchContext()
+                        event->__getDispatchContext(),
+                        [&](IEventManagerObserver* observer) {
+                            return
+                                IsObserverInterested(
+                                    observer,
+                                    interest
+                                );
+                        }
+                    );
+                }
+
+
+                /*
+                 * Observers without a bit, unfiltered or beyond the slot
+                 * count, are notified of everything.
+                 */
+                static bool IsObserverInterested(
+                    IEventManagerObserver* observer,
+                    uint32_t interest
+                ) {
+                    const uint32_t bit =
+                        observer->_eventTypeInterestSlot.bit.load(
+                            std::memory_order_acquire
+                        );
+
+                    return
+                        bit == 0 ||
+                        (interest & bit) != 0;
+                }
+
+
+                static ObserverInterestBits& GetObserverInterestBits() {
+                    static ObserverInterestBits bits;
+                    return bits;
+                }
+
+
+                /*
+                 * Takes a hold on observer's interest bit, assigning a
+                 * free one to its first holder. Returns zero when every
+                 * bit is taken.
+                 */
+                static uint32_t HoldObserverInterestBit(
+                    IEventManagerObserver* observer
+                ) {
+                    ObserverInterestBits& bits =
+                        GetObserverInterestBits();
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        bits.mutex
+                    );
+
+                    IEventManagerObserver::EventTypeInterestSlot& slot =
+                        observer->_eventTypeInterestSlot;
+
+                    if (slot.holders++ == 0) {
+                        for (
+                            size_t index = 0;
+                            index < ObserverInterestSlotCount;
+                            ++index
+                        ) {
+                            const uint32_t bit =
+                                uint32_t(1) << index;
+
+                            if ((bits.assigned & bit) == 0) {
+                                bits.assigned |= bit;
+                                slot.bit.store(
+                                    bit,
+                                    std::memory_order_release
+                                );
+                                break;
+                            }
+                        }
+                    }
+
+                    return
+                        slot.bit.load(
+                            std::memory_order_relaxed
+                        );
+                }
+
+
+                // Frees observer's interest bit with its last holder
+                static void ReleaseObserverInterestBit(
+                    IEventManagerObserver* observer
+                ) {
+                    ObserverInterestBits& bits =
+                        GetObserverInterestBits();
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        bits.mutex
+                    );
+
+                    IEventManagerObserver::EventTypeInterestSlot& slot =
+                        observer->_eventTypeInterestSlot;
+
+                    if (slot.holders == 0 || --slot.holders != 0) {
+                        return;
+                    }
+
+                    bits.assigned &=
+                        ~slot.bit.load(
+                            std::memory_order_relaxed
+                        );
+                    slot.bit.store(
+                        0,
+                        std::memory_order_release
+                    );
+                }
+
+
+                void AddUnfilteredObserverLocked(
+                    IEventManagerObserver* observer
+                ) {
+                    if (
+                        std::find(
+                            _unfilteredObservers.begin(),
+                            _unfilteredObservers.end(),
+                            observer
+                        ) != _unfilteredObservers.end()
+                    ) {
+                        return;
+                    }
+
+                    _unfilteredObservers.push_back(
+                        observer
+                    );
+                    _unfilteredObserverCount.store(
+                        _unfilteredObservers.size(),
+                        std::memory_order_release
+                    );
+                }
+
+
+                void RemoveUnfilteredObserverLocked(
+                    IEventManagerObserver* observer
+                ) {
+                    _unfilteredObservers.erase(
+                        std::remove(
+                            _unfilteredObservers.begin(),
+                            _unfilteredObservers.end(),
+                            observer
+                        ),
+                        _unfilteredObservers.end()
+                    );
+                    _unfilteredObserverCount.store(
+                        _unfilteredObservers.size(),
+                        std::memory_order_release
                     );
                 }
 
+
+                ObserverInterest* FindObserverInterestLocked(
+                    IEventManagerObserver* observer
+                ) {
+                    for (ObserverInterest& interest : _observerInterests) {
+                        if (interest.observer == observer) {
+                            return &interest;
+                        }
+                    }
+
+                    return nullptr;
+                }
+
+
+                /*
+                 * Finds or creates observer's interest record, holding its
+                 * interest bit. With every bit taken the observer is
+                 * notified of all types instead.
+                 */
+                ObserverInterest& AcquireObserverInterestLocked(
+                    IEventManagerObserver* observer
+                ) {
+                    ObserverInterest* found =
+                        FindObserverInterestLocked(
+                            observer
+                        );
+
+                    if (found != nullptr) {
+                        return *found;
+                    }
+
+                    ObserverInterest interest;
+                    interest.observer = observer;
+                    interest.bit =
+                        HoldObserverInterestBit(
+                            observer
+                        );
+
+                    if (interest.bit == 0) {
+                        AddUnfilteredObserverLocked(
+                            observer
+                        );
+                    }
+
+                    _observerInterests.push_back(
+                        std::move(interest)
+                    );
+                    return _observerInterests.back();
+                }
+
             public:
                 Observable::ObserverHandlePtr RegisterObserver(
                     IEventManagerObserver* observer
                 ) {
-                    return _observable->RegisterObserver(observer);
+                    Observable::ObserverHandlePtr handle =
+                        _observable->RegisterObserver(observer);
+
+                    if (handle) {
+                        std::lock_guard<
+                            std::mutex
+                        > lock(
+                            _observerInterestMutex
+                        );
+
+                        if (observer->DeclaresEventTypeInterest()) {
+                            AcquireObserverInterestLocked(
+                                observer
+                            );
+                        } else {
+                            AddUnfilteredObserverLocked(
+                                observer
+                            );
+                        }
+                    }
+
+                    return handle;
                 }
 
                 void UnregisterObserver(
                     IEventManagerObserver* observer
                 ) {
                     _observable->UnregisterObserver(observer);
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _observerInterestMutex
+                    );
+
+                    RemoveUnfilteredObserverLocked(
+                        observer
+                    );
+
+                    ObserverInterest* interest =
+                        FindObserverInterestLocked(
+                            observer
+                        );
+
+                    if (interest == nullptr) {
+                        return;
+                    }
+
+                    for (EventTypeID type : interest->types) {
+                        UnregisterObservedEventType(
+                            type,
+                            interest->bit
+                        );
+                    }
+
+                    ReleaseObserverInterestBit(
+                        observer
+                    );
+
+                    _observerInterests.erase(
+                        _observerInterests.begin() +
+                        (interest - _observerInterests.data())
+                    );
                 }
 
+                /*
+                 * Declares that observer wants Events of type. Observers
+                 * whose DeclaresEventTypeInterest() returns true are only
+                 * notified of declared types, and Events of a type no
+                 * observer or receiver wants skip observer notification
+                 * without taking the observable's lock. Declared types
+                 * also count as observed for UnobservedEventPolicy.
+                 * Declarations may precede RegisterObserver().
+                 */
+                void DeclareObserverInterest(
+                    IEventManagerObserver* observer,
+                    EventTypeID type
+                ) {
+                    if (observer == nullptr || type == 0) {
+                        return;
+                    }
+
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _observerInterestMutex
+                    );
+
+                    ObserverInterest& interest =
+                        AcquireObserverInterestLocked(
+                            observer
+                        );
+
+                    if (
+                        std::find(
+                            interest.types.begin(),
+                            interest.types.end(),
+                            type
+                        ) != interest.types.end()
+                    ) {
+                        return;
+                    }
+
+                    interest.types.push_back(
+                        type
+                    );
+                    RegisterObservedEventType(
+                        type,
+                        interest.bit
+                    );
+                }
+
+                template<typename TEvent>
+                void DeclareObserverInterest(
+                    IEventManagerObserver* observer
+                ) {
+                    DeclareObserverInterest(
+                        observer,
+                        EventTypeRegistry::Of<TEvent>()
+                    );
+                }
+
+                void WithdrawObserverInterest(
+                    IEventManagerObserver* observer,
+                    EventTypeID type
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _observerInterestMutex
+                    );
+
+                    ObserverInterest* interest =
+                        FindObserverInterestLocked(
+                            observer
+                        );
+
+                    if (interest == nullptr) {
+                        return;
+                    }
+
+                    const auto found =
+                        std::find(
+                            interest->types.begin(),
+                            interest->types.end(),
+                            type
+                        );
+
+                    if (found == interest->types.end()) {
+                        return;
+                    }
+
+                    interest->types.erase(
+                        found
+                    );
+                    UnregisterObservedEventType(
+                        type,
+                        interest->bit
+                    );
+                }
+
+                template<typename TEvent>
+                void WithdrawObserverInterest(
+                    IEventManagerObserver* observer
+                ) {
+                    WithdrawObserverInterest(
+                        observer,
+                        EventTypeRegistry::Of<TEvent>()
+                    );
+                }
+
+#if ESPRESSIO_EVENT_SIMULATION
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t nowNanoseconds
+                ) override {
+                    return
+                        GetPendingEventCount() == 0
+                            ? std::numeric_limits<uint64_t>::max()
+                            : nowNanoseconds;
+                }
+
+                void RunSimulationStep(uint64_t) override {
+                    DispatchEvents();
+                }
+#endif
+
                 static EventManager* GetInstance() {
                     static EventManager* instance = new EventManager();
                     return instance;
                 }
 
+                /*
+                 * Creates the named bus with its own dispatcher Thread,
+                 * priority, core and queue limits. Returns nullptr when the
+                 * name is empty or already taken. Buses are never destroyed.
+                 */
+                static EventManager* CreateBus(
+                    const char* name,
+                    const EventBusOptions& options = EventBusOptions{}
+                ) {
+                    if (name == nullptr || name[0] == '\0') {
+                        return nullptr;
+                    }
+
+                    std::lock_guard<std::mutex> lock(GetBusesMutex());
+                    for (EventManager* bus : GetBuses()) {
+                        if (bus->_busName == name) {
+                            return nullptr;
+                        }
+                    }
+
+                    EventManager* bus = new EventManager(name, options);
+                    GetBuses().push_back(bus);
+                    return bus;
+                }
+
+                /*
+                 * The named bus, or nullptr if none was created. A null or
+                 * empty name selects the default bus.
+                 */
+                static EventManager* GetBus(const char* name) {
+                    if (name == nullptr || name[0] == '\0') {
+                        return GetInstance();
+                    }
+
+                    std::lock_guard<std::mutex> lock(GetBusesMutex());
+                    for (EventManager* bus : GetBuses()) {
+                        if (bus->_busName == name) {
+                            return bus;
+                        }
+                    }
+                    return nullptr;
+                }
+
+                // Empty for the default bus
+                const char* GetBusName() const noexcept {
+                    return _busName.c_str();
+                }
+
                 virtual ~EventManager() {
                     _notificationTask.store(
                         nullptr,
                         std::memory_order_release
                     );
+
+                    StopDispatchWorkers();
+
+                    for (
+                        size_t index = 0;
+                        index < GetDispatchWorkerCount();
+                        ++index
+                    ) {
+                        _dispatchWorkerThreads[index]->Shutdown();
+                    }
                 }
 
         };
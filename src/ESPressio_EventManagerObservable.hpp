@@ -13,9 +13,24 @@ public:
         EventDispatchMethod method,
         EventPriority priority,
         const EventDispatchContext& context
+    ) {
+        EventDispatched(
+            event, method, priority, context,
+            [](IEventManagerObserver*) { return true; }
+        );
+    }
+
+    template <typename TInterested>
+    void EventDispatched(
+        IEvent* event,
+        EventDispatchMethod method,
+        EventPriority priority,
+        const EventDispatchContext& context,
+        TInterested&& isInterested
     ) {
         ExecuteNotification([&](NotificationContext& notification) {
             notification.WithObservers<IEventManagerObserver>([&](IEventManagerObserver* observer) {
+                if (!isInterested(observer)) { return; }
                 try { observer->OnEventDispatched(event, method, priority, context); }
                 catch (...) {}
             });
@@ -7,18 +7,58 @@
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
-#include <typeindex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <ESPressio_SystemClock.hpp>
+#include <ESPressio_TimeTraits.hpp>
+
 #include "ESPressio_EventEnums.hpp"
 #include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
+#include "ESPressio_EventLatencyHistogram.hpp"
+#include "ESPressio_EventRingBuffer.hpp"
+#include "ESPressio_EventSpan.hpp"
+#include "ESPressio_EventSubmissionRing.hpp"
+#include "ESPressio_EventTypeID.hpp"
 
 #ifndef ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT
     #define ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT 64
 #endif
 
+#ifndef ESPRESSIO_EVENT_DEFAULT_HIGH_PRIORITY_WEIGHT
+    #define ESPRESSIO_EVENT_DEFAULT_HIGH_PRIORITY_WEIGHT 4
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_NORMAL_PRIORITY_WEIGHT
+    #define ESPRESSIO_EVENT_DEFAULT_NORMAL_PRIORITY_WEIGHT 2
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_LOW_PRIORITY_WEIGHT
+    #define ESPRESSIO_EVENT_DEFAULT_LOW_PRIORITY_WEIGHT 1
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_SUBMISSION_RING_CAPACITY
+    #define ESPRESSIO_EVENT_DEFAULT_SUBMISSION_RING_CAPACITY 64
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_SUBMISSION_SHARD_COUNT
+    #define ESPRESSIO_EVENT_DEFAULT_SUBMISSION_SHARD_COUNT 4
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_PRODUCER_SPIN_COUNT
+    #define ESPRESSIO_EVENT_DEFAULT_PRODUCER_SPIN_COUNT 64
+#endif
+
+#ifndef ESPRESSIO_EVENT_DEFAULT_PRODUCER_YIELD_COUNT
+    #define ESPRESSIO_EVENT_DEFAULT_PRODUCER_YIELD_COUNT 0
+#endif
+
 namespace ESPressio {
     namespace Event {
 
@@ -35,6 +75,109 @@ namespace ESPressio {
             ReleaseAfterDrain
         };
 
+        /*
+         * Locked submission takes the receiver mutex for every enqueue.
+         * LockFree submission first offers each Event to a bounded
+         * multi-producer ring for its priority and only falls back to the
+         * locked path when the receiver is saturated and the overflow policy
+         * has to act. Sharded submission appends to one of several mutex
+         * protected shards chosen by the producer's thread id, so producers
+         * contend only with others hashed to the same shard; it falls back
+         * the same way. Both modes preserve each producer's FIFO order.
+         */
+        enum class EventSubmissionMode : uint8_t {
+            Locked,
+            LockFree,
+            Sharded
+        };
+
+        /*
+         * Submission path counters. A contention is a lock that was already
+         * held when a producer (or, for shards, the merging consumer) tried
+         * to take it.
+         */
+        struct EventSubmissionStatistics {
+            uint64_t LockedSubmissionCount = 0;
+            uint64_t LockedContentionCount = 0;
+            uint64_t ShardedSubmissionCount = 0;
+            uint64_t ShardContentionCount = 0;
+        };
+
+        /*
+         * Limits a single WithEvents pass. Zero means unlimited. The time
+         * quota is measured with the receiver's drain clock (the System
+         * Clock unless overridden) and checked after each Event, so one
+         * long-running callback can still overrun it.
+         */
+        struct EventDrainBudget {
+            size_t MaximumEventCount = 0;
+            uint64_t MaximumDurationNanoseconds = 0;
+        };
+
+        /*
+         * StrictPriority drains every stack from High to Low, then every
+         * queue from High to Low, as Event always has. WeightedRoundRobin
+         * serves priorities in proportion to their weights so Low priority
+         * Events cannot starve and High priority arrivals are not held
+         * behind a long Low backlog.
+         */
+        enum class EventSchedulingPolicy : uint8_t {
+            StrictPriority,
+            WeightedRoundRobin
+        };
+
+        /*
+         * LatestValueWins lets a newly added Event replace a pending Event
+         * of the same type and coalescing key (see IEvent::GetCoalescingKey)
+         * in place, keeping the older Event's position. Replacement only
+         * happens within the same priority and dispatch method; it never
+         * consumes capacity, so the overflow policy is not applied.
+         * Coalescing Events bypass the lock-free submission rings.
+         */
+        enum class EventCoalescingPolicy : uint8_t {
+            Disabled,
+            LatestValueWins
+        };
+
+        /*
+         * Adaptive backoff for EventQueueOverflowPolicy::BlockProducer. A
+         * producer facing a full receiver first polls for capacity
+         * SpinCount times without the receiver lock (skipped on a single
+         * core, where the consumer cannot run meanwhile), then yields
+         * YieldCount times, and only then parks. Parked producers are woken one per
+         * free slot once the retained Event count falls to LowWatermark;
+         * zero means as soon as any capacity is free.
+         */
+        struct EventBackpressurePolicy {
+            size_t SpinCount = ESPRESSIO_EVENT_DEFAULT_PRODUCER_SPIN_COUNT;
+            size_t YieldCount = ESPRESSIO_EVENT_DEFAULT_PRODUCER_YIELD_COUNT;
+            size_t LowWatermark = 0;
+        };
+
+        struct EventBackpressureStatistics {
+            uint64_t BlockedProducerCount = 0;
+            uint64_t ParkedProducerCount = 0;
+            uint64_t TotalBlockedNanoseconds = 0;
+            uint64_t MaximumBlockedNanoseconds = 0;
+        };
+
+        struct EventDrainResult {
+            size_t ProcessedEventCount = 0;
+            size_t ExpiredEventCount = 0;
+            bool BudgetExhausted = false;
+            uint64_t ElapsedNanoseconds = 0;
+        };
+
+        struct EventDrainStatistics {
+            uint64_t DrainCount = 0;
+            uint64_t ProcessedEventCount = 0;
+            uint64_t BudgetExhaustedCount = 0;
+            uint64_t TotalDrainNanoseconds = 0;
+            uint64_t MaximumDrainNanoseconds = 0;
+            size_t LastProcessedEventCount = 0;
+            uint64_t LastDrainNanoseconds = 0;
+        };
+
         class IEventReceiver {
             public:
                 virtual ~IEventReceiver() = default;
@@ -46,6 +189,32 @@ namespace ESPressio {
                     IEvent* event,
                     EventPriority priority = EventPriority::Normal
                 ) = 0;
+
+                /*
+                 * Batch enqueue. Receivers that can admit a whole batch under
+                 * one lock override these; the defaults preserve behaviour for
+                 * existing IEventReceiver implementations.
+                 */
+                virtual void QueueEvents(
+                    EventSpan events,
+                    EventPriority priority = EventPriority::Normal
+                ) {
+                    for (IEvent* event : events) {
+                        if (event != nullptr) {
+                            QueueEvent(event, priority);
+                        }
+                    }
+                }
+                virtual void StackEvents(
+                    EventSpan events,
+                    EventPriority priority = EventPriority::Normal
+                ) {
+                    for (IEvent* event : events) {
+                        if (event != nullptr) {
+                            StackEvent(event, priority);
+                        }
+                    }
+                }
         };
 
         class EventReceiver : public IEventReceiver {
@@ -53,9 +222,22 @@ namespace ESPressio {
                 struct PendingEvent {
                     IEvent* event = nullptr;
                     uint64_t sequence = 0;
+                    uint64_t expiresAtNanoseconds = 0;
+                    bool coalescing = false;
+                    uint64_t coalescingKey = 0;
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    uint64_t enqueuedAtNanoseconds = 0;
+#endif
                 };
 
-                using EventDispatchCollection = std::vector<PendingEvent>;
+                /*
+                 * Each collection is ordered by sequence because Events are
+                 * only ever appended, so the oldest entry of a collection is
+                 * always its front. Ring storage makes removing that front
+                 * entry O(1).
+                 */
+                using EventDispatchCollection =
+                    EventRingBuffer<PendingEvent>;
 
                 static constexpr size_t PriorityCount =
                     static_cast<size_t>(EventPriority::High) + 1;
@@ -67,6 +249,8 @@ namespace ESPressio {
                     >;
 
                 static constexpr size_t CapacitySampleCount = 16;
+                static constexpr size_t BatchReleaseChunkSize = 16;
+                static constexpr size_t StaticDrainChunkSize = 8;
 
                 static constexpr size_t PriorityIndex(
                     EventPriority priority
@@ -74,15 +258,95 @@ namespace ESPressio {
                     return static_cast<size_t>(priority);
                 }
 
+                using SubmissionRings =
+                    std::array<
+                        std::unique_ptr<EventSubmissionRing>,
+                        PriorityCount
+                    >;
+
+                struct ShardSubmission {
+                    EventSubmissionRing::Submission submission{};
+                    size_t priorityID = 0;
+                };
+
+                struct SubmissionShard {
+                    std::mutex mutex;
+                    EventRingBuffer<ShardSubmission> submissions;
+                    uint64_t submissionCount = 0;
+                    uint64_t contentionCount = 0;
+                };
+
+                struct CoalescingKey {
+                    EventTypeID type;
+                    uint64_t key;
+
+                    bool operator==(const CoalescingKey& other) const {
+                        return type == other.type && key == other.key;
+                    }
+                };
+
+                struct CoalescingKeyHash {
+                    size_t operator()(const CoalescingKey& value) const {
+                        const size_t hash =
+                            std::hash<EventTypeID>()(value.type);
+                        return hash ^ (std::hash<uint64_t>()(value.key) +
+                            0x9e3779b9 + (hash << 6) + (hash >> 2));
+                    }
+                };
+
+                /*
+                 * Locates a pending entry by collection and absolute ring
+                 * position. The sequence confirms the entry is still the one
+                 * that was indexed, so a stale index entry is never trusted.
+                 */
+                struct CoalescingEntry {
+                    size_t collectionID = 0;
+                    uint64_t position = 0;
+                    uint64_t sequence = 0;
+                };
+
+                using CoalescingIndex =
+                    std::unordered_map<
+                        CoalescingKey,
+                        CoalescingEntry,
+                        CoalescingKeyHash
+                    >;
+
                 mutable std::mutex _eventsMutex;
                 std::condition_variable _capacityAvailable;
                 EventCollection _priorityQueues;
                 EventCollection _priorityStacks;
                 size_t _pendingEventCount = 0;
-                size_t _processingEventCount = 0;
                 size_t _peakPendingEventCount = 0;
-                size_t _maximumPendingEventCount =
-                    ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT;
+                /*
+                 * Pending, in-flight and ring-resident Events. Atomic so the
+                 * lock-free submission path can reserve capacity without the
+                 * receiver mutex.
+                 */
+                std::atomic<size_t> _retainedEventCount{0};
+                std::atomic<size_t> _submittedEventCount{0};
+                IEvent** _staticReleaseStorage = nullptr;
+                size_t _staticCapacity = 0;
+                /*
+                 * Entries per collection of static storage, and the Events
+                 * each collection has out with a drain. Those keep their
+                 * entries until the drain returns them or finishes.
+                 */
+                size_t _staticCollectionCapacity = 0;
+                std::array<size_t, 2 * PriorityCount> _staticTakenCounts{};
+                std::atomic<size_t> _peakSubmittedRetainedCount{0};
+                std::atomic<size_t> _maximumPendingEventCount{
+                    ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT
+                };
+                std::atomic<EventSubmissionMode> _submissionMode{
+                    EventSubmissionMode::Locked
+                };
+                std::atomic<bool> _acceptingSubmissions{true};
+                SubmissionRings _submissionRings{};
+                std::unique_ptr<SubmissionShard[]> _submissionShards;
+                size_t _submissionShardCount = 0;
+                uint64_t _lockedSubmissionCount = 0;
+                uint64_t _lockedContentionCount = 0;
                 EventQueueOverflowPolicy _overflowPolicy =
                     EventQueueOverflowPolicy::BlockProducer;
                 EventCollectionCapacityPolicy _capacityPolicy =
@@ -96,9 +360,63 @@ namespace ESPressio {
                 uint64_t _rejectedEventCount = 0;
                 uint64_t _droppedEventCount = 0;
                 bool _acceptingPendingEvents = true;
+                EventDrainBudget _drainBudget{};
+                EventSchedulingPolicy _schedulingPolicy =
+                    EventSchedulingPolicy::StrictPriority;
+                std::array<size_t, PriorityCount> _priorityWeights{{
+                    ESPRESSIO_EVENT_DEFAULT_LOW_PRIORITY_WEIGHT,
+                    ESPRESSIO_EVENT_DEFAULT_NORMAL_PRIORITY_WEIGHT,
+                    ESPRESSIO_EVENT_DEFAULT_HIGH_PRIORITY_WEIGHT
+                }};
+                std::array<size_t, PriorityCount> _schedulingDeficits{};
+                size_t _schedulingCursor = PriorityIndex(EventPriority::High);
+                EventDrainStatistics _drainStatistics{};
+                EventBackpressurePolicy _backpressurePolicy{};
+                EventBackpressureStatistics _backpressureStatistics{};
+                size_t _parkedProducerCount = 0;
+                std::atomic<Timing::ISystemClock<EventTime>*> _drainClock{
+                    nullptr
+                };
+                std::atomic<EventCoalescingPolicy> _coalescingPolicy{
+                    EventCoalescingPolicy::Disabled
+                };
+                CoalescingIndex _coalescingIndex;
+                uint64_t _coalescedEventCount = 0;
+                uint64_t _expiredEventCount = 0;
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                std::array<
+                    EventLatencyHistogram<>,
+                    PriorityCount * 2
+                > _latencyHistograms{};
+#endif
 
                 size_t RetainedEventCountLocked() const {
-                    return _pendingEventCount + _processingEventCount;
+                    return _retainedEventCount.load(
+                        std::memory_order_acquire
+                    );
+                }
+
+                /*
+                 * Absolute expiry on the drain clock (GetDrainTimeNanoseconds),
+                 * captured when the receiver accepts the Event: the TTL left
+                 * after the Event's age since dispatch, measured on its own
+                 * clock, added to the drain clock's now. Zero means never.
+                 */
+                uint64_t ExpiryNanoseconds(const IEvent* event) const {
+                    const uint64_t timeToLive =
+                        event->GetTimeToLiveNanoseconds();
+                    if (timeToLive == 0) {
+                        return 0;
+                    }
+                    const uint64_t age =
+                        event->GetTimeSinceDispatchNanoseconds();
+                    const uint64_t remaining =
+                        age < timeToLive ? timeToLive - age : 0;
+                    const uint64_t now = GetDrainTimeNanoseconds();
+                    return now >
+                        std::numeric_limits<uint64_t>::max() - remaining
+                        ? std::numeric_limits<uint64_t>::max()
+                        : std::max<uint64_t>(now + remaining, 1);
                 }
 
                 static uint64_t NextSequence(uint64_t& sequence) {
@@ -136,9 +454,7 @@ namespace ESPressio {
                     }
                     if (_capacityPolicy ==
                         EventCollectionCapacityPolicy::ReleaseAfterDrain) {
-                        EventDispatchCollection replacement(collection);
-                        replacement.shrink_to_fit();
-                        collection.swap(replacement);
+                        collection.shrink_to_fit();
                         return;
                     }
 
@@ -151,36 +467,156 @@ namespace ESPressio {
                             : recentPeak * _capacityExcessFactor
                     );
                     if (collection.capacity() > target) {
-                        EventDispatchCollection replacement;
-                        replacement.reserve(std::max(
-                            target, collection.size()
-                        ));
-                        replacement.insert(
-                            replacement.end(),
-                            std::make_move_iterator(collection.begin()),
-                            std::make_move_iterator(collection.end())
-                        );
-                        collection.swap(replacement);
+                        collection.shrink_to(target);
+                    }
+                }
+
+                static size_t CollectionID(
+                    EventDispatchMethod method,
+                    size_t priorityIndex
+                ) {
+                    return method == EventDispatchMethod::Queue
+                        ? priorityIndex
+                        : PriorityCount + priorityIndex;
+                }
+
+                static constexpr size_t CollectionCount = 2 * PriorityCount;
+
+                static void ReverseCollection(
+                    EventDispatchCollection& collection,
+                    size_t begin,
+                    size_t end
+                ) noexcept {
+                    for (; begin + 1 < end; ++begin, --end) {
+                        std::swap(collection[begin], collection[end - 1]);
+                    }
+                }
+
+                EventDispatchCollection& CollectionLocked(size_t collectionID) {
+                    return collectionID < PriorityCount
+                        ? _priorityQueues[collectionID]
+                        : _priorityStacks[collectionID - PriorityCount];
+                }
+
+                bool CollectionsLimitedLocked() const {
+                    return _staticCollectionCapacity < _staticCapacity;
+                }
+
+                /*
+                 * True when static storage with a CollectionCapacity below
+                 * its Capacity has no entry left in collectionID.
+                 */
+                bool CollectionFullLocked(size_t collectionID) {
+                    return CollectionsLimitedLocked() &&
+                        CollectionLocked(collectionID).size() +
+                            _staticTakenCounts[collectionID] >=
+                                _staticCollectionCapacity;
+                }
+
+                /*
+                 * Indexes a coalescing entry by its absolute position. If the
+                 * index cannot grow, the entry is simply left uncoalesced.
+                 */
+                void IndexPendingEventLocked(
+                    size_t collectionID,
+                    EventDispatchCollection& collection,
+                    size_t index
+                ) noexcept {
+                    PendingEvent& entry = collection[index];
+                    if (!entry.coalescing) {
+                        return;
+                    }
+                    try {
+                        _coalescingIndex[CoalescingKey{
+                            entry.event->GetEventTypeID(), entry.coalescingKey
+                        }] = CoalescingEntry{
+                            collectionID,
+                            collection.front_position() + index,
+                            entry.sequence
+                        };
+                    } catch (...) {
+                        entry.coalescing = false;
+                    }
+                }
+
+                void IndexPendingEventsLocked(
+                    size_t collectionID,
+                    EventDispatchCollection& collection,
+                    size_t begin,
+                    size_t end
+                ) noexcept {
+                    for (size_t index = begin; index < end; ++index) {
+                        IndexPendingEventLocked(collectionID, collection, index);
+                    }
+                }
+
+                void ForgetPendingEventLocked(const PendingEvent& entry) {
+                    if (!entry.coalescing || _coalescingIndex.empty()) {
+                        return;
+                    }
+                    auto found = _coalescingIndex.find(CoalescingKey{
+                        entry.event->GetEventTypeID(), entry.coalescingKey
+                    });
+                    if (found != _coalescingIndex.end() &&
+                        found->second.sequence == entry.sequence) {
+                        _coalescingIndex.erase(found);
+                    }
+                }
+
+                /*
+                 * Replaces the pending Event with the same type and key in
+                 * the same collection. The replaced Event is handed back for
+                 * the caller to release outside the lock.
+                 */
+                bool CoalescePendingEventLocked(
+                    IEvent* event,
+                    uint64_t key,
+                    uint64_t expiresAtNanoseconds,
+                    size_t collectionID,
+                    IEvent*& replacedEvent
+                ) {
+                    auto found = _coalescingIndex.find(
+                        CoalescingKey{event->GetEventTypeID(), key}
+                    );
+                    if (found == _coalescingIndex.end()) {
+                        return false;
+                    }
+                    PendingEvent* entry =
+                        CollectionLocked(found->second.collectionID)
+                            .at_position(found->second.position);
+                    if (entry == nullptr ||
+                        entry->sequence != found->second.sequence) {
+                        _coalescingIndex.erase(found);
+                        return false;
                     }
+                    if (found->second.collectionID != collectionID) {
+                        return false;
+                    }
+                    replacedEvent = entry->event;
+                    entry->event = event;
+                    entry->expiresAtNanoseconds = expiresAtNanoseconds;
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    entry->enqueuedAtNanoseconds = GetDrainTimeNanoseconds();
+#endif
+                    ++_coalescedEventCount;
+                    return true;
                 }
 
+                /*
+                 * The global oldest entry is the smallest front sequence of
+                 * the six collections, so this inspects six fronts rather
+                 * than every pending Event.
+                 */
                 PendingEvent RemoveOldestLocked() {
                     EventDispatchCollection* selected = nullptr;
-                    size_t selectedIndex = 0;
-                    uint64_t selectedSequence =
-                        std::numeric_limits<uint64_t>::max();
 
                     auto consider = [&](EventCollection& collections) {
                         for (auto& collection : collections) {
-                            for (size_t index = 0;
-                                index < collection.size(); ++index) {
-                                if (collection[index].sequence <
-                                    selectedSequence) {
-                                    selected = &collection;
-                                    selectedIndex = index;
-                                    selectedSequence =
-                                        collection[index].sequence;
-                                }
+                            if (!collection.empty() &&
+                                (selected == nullptr ||
+                                    collection.front().sequence <
+                                        selected->front().sequence)) {
+                                selected = &collection;
                             }
                         }
                     };
@@ -191,10 +627,23 @@ namespace ESPressio {
                     if (selected == nullptr) {
                         return PendingEvent{};
                     }
+                    return RemoveFrontLocked(*selected);
+                }
+
+                PendingEvent RemoveFrontLocked(
+                    EventDispatchCollection& collection
+                ) {
+                    if (collection.empty()) {
+                        return PendingEvent{};
+                    }
 
-                    PendingEvent removed = (*selected)[selectedIndex];
-                    selected->erase(selected->begin() + selectedIndex);
+                    PendingEvent removed = collection.front();
+                    ForgetPendingEventLocked(removed);
+                    collection.pop_front();
                     --_pendingEventCount;
+                    _retainedEventCount.fetch_sub(
+                        1, std::memory_order_acq_rel
+                    );
                     return removed;
                 }
 
@@ -211,9 +660,13 @@ namespace ESPressio {
                             }
 
                             PendingEvent result = collection.front();
-                            collection.erase(collection.begin());
+                            ForgetPendingEventLocked(result);
+                            collection.pop_front();
                             removed = true;
                             --_pendingEventCount;
+                            _retainedEventCount.fetch_sub(
+                                1, std::memory_order_acq_rel
+                            );
                             return result;
                         };
 
@@ -230,218 +683,1122 @@ namespace ESPressio {
                     return PendingEvent{};
                 }
 
-                void AddEvent(
-                    IEvent* event,
-                    EventPriority priority,
-                    EventDispatchMethod method
+                void AcceptSubmissionLocked(
+                    const EventSubmissionRing::Submission& submission,
+                    size_t priorityID
                 ) {
-                    event->__dispatch();
-                    event->__ref();
-                    IEvent* displacedEvent = nullptr;
-                    bool accepted = false;
+                    EventCollection& collections =
+                        submission.method == EventDispatchMethod::Queue
+                            ? _priorityQueues
+                            : _priorityStacks;
                     try {
-                        std::unique_lock<std::mutex> lock(_eventsMutex);
-                        if (!_acceptingPendingEvents) {
-                            ++_rejectedEventCount;
-                            lock.unlock();
-                            event->__unref();
-                            return;
-                        }
-                        while (_maximumPendingEventCount > 0 &&
-                            RetainedEventCountLocked() >=
-                                _maximumPendingEventCount) {
-                            if (!_acceptingPendingEvents) {
-                                ++_rejectedEventCount;
-                                lock.unlock();
-                                event->__unref();
-                                return;
-                            }
-                            switch (_overflowPolicy) {
-                                case EventQueueOverflowPolicy::BlockProducer:
-                                    _capacityAvailable.wait(lock, [&]() {
-                                        return _maximumPendingEventCount == 0 ||
-                                            RetainedEventCountLocked() <
-                                                _maximumPendingEventCount ||
-                                            !_acceptingPendingEvents ||
-                                            _overflowPolicy !=
-                                                EventQueueOverflowPolicy::
-                                                    BlockProducer;
-                                    });
-                                    continue;
-                                case EventQueueOverflowPolicy::RejectIncoming:
-                                    ++_rejectedEventCount;
-                                    lock.unlock();
-                                    event->__unref();
-                                    return;
-                                case EventQueueOverflowPolicy::DropOldest:
-                                    displacedEvent =
-                                        RemoveOldestLocked().event;
-                                    if (displacedEvent == nullptr) {
-                                        ++_rejectedEventCount;
-                                        lock.unlock();
-                                        event->__unref();
-                                        return;
-                                    }
-                                    ++_droppedEventCount;
-                                    break;
-                                case EventQueueOverflowPolicy::
-                                    DropLowestPriority: {
-                                    bool removed = false;
-                                    PendingEvent displaced =
-                                        RemoveLowestPriorityLocked(removed);
-                                    if (!removed) {
-                                        ++_rejectedEventCount;
-                                        lock.unlock();
-                                        event->__unref();
-                                        return;
-                                    }
-                                    displacedEvent = displaced.event;
-                                    ++_droppedEventCount;
-                                    break;
-                                }
+                        collections[priorityID].push_back(
+                            PendingEvent{
+                                submission.event,
+                                NextSequence(_nextSequence),
+                                submission.expiresAtNanoseconds
                             }
-                            break;
-                        }
+                        );
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                        collections[priorityID].back()
+                            .enqueuedAtNanoseconds =
+                                submission.enqueuedAtNanoseconds;
+#endif
+                    } catch (...) {
+                        _retainedEventCount.fetch_sub(
+                            1, std::memory_order_acq_rel
+                        );
+                        ++_droppedEventCount;
+                        submission.event->__unref();
+                        throw;
+                    }
+                    ++_pendingEventCount;
+                }
 
-                        EventCollection& collections =
-                            method == EventDispatchMethod::Queue
-                                ? _priorityQueues
-                                : _priorityStacks;
+                /*
+                 * Moves published ring and shard submissions into the
+                 * ordinary pending collections. Holding _eventsMutex makes
+                 * the caller the sole ring consumer. Shards are merged one
+                 * at a time, so each producer's Events keep their FIFO order.
+                 */
+                void CollectSubmittedEventsLocked() {
+                    if (_submittedEventCount.load(
+                            std::memory_order_acquire) == 0) {
+                        return;
+                    }
 
-                        collections[
-                            PriorityIndex(priority)
-                        ].push_back(PendingEvent{
-                            event, NextSequence(_nextSequence)
-                        });
+                    for (size_t priorityID = 0;
+                        priorityID < PriorityCount;
+                        ++priorityID) {
+                        EventSubmissionRing* ring =
+                            _submissionRings[priorityID].get();
+                        if (ring == nullptr) {
+                            continue;
+                        }
+
+                        EventSubmissionRing::Submission submission;
+                        while (ring->TryPop(submission)) {
+                            _submittedEventCount.fetch_sub(
+                                1, std::memory_order_acq_rel
+                            );
+                            AcceptSubmissionLocked(submission, priorityID);
+                        }
+                    }
 
-                        ++_pendingEventCount;
-                        _peakPendingEventCount = std::max(
-                            _peakPendingEventCount,
-                            RetainedEventCountLocked()
+                    for (size_t shardID = 0;
+                        shardID < _submissionShardCount;
+                        ++shardID) {
+                        SubmissionShard& shard = _submissionShards[shardID];
+                        std::unique_lock<std::mutex> shardLock(
+                            shard.mutex, std::try_to_lock
                         );
-                        accepted = true;
-                    } catch (...) {
-                        event->__unref();
-                        if (displacedEvent != nullptr) {
-                            displacedEvent->__unref();
+                        if (!shardLock.owns_lock()) {
+                            shardLock.lock();
+                            ++shard.contentionCount;
+                        }
+                        while (!shard.submissions.empty()) {
+                            const ShardSubmission submission =
+                                shard.submissions.front();
+                            shard.submissions.pop_front();
+                            _submittedEventCount.fetch_sub(
+                                1, std::memory_order_acq_rel
+                            );
+                            AcceptSubmissionLocked(
+                                submission.submission,
+                                submission.priorityID
+                            );
                         }
-                        throw;
                     }
-                    if (displacedEvent != nullptr) {
-                        displacedEvent->__unref();
+                }
+
+                void RecordSubmittedPeak(size_t retained) noexcept {
+                    size_t peak = _peakSubmittedRetainedCount.load(
+                        std::memory_order_relaxed
+                    );
+                    while (peak < retained &&
+                        !_peakSubmittedRetainedCount.compare_exchange_weak(
+                            peak, retained, std::memory_order_relaxed
+                        )) {
                     }
-                    if (accepted) {
-                        EventAdded();
+                }
+
+                /*
+                 * Appends to the calling thread's shard. Producers on
+                 * different shards never share a lock; only the consumer's
+                 * merge briefly takes each shard lock.
+                 */
+                bool TryPushShardSubmission(
+                    const EventSubmissionRing::Submission& submission,
+                    EventPriority priority
+                ) noexcept {
+                    SubmissionShard& shard = _submissionShards[
+                        std::hash<std::thread::id>()(
+                            std::this_thread::get_id()
+                        ) % _submissionShardCount
+                    ];
+                    std::unique_lock<std::mutex> shardLock(
+                        shard.mutex, std::try_to_lock
+                    );
+                    if (!shardLock.owns_lock()) {
+                        shardLock.lock();
+                        ++shard.contentionCount;
+                    }
+                    try {
+                        shard.submissions.push_back(ShardSubmission{
+                            submission, PriorityIndex(priority)
+                        });
+                    } catch (...) {
+                        return false;
                     }
+                    ++shard.submissionCount;
+                    return true;
                 }
 
-                void ProcessCollection(
-                    EventCollection& collections,
+                /*
+                 * Lock-free or sharded admission. Succeeds only while the
+                 * receiver has spare capacity (and, for LockFree, the
+                 * priority ring has a free cell); otherwise the caller falls
+                 * back to the locked path, which applies the configured
+                 * overflow policy.
+                 */
+                bool TrySubmitEvent(
+                    IEvent* event,
                     EventPriority priority,
                     EventDispatchMethod method,
-                    const std::function<void(
-                        IEvent*, EventDispatchMethod, EventPriority
-                    )>& callback
-                ) {
-                    EventDispatchCollection pending;
-                    const size_t priorityIndex =
-                        PriorityIndex(priority);
+                    uint64_t expiresAtNanoseconds
+                ) noexcept {
+                    const EventSubmissionMode mode =
+                        _submissionMode.load(std::memory_order_acquire);
+                    if (mode == EventSubmissionMode::Locked ||
+                        !_acceptingSubmissions.load(
+                            std::memory_order_acquire)) {
+                        return false;
+                    }
 
-                    {
-                        std::lock_guard<std::mutex> lock(_eventsMutex);
-                        EventDispatchCollection& source =
-                            collections[priorityIndex];
+                    EventSubmissionRing* ring = nullptr;
+                    if (mode == EventSubmissionMode::LockFree) {
+                        ring = _submissionRings[PriorityIndex(priority)].get();
+                        if (ring == nullptr) {
+                            return false;
+                        }
+                    } else if (_submissionShardCount == 0) {
+                        return false;
+                    }
 
-                        if (source.empty()) {
-                            return;
+                    const size_t maximum = _maximumPendingEventCount.load(
+                        std::memory_order_relaxed
+                    );
+                    size_t retained = _retainedEventCount.load(
+                        std::memory_order_relaxed
+                    );
+                    do {
+                        if (maximum > 0 && retained >= maximum) {
+                            return false;
                         }
+                    } while (!_retainedEventCount.compare_exchange_weak(
+                        retained,
+                        retained + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed
+                    ));
 
-                        pending.swap(source);
-                        _pendingEventCount -= pending.size();
-                        _processingEventCount += pending.size();
-                        RecordDrainSizeLocked(pending.size());
+                    _submittedEventCount.fetch_add(
+                        1, std::memory_order_acq_rel
+                    );
+                    EventSubmissionRing::Submission submission{
+                        event, method, expiresAtNanoseconds
+                    };
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    submission.enqueuedAtNanoseconds =
+                        GetDrainTimeNanoseconds();
+#endif
+                    const bool pushed = ring != nullptr
+                        ? ring->TryPush(submission)
+                        : TryPushShardSubmission(submission, priority);
+                    if (!pushed) {
+                        _submittedEventCount.fetch_sub(
+                            1, std::memory_order_acq_rel
+                        );
+                        _retainedEventCount.fetch_sub(
+                            1, std::memory_order_acq_rel
+                        );
+                        _capacityAvailable.notify_one();
+                        return false;
                     }
 
-                    class ProcessingGuard final {
+                    RecordSubmittedPeak(retained + 1);
+                    return true;
+                }
+
+                bool CapacityAvailable() const noexcept {
+                    const size_t maximum = _maximumPendingEventCount.load(
+                        std::memory_order_relaxed
+                    );
+                    return maximum == 0 ||
+                        _retainedEventCount.load(
+                            std::memory_order_acquire
+                        ) < maximum;
+                }
+
+                /*
+                 * Bounded spin then yield, outside the receiver lock. Returns
+                 * true if capacity appeared, in which case the caller
+                 * re-checks under the lock instead of parking.
+                 */
+                bool SpinForCapacityLocked(
+                    std::unique_lock<std::mutex>& lock
+                ) {
+                    EventBackpressurePolicy policy = _backpressurePolicy;
+                    static const bool singleCore =
+                        std::thread::hardware_concurrency() == 1;
+                    if (singleCore) {
+                        policy.SpinCount = 0;
+                    }
+                    if (policy.SpinCount == 0 && policy.YieldCount == 0) {
+                        return false;
+                    }
+                    lock.unlock();
+                    bool available = false;
+                    for (size_t spin = 0;
+                        !available && spin < policy.SpinCount; ++spin) {
+                        available = CapacityAvailable();
+                    }
+                    for (size_t yield = 0;
+                        !available && yield < policy.YieldCount; ++yield) {
+                        std::this_thread::yield();
+                        available = CapacityAvailable();
+                    }
+                    lock.lock();
+                    return available;
+                }
+
+                /*
+                 * Number of parked producers to wake now that the retained
+                 * count is `retained`: none above the low watermark, then
+                 * one per free slot.
+                 */
+                size_t ProducerWakeCountLocked(size_t retained) const {
+                    const size_t maximum = _maximumPendingEventCount;
+                    // A producer may be parked on one full collection.
+                    if (_parkedProducerCount == 0 || maximum == 0 ||
+                        CollectionsLimitedLocked()) {
+                        return _parkedProducerCount;
+                    }
+                    const size_t lowWatermark =
+                        _backpressurePolicy.LowWatermark == 0 ||
+                            _backpressurePolicy.LowWatermark >= maximum
+                            ? maximum - 1
+                            : _backpressurePolicy.LowWatermark;
+                    if (retained > lowWatermark) {
+                        return 0;
+                    }
+                    return std::min(_parkedProducerCount, maximum - retained);
+                }
+
+                /*
+                 * Applies the overflow policy until there is room for one more
+                 * Event in collectionID. Returns false when the Event must be
+                 * rejected. A displaced Event, if any, is handed back for the
+                 * caller to release outside the lock. beforeWait runs before
+                 * a BlockProducer wait and may temporarily release the lock.
+                 * When only the collection is full, the drop policies
+                 * displace its own oldest Event.
+                 */
+                template<typename TBeforeWait>
+                bool ReserveCapacityLocked(
+                    std::unique_lock<std::mutex>& lock,
+                    IEvent*& displacedEvent,
+                    TBeforeWait&& beforeWait,
+                    size_t collectionID
+                ) {
+                    if (!_acceptingPendingEvents) {
+                        ++_rejectedEventCount;
+                        return false;
+                    }
+
+                    class BlockedTime final {
                         private:
                             EventReceiver& _receiver;
-                            size_t _count;
+                            uint64_t _since = 0;
+                            bool _blocked = false;
                         public:
-                            ProcessingGuard(EventReceiver& receiver, size_t count)
-                                : _receiver(receiver), _count(count) { }
-                            ~ProcessingGuard() {
-                                {
-                                    std::lock_guard<std::mutex> lock(
-                                        _receiver._eventsMutex);
-                                    _receiver._processingEventCount -= _count;
+                            bool spun = false;
+                            explicit BlockedTime(EventReceiver& receiver)
+                                : _receiver(receiver) { }
+                            void Begin() {
+                                if (!_blocked) {
+                                    _blocked = true;
+                                    _since = _receiver.GetDrainTimeNanoseconds();
+                                    ++_receiver._backpressureStatistics
+                                        .BlockedProducerCount;
                                 }
-                                _receiver._capacityAvailable.notify_all();
                             }
-                    } processing(*this, pending.size());
-
-                    class PendingReferences final {
-                        private:
-                            EventDispatchCollection& _events;
-                        public:
-                            explicit PendingReferences(
-                                EventDispatchCollection& events
-                            ) : _events(events) { }
-                            ~PendingReferences() {
-                                for (PendingEvent& pending : _events) {
-                                    if (pending.event != nullptr) {
-                                        pending.event->__unref();
-                                    }
+                            // Runs with the receiver lock held.
+                            ~BlockedTime() {
+                                if (!_blocked) {
+                                    return;
                                 }
+                                const uint64_t now =
+                                    _receiver.GetDrainTimeNanoseconds();
+                                const uint64_t elapsed =
+                                    now > _since ? now - _since : 0;
+                                EventBackpressureStatistics& statistics =
+                                    _receiver._backpressureStatistics;
+                                statistics.TotalBlockedNanoseconds += elapsed;
+                                statistics.MaximumBlockedNanoseconds = std::max(
+                                    statistics.MaximumBlockedNanoseconds,
+                                    elapsed
+                                );
                             }
-                            void Release(size_t index) {
-                                _events[index].event->__unref();
-                                _events[index].event = nullptr;
-                            }
-                    } references(pending);
+                    } blocked(*this);
 
-                    if (method == EventDispatchMethod::Stack) {
-                        for (size_t index = pending.size(); index > 0; --index) {
-                            const size_t current = index - 1;
-                            callback(pending[current].event, method, priority);
-                            references.Release(current);
+                    auto full = [&]() {
+                        return (_maximumPendingEventCount > 0 &&
+                            RetainedEventCountLocked() >=
+                                _maximumPendingEventCount) ||
+                            CollectionFullLocked(collectionID);
+                    };
+
+                    while (full()) {
+                        if (!_acceptingPendingEvents) {
+                            ++_rejectedEventCount;
+                            return false;
+                        }
+                        switch (_overflowPolicy) {
+                            case EventQueueOverflowPolicy::BlockProducer:
+                                beforeWait();
+                                blocked.Begin();
+                                if (!blocked.spun) {
+                                    blocked.spun = true;
+                                    if (SpinForCapacityLocked(lock)) {
+                                        continue;
+                                    }
+                                    if (!_acceptingPendingEvents || !full()) {
+                                        continue;
+                                    }
+                                }
+                                ++_backpressureStatistics.ParkedProducerCount;
+                                ++_parkedProducerCount;
+                                _capacityAvailable.wait(lock, [&]() {
+                                    return !full() ||
+                                        !_acceptingPendingEvents ||
+                                        _overflowPolicy !=
+                                            EventQueueOverflowPolicy::
+                                                BlockProducer;
+                                });
+                                --_parkedProducerCount;
+                                continue;
+                            case EventQueueOverflowPolicy::RejectIncoming:
+                                ++_rejectedEventCount;
+                                return false;
+                            case EventQueueOverflowPolicy::DropOldest:
+                                displacedEvent =
+                                    CollectionFullLocked(collectionID)
+                                        ? RemoveFrontLocked(
+                                            CollectionLocked(collectionID)
+                                          ).event
+                                        : RemoveOldestLocked().event;
+                                if (displacedEvent == nullptr) {
+                                    ++_rejectedEventCount;
+                                    return false;
+                                }
+                                ++_droppedEventCount;
+                                return true;
+                            case EventQueueOverflowPolicy::
+                                DropLowestPriority: {
+                                bool removed = false;
+                                PendingEvent displaced;
+                                if (CollectionFullLocked(collectionID)) {
+                                    displaced = RemoveFrontLocked(
+                                        CollectionLocked(collectionID)
+                                    );
+                                    removed = displaced.event != nullptr;
+                                } else {
+                                    displaced =
+                                        RemoveLowestPriorityLocked(removed);
+                                }
+                                if (!removed) {
+                                    ++_rejectedEventCount;
+                                    return false;
+                                }
+                                displacedEvent = displaced.event;
+                                ++_droppedEventCount;
+                                return true;
+                            }
+                        }
+                    }
+                    return true;
+                }
+
+                void InsertPendingEventLocked(
+                    IEvent* event,
+                    EventPriority priority,
+                    EventDispatchMethod method,
+                    uint64_t expiresAtNanoseconds,
+                    bool coalescing,
+                    uint64_t coalescingKey
+                ) {
+                    const size_t collectionID =
+                        CollectionID(method, PriorityIndex(priority));
+                    EventDispatchCollection& collection =
+                        CollectionLocked(collectionID);
+
+                    collection.push_back(PendingEvent{
+                        event,
+                        NextSequence(_nextSequence),
+                        expiresAtNanoseconds,
+                        coalescing,
+                        coalescingKey
+                    });
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    collection.back().enqueuedAtNanoseconds =
+                        GetDrainTimeNanoseconds();
+#endif
+                    IndexPendingEventLocked(
+                        collectionID, collection, collection.size() - 1
+                    );
+
+                    ++_pendingEventCount;
+                    _retainedEventCount.fetch_add(
+                        1, std::memory_order_acq_rel
+                    );
+                    _peakPendingEventCount = std::max(
+                        _peakPendingEventCount,
+                        RetainedEventCountLocked()
+                    );
+                }
+
+                std::unique_lock<std::mutex> LockForSubmission() {
+                    std::unique_lock<std::mutex> lock(
+                        _eventsMutex, std::try_to_lock
+                    );
+                    if (!lock.owns_lock()) {
+                        lock.lock();
+                        ++_lockedContentionCount;
+                    }
+                    ++_lockedSubmissionCount;
+                    return lock;
+                }
+
+                void AddEvent(
+                    IEvent* event,
+                    EventPriority priority,
+                    EventDispatchMethod method
+                ) {
+                    event->__dispatch();
+                    event->__ref();
+                    const uint64_t expiresAtNanoseconds =
+                        ExpiryNanoseconds(event);
+                    uint64_t coalescingKey = 0;
+                    const bool coalescing =
+                        _coalescingPolicy.load(std::memory_order_acquire) ==
+                            EventCoalescingPolicy::LatestValueWins &&
+                        event->GetCoalescingKey(coalescingKey);
+                    if (!coalescing && TrySubmitEvent(
+                            event, priority, method, expiresAtNanoseconds)) {
+                        EventAdded();
+                        return;
+                    }
+                    IEvent* displacedEvent = nullptr;
+                    bool coalesced = false;
+                    try {
+                        std::unique_lock<std::mutex> lock =
+                            LockForSubmission();
+                        CollectSubmittedEventsLocked();
+                        coalesced = coalescing && CoalescePendingEventLocked(
+                            event,
+                            coalescingKey,
+                            expiresAtNanoseconds,
+                            CollectionID(method, PriorityIndex(priority)),
+                            displacedEvent
+                        );
+                        if (!coalesced) {
+                            if (!ReserveCapacityLocked(
+                                    lock, displacedEvent, []() { },
+                                    CollectionID(
+                                        method, PriorityIndex(priority)
+                                    ))) {
+                                lock.unlock();
+                                event->__unref();
+                                return;
+                            }
+                            InsertPendingEventLocked(
+                                event, priority, method,
+                                expiresAtNanoseconds,
+                                coalescing, coalescingKey
+                            );
+                        }
+                    } catch (...) {
+                        event->__unref();
+                        if (displacedEvent != nullptr) {
+                            displacedEvent->__unref();
+                        }
+                        throw;
+                    }
+                    if (displacedEvent != nullptr) {
+                        displacedEvent->__unref();
+                    }
+                    // A replaced entry was already signalled when first added.
+                    if (!coalesced) {
+                        EventAdded();
+                    }
+                }
+
+                /*
+                 * Batch form of AddEvent: one lock acquisition and one
+                 * EventAdded() wake-up for the whole span. Rejected and
+                 * displaced Events are released in small fixed-size chunks
+                 * outside the lock, so a batch never allocates. Before a
+                 * BlockProducer wait the consumer is woken for the Events
+                 * already admitted, otherwise it could never free capacity.
+                 */
+                void AddEvents(
+                    EventSpan events,
+                    EventPriority priority,
+                    EventDispatchMethod method
+                ) {
+                    size_t index = 0;
+                    try {
+                        for (; index < events.size(); ++index) {
+                            if (events[index] != nullptr) {
+                                events[index]->__dispatch();
+                                events[index]->__ref();
+                            }
+                        }
+                    } catch (...) {
+                        for (size_t referenced = 0;
+                            referenced < index; ++referenced) {
+                            if (events[referenced] != nullptr) {
+                                events[referenced]->__unref();
+                            }
+                        }
+                        throw;
+                    }
+
+                    std::array<IEvent*, BatchReleaseChunkSize> released{};
+                    size_t releasedCount = 0;
+                    bool wakePending = false;
+                    auto releaseChunk = [&]() noexcept {
+                        for (size_t chunk = 0;
+                            chunk < releasedCount; ++chunk) {
+                            released[chunk]->__unref();
+                        }
+                        releasedCount = 0;
+                    };
+
+                    const EventCoalescingPolicy coalescingPolicy =
+                        _coalescingPolicy.load(std::memory_order_acquire);
+                    const size_t collectionID =
+                        CollectionID(method, PriorityIndex(priority));
+                    index = 0;
+                    try {
+                        std::unique_lock<std::mutex> lock =
+                            LockForSubmission();
+                        CollectSubmittedEventsLocked();
+                        auto flush = [&]() {
+                            if (releasedCount == 0 && !wakePending) {
+                                return;
+                            }
+                            lock.unlock();
+                            releaseChunk();
+                            if (wakePending) {
+                                wakePending = false;
+                                EventAdded();
+                            }
+                            lock.lock();
+                        };
+
+                        for (; index < events.size(); ++index) {
+                            IEvent* event = events[index];
+                            if (event == nullptr) {
+                                continue;
+                            }
+                            if (releasedCount == released.size()) {
+                                flush();
+                            }
+                            IEvent* displacedEvent = nullptr;
+                            const uint64_t expiresAtNanoseconds =
+                                ExpiryNanoseconds(event);
+                            uint64_t coalescingKey = 0;
+                            const bool coalescing =
+                                coalescingPolicy ==
+                                    EventCoalescingPolicy::LatestValueWins &&
+                                event->GetCoalescingKey(coalescingKey);
+                            if (coalescing && CoalescePendingEventLocked(
+                                    event, coalescingKey,
+                                    expiresAtNanoseconds, collectionID,
+                                    displacedEvent)) {
+                                released[releasedCount++] = displacedEvent;
+                                continue;
+                            }
+                            if (!ReserveCapacityLocked(
+                                    lock, displacedEvent, flush,
+                                    collectionID)) {
+                                released[releasedCount++] = event;
+                                continue;
+                            }
+                            if (displacedEvent != nullptr) {
+                                released[releasedCount++] = displacedEvent;
+                            }
+                            InsertPendingEventLocked(
+                                event, priority, method,
+                                expiresAtNanoseconds,
+                                coalescing, coalescingKey
+                            );
+                            wakePending = true;
+                        }
+                    } catch (...) {
+                        for (; index < events.size(); ++index) {
+                            if (events[index] != nullptr) {
+                                events[index]->__unref();
+                            }
+                        }
+                        releaseChunk();
+                        throw;
+                    }
+
+                    releaseChunk();
+                    if (wakePending) {
+                        EventAdded();
+                    }
+                }
+
+                struct DrainState {
+                    size_t remainingEventCount =
+                        std::numeric_limits<size_t>::max();
+                    uint64_t deadlineNanoseconds = 0;
+                    size_t processedEventCount = 0;
+                    size_t expiredEventCount = 0;
+                    bool budgetSpent = false;
+                    bool deadlinePassed = false;
+                    bool budgetExhausted = false;
+                };
+
+                uint64_t GetDrainTimeNanoseconds() const {
+                    Timing::ISystemClock<EventTime>* clock =
+                        _drainClock.load(std::memory_order_acquire);
+                    if (clock == nullptr) {
+                        clock = &EventClock::Get();
+                    }
+                    return Timing::TimeTraits<EventTime>::template
+                        ToNanoseconds<uint64_t>(clock->GetTime());
+                }
+
+                bool DrainDeadlinePassed(const DrainState& drain) const {
+                    return drain.deadlineNanoseconds != 0 &&
+                        GetDrainTimeNanoseconds() >= drain.deadlineNanoseconds;
+                }
+
+                /*
+                 * Consumes one unit of drain budget. Returns true once either
+                 * quota is spent. The clock is only read here, after an Event
+                 * has been processed, so empty collections cost nothing.
+                 */
+                bool ConsumeDrainBudget(DrainState& drain) const {
+                    ++drain.processedEventCount;
+                    if (drain.remainingEventCount !=
+                        std::numeric_limits<size_t>::max()) {
+                        --drain.remainingEventCount;
+                    }
+                    drain.deadlinePassed = DrainDeadlinePassed(drain);
+                    drain.budgetSpent =
+                        drain.remainingEventCount == 0 ||
+                        drain.deadlinePassed;
+                    return drain.budgetSpent;
+                }
+
+                /*
+                 * A static receiver's pass over one collection. The first
+                 * chunk fixes the pass: its count quota and, for a stack,
+                 * the newest sequence taken.
+                 */
+                struct StaticDrainState {
+                    bool started = false;
+                    size_t remaining = 0;
+                    uint64_t newestSequence = 0;
+                };
+
+                /*
+                 * Fixed storage stays with its collection, so a static
+                 * receiver drains it in place: each chunk of the pass is
+                 * moved into chunk, which lives on the draining thread's
+                 * stack. Concurrent and nested drains therefore share no
+                 * scratch. Events stacked by the callbacks are left for the
+                 * next pass, as with heap storage. Returns false once the
+                 * pass has nothing left to take.
+                 */
+                bool TakeStaticChunkLocked(
+                    EventDispatchCollection& source,
+                    size_t collectionID,
+                    EventDispatchMethod method,
+                    DrainState& drain,
+                    StaticDrainState& fixed,
+                    PendingEvent* chunk,
+                    EventDispatchCollection& pending
+                ) {
+                    if (!fixed.started) {
+                        fixed.started = true;
+                        fixed.remaining = std::min(
+                            source.size(), drain.remainingEventCount
+                        );
+                        fixed.newestSequence = source.back().sequence;
+                        if (fixed.remaining < source.size()) {
+                            drain.budgetExhausted = true;
+                        }
+                        RecordDrainSizeLocked(fixed.remaining);
+                    }
+
+                    size_t available = source.size();
+                    if (method == EventDispatchMethod::Stack) {
+                        while (available > 0 &&
+                            source[available - 1].sequence >
+                                fixed.newestSequence) {
+                            --available;
+                        }
+                    }
+                    const size_t take = std::min(
+                        std::min(available, fixed.remaining),
+                        StaticDrainChunkSize
+                    );
+                    if (take == 0) {
+                        fixed.remaining = 0;
+                        return false;
+                    }
+                    fixed.remaining -= take;
+                    _staticTakenCounts[collectionID] += take;
+
+                    pending.use_storage(chunk, StaticDrainChunkSize);
+                    if (method == EventDispatchMethod::Queue) {
+                        for (size_t index = 0; index < take; ++index) {
+                            pending.push_back(source.front());
+                            source.pop_front();
+                        }
+                        return true;
+                    }
+
+                    // Rotate any arrivals ahead of the Events taken.
+                    const size_t arrivalCount = source.size() - available;
+                    if (arrivalCount > 0) {
+                        const size_t first = available - take;
+                        ReverseCollection(source, first, available);
+                        ReverseCollection(source, available, source.size());
+                        ReverseCollection(source, first, source.size());
+                    }
+                    for (size_t index = source.size() - take;
+                        index < source.size(); ++index) {
+                        pending.push_back(source[index]);
+                    }
+                    for (size_t index = 0; index < take; ++index) {
+                        source.pop_back();
+                    }
+                    IndexPendingEventsLocked(
+                        collectionID,
+                        source,
+                        source.size() - arrivalCount,
+                        source.size()
+                    );
+                    return true;
+                }
+
+                template<typename TCallback>
+                void ProcessCollection(
+                    EventCollection& collections,
+                    EventPriority priority,
+                    EventDispatchMethod method,
+                    TCallback& callback,
+                    DrainState& drain
+                ) {
+                    StaticDrainState fixed;
+                    while (ProcessCollectionChunk(
+                        collections, priority, method, callback, drain, fixed
+                    )) {
+                    }
+                }
+
+                /*
+                 * Takes and processes Events of one collection. Heap storage
+                 * is taken in one go; fixed storage a chunk at a time, and
+                 * true is returned while its pass has Events left.
+                 */
+                template<typename TCallback>
+                bool ProcessCollectionChunk(
+                    EventCollection& collections,
+                    EventPriority priority,
+                    EventDispatchMethod method,
+                    TCallback& callback,
+                    DrainState& drain,
+                    StaticDrainState& fixed
+                ) {
+                    if (drain.budgetExhausted && !fixed.started) {
+                        return false;
+                    }
+
+                    EventDispatchCollection pending;
+                    PendingEvent chunk[StaticDrainChunkSize];
+                    const size_t priorityIndex =
+                        PriorityIndex(priority);
+                    const size_t collectionID =
+                        CollectionID(method, priorityIndex);
+                    bool wholeCollection = true;
+
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        CollectSubmittedEventsLocked();
+                        EventDispatchCollection& source =
+                            collections[priorityIndex];
+
+                        if (source.empty()) {
+                            return false;
+                        }
+
+                        if (drain.budgetSpent) {
+                            drain.budgetExhausted = true;
+                            return false;
+                        }
+
+                        /*
+                         * A count quota takes only the Events this pass may
+                         * process: the oldest for a queue, the newest for a
+                         * stack. The rest stay in place for the next pass.
+                         */
+                        const size_t take = std::min(
+                            source.size(), drain.remainingEventCount
+                        );
+                        if (source.fixed_storage()) {
+                            wholeCollection = false;
+                            if (!TakeStaticChunkLocked(
+                                source, collectionID, method,
+                                drain, fixed, chunk, pending
+                            )) {
+                                return false;
+                            }
+                        } else if (take == source.size()) {
+                            pending.swap(source);
+                            RecordDrainSizeLocked(take);
+                        } else {
+                            wholeCollection = false;
+                            drain.budgetExhausted = true;
+                            RecordDrainSizeLocked(take);
+                            pending.reserve(take);
+                            if (method == EventDispatchMethod::Queue) {
+                                for (size_t index = 0; index < take; ++index) {
+                                    pending.push_back(source.front());
+                                    source.pop_front();
+                                }
+                            } else {
+                                for (size_t index = source.size() - take;
+                                    index < source.size(); ++index) {
+                                    pending.push_back(source[index]);
+                                }
+                                for (size_t index = 0; index < take; ++index) {
+                                    source.pop_back();
+                                }
+                            }
+                        }
+
+                        if (!_coalescingIndex.empty()) {
+                            for (size_t index = 0;
+                                index < pending.size(); ++index) {
+                                ForgetPendingEventLocked(pending[index]);
+                            }
+                        }
+                        _pendingEventCount -= pending.size();
+                    }
+
+                    class ProcessingGuard final {
+                        private:
+                            EventReceiver& _receiver;
+                            size_t _count;
+                            size_t* _taken;
+                            size_t _takenCount;
+                        public:
+                            ProcessingGuard(
+                                EventReceiver& receiver,
+                                size_t count,
+                                size_t* taken
+                            ) : _receiver(receiver), _count(count),
+                                _taken(taken), _takenCount(count) { }
+                            void Restore(size_t count) {
+                                _count -= count;
+                            }
+                            // Returns a static chunk's entries; lock held.
+                            void ReleaseTakenLocked() {
+                                if (_taken != nullptr) {
+                                    *_taken -= _takenCount;
+                                    _taken = nullptr;
+                                }
+                            }
+                            ~ProcessingGuard() {
+                                size_t wakeCount = 0;
+                                {
+                                    std::lock_guard<std::mutex> lock(
+                                        _receiver._eventsMutex);
+                                    ReleaseTakenLocked();
+                                    const size_t retained =
+                                        _receiver._retainedEventCount.fetch_sub(
+                                            _count, std::memory_order_acq_rel
+                                        ) - _count;
+                                    wakeCount =
+                                        _receiver.ProducerWakeCountLocked(
+                                            retained
+                                        );
+                                }
+                                for (; wakeCount > 0; --wakeCount) {
+                                    _receiver._capacityAvailable.notify_one();
+                                }
+                            }
+                    } processing(
+                        *this,
+                        pending.size(),
+                        fixed.started
+                            ? &_staticTakenCounts[collectionID]
+                            : nullptr
+                    );
+
+                    class PendingReferences final {
+                        private:
+                            EventDispatchCollection& _events;
+                        public:
+                            explicit PendingReferences(
+                                EventDispatchCollection& events
+                            ) : _events(events) { }
+                            ~PendingReferences() {
+                                for (size_t index = 0;
+                                    index < _events.size(); ++index) {
+                                    if (_events[index].event != nullptr) {
+                                        _events[index].event->__unref();
+                                    }
+                                }
+                            }
+                            void Release(size_t index) {
+                                _events[index].event->__unref();
+                                _events[index].event = nullptr;
+                            }
+                    } references(pending);
+
+                    /*
+                     * Expired Events are released without a callback and do
+                     * not consume drain budget. The clock is read at most
+                     * once per collection, and only if an Event has a TTL.
+                     */
+                    uint64_t nowNanoseconds = 0;
+                    bool nowRead = false;
+                    auto expire = [&](size_t index) {
+                        const uint64_t expiresAt =
+                            pending[index].expiresAtNanoseconds;
+                        if (expiresAt == 0) {
+                            return false;
+                        }
+                        if (!nowRead) {
+                            nowNanoseconds = GetDrainTimeNanoseconds();
+                            nowRead = true;
+                        }
+                        if (nowNanoseconds < expiresAt) {
+                            return false;
+                        }
+                        references.Release(index);
+                        ++drain.expiredEventCount;
+                        return true;
+                    };
+
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    EventLatencyHistogram<uint32_t> latencies;
+                    auto recordLatency = [&](size_t index) {
+                        const uint64_t now = GetDrainTimeNanoseconds();
+                        const uint64_t enqueuedAt =
+                            pending[index].enqueuedAtNanoseconds;
+                        latencies.Record(
+                            now > enqueuedAt ? now - enqueuedAt : 0
+                        );
+                    };
+#else
+                    auto recordLatency = [](size_t) { };
+#endif
+
+                    size_t unprocessedBegin = 0;
+                    size_t unprocessedEnd = 0;
+                    if (method == EventDispatchMethod::Stack) {
+                        for (size_t index = pending.size(); index > 0; --index) {
+                            const size_t current = index - 1;
+                            if (expire(current)) {
+                                continue;
+                            }
+                            recordLatency(current);
+                            callback(pending[current].event, method, priority);
+                            references.Release(current);
+                            if (ConsumeDrainBudget(drain) && current > 0) {
+                                unprocessedEnd = current;
+                                break;
+                            }
                         }
                     } else {
                         for (size_t index = 0; index < pending.size(); ++index) {
+                            if (expire(index)) {
+                                continue;
+                            }
+                            recordLatency(index);
                             callback(pending[index].event, method, priority);
                             references.Release(index);
+                            if (ConsumeDrainBudget(drain) &&
+                                index + 1 < pending.size()) {
+                                unprocessedBegin = index + 1;
+                                unprocessedEnd = pending.size();
+                                break;
+                            }
                         }
                     }
 
-                    pending.clear();
                     std::lock_guard<std::mutex> lock(_eventsMutex);
+                    processing.ReleaseTakenLocked();
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    _latencyHistograms[collectionID].Merge(latencies);
+#endif
                     EventDispatchCollection& destination =
                         collections[priorityIndex];
-                    if (pending.capacity() > destination.capacity()) {
-                        EventDispatchCollection arrivals;
-                        arrivals.swap(destination);
-                        pending.swap(destination);
-                        destination.insert(
-                            destination.end(),
-                            std::make_move_iterator(arrivals.begin()),
-                            std::make_move_iterator(arrivals.end())
-                        );
-                    }
-                    ApplyCapacityPolicyLocked(destination);
-                }
+                    const size_t unprocessed =
+                        unprocessedEnd - unprocessedBegin;
 
-            protected:
-                void StopAcceptingEvents() noexcept {
-                    {
-                        std::lock_guard<std::mutex> lock(_eventsMutex);
-                        _acceptingPendingEvents = false;
+                    if (unprocessed > 0) {
+                        /*
+                         * Budget ran out mid-collection. Return the remainder
+                         * in sequence order: ahead of arrivals for a queue,
+                         * and between the retained older entries and any
+                         * newer arrivals for a stack.
+                         */
+                        drain.budgetExhausted = true;
+                        destination.reserve(destination.size() + unprocessed);
+                        if (method == EventDispatchMethod::Queue) {
+                            for (size_t index = unprocessedEnd;
+                                index > unprocessedBegin; --index) {
+                                destination.push_front(pending[index - 1]);
+                                pending[index - 1].event = nullptr;
+                            }
+                            IndexPendingEventsLocked(
+                                collectionID, destination, 0, unprocessed
+                            );
+                        } else {
+                            const uint64_t newestTaken =
+                                pending.back().sequence;
+                            size_t arrivalCount = 0;
+                            while (arrivalCount < destination.size() &&
+                                destination[
+                                    destination.size() - arrivalCount - 1
+                                ].sequence > newestTaken) {
+                                ++arrivalCount;
+                            }
+                            for (size_t index = unprocessedBegin;
+                                index < unprocessedEnd; ++index) {
+                                destination.push_back(pending[index]);
+                                pending[index].event = nullptr;
+                            }
+                            // Rotate the arrivals back behind the remainder.
+                            const size_t first = destination.size() -
+                                unprocessed - arrivalCount;
+                            ReverseCollection(
+                                destination, first, first + arrivalCount
+                            );
+                            ReverseCollection(
+                                destination,
+                                first + arrivalCount,
+                                destination.size()
+                            );
+                            ReverseCollection(
+                                destination, first, destination.size()
+                            );
+                            IndexPendingEventsLocked(
+                                collectionID,
+                                destination,
+                                first,
+                                destination.size()
+                            );
+                        }
+                        _pendingEventCount += unprocessed;
+                        processing.Restore(unprocessed);
+                    } else if (wholeCollection) {
+                        pending.clear();
+                        if (pending.capacity() > destination.capacity()) {
+                            EventDispatchCollection arrivals;
+                            arrivals.swap(destination);
+                            pending.swap(destination);
+                            for (size_t index = 0;
+                                index < arrivals.size(); ++index) {
+                                destination.push_back(arrivals[index]);
+                            }
+                            IndexPendingEventsLocked(
+                                collectionID, destination,
+                                0, destination.size()
+                            );
+                        }
                     }
-                    _capacityAvailable.notify_all();
+                    ApplyCapacityPolicyLocked(destination);
+                    return fixed.started && fixed.remaining > 0 &&
+                        unprocessed == 0;
                 }
 
-                void WithEvents(
-                    std::function<void(
-                        IEvent*, EventDispatchMethod, EventPriority
-                    )> callback
+                template<typename TCallback>
+                void DrainStrictPriority(
+                    TCallback& callback,
+                    DrainState& drain
                 ) {
                     for (int priorityID =
                             static_cast<int>(EventPriority::High);
@@ -450,7 +1807,8 @@ namespace ESPressio {
                             _priorityStacks,
                             static_cast<EventPriority>(priorityID),
                             EventDispatchMethod::Stack,
-                            callback
+                            callback,
+                            drain
                         );
                     }
                     for (int priorityID =
@@ -460,25 +1818,399 @@ namespace ESPressio {
                             _priorityQueues,
                             static_cast<EventPriority>(priorityID),
                             EventDispatchMethod::Queue,
-                            callback
+                            callback,
+                            drain
+                        );
+                    }
+                }
+
+                /*
+                 * Deficit round-robin across priorities. Each visit grants a
+                 * priority its weight in Events (stacks before queues within
+                 * the priority), then moves on High -> Normal -> Low -> High.
+                 * Collections are re-examined on every visit, so a High Event
+                 * waits for at most the Normal and Low quanta rather than the
+                 * rest of the pass. Deficits and the round-robin cursor persist
+                 * across passes so budget-limited drains remain fair.
+                 *
+                 * A pass is bounded by the number of Events pending when it
+                 * started, mirroring the snapshot semantics of strict priority.
+                 */
+                template<typename TCallback>
+                void DrainWeightedRoundRobin(
+                    TCallback& callback,
+                    DrainState& drain
+                ) {
+                    std::array<size_t, PriorityCount> weights;
+                    std::array<size_t, PriorityCount> deficits;
+                    size_t cursor;
+                    size_t passLimit;
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        CollectSubmittedEventsLocked();
+                        weights = _priorityWeights;
+                        deficits = _schedulingDeficits;
+                        cursor = _schedulingCursor;
+                        passLimit = _pendingEventCount;
+                    }
+
+                    size_t idleVisits = 0;
+                    while (!drain.budgetSpent &&
+                        drain.processedEventCount < passLimit &&
+                        idleVisits < PriorityCount) {
+                        if (deficits[cursor] == 0) {
+                            deficits[cursor] = weights[cursor];
+                        }
+
+                        DrainState slice;
+                        slice.remainingEventCount = std::min(
+                            deficits[cursor], drain.remainingEventCount
+                        );
+                        slice.deadlineNanoseconds = drain.deadlineNanoseconds;
+                        const EventPriority priority =
+                            static_cast<EventPriority>(cursor);
+                        ProcessCollection(
+                            _priorityStacks, priority,
+                            EventDispatchMethod::Stack, callback, slice
+                        );
+                        ProcessCollection(
+                            _priorityQueues, priority,
+                            EventDispatchMethod::Queue, callback, slice
+                        );
+
+                        drain.processedEventCount += slice.processedEventCount;
+                        drain.expiredEventCount += slice.expiredEventCount;
+                        if (drain.remainingEventCount !=
+                            std::numeric_limits<size_t>::max()) {
+                            drain.remainingEventCount -=
+                                slice.processedEventCount;
+                        }
+                        deficits[cursor] -= slice.processedEventCount;
+                        if (!slice.budgetExhausted) {
+                            deficits[cursor] = 0;
+                        }
+                        if (slice.deadlinePassed ||
+                            drain.remainingEventCount == 0) {
+                            drain.budgetSpent = true;
+                            drain.budgetExhausted = slice.budgetExhausted;
+                        }
+
+                        idleVisits = slice.processedEventCount == 0
+                            ? idleVisits + 1
+                            : 0;
+                        if (deficits[cursor] == 0) {
+                            cursor = cursor == 0
+                                ? PriorityCount - 1
+                                : cursor - 1;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _schedulingDeficits = deficits;
+                    _schedulingCursor = cursor;
+                    if (drain.budgetSpent && !drain.budgetExhausted) {
+                        drain.budgetExhausted =
+                            _pendingEventCount > 0 ||
+                            _submittedEventCount.load(
+                                std::memory_order_acquire
+                            ) > 0;
+                    }
+                }
+
+                /*
+                 * Drains pending Events until the collections are empty or
+                 * the budget is spent. Events left over stay queued in their
+                 * original order and are processed by the next pass.
+                 */
+                template<typename TCallback>
+                EventDrainResult DrainPendingEvents(
+                    TCallback& callback,
+                    const EventDrainBudget& budget
+                ) {
+                    DrainState drain;
+                    const uint64_t startNanoseconds = GetDrainTimeNanoseconds();
+                    if (budget.MaximumEventCount > 0) {
+                        drain.remainingEventCount = budget.MaximumEventCount;
+                    }
+                    if (budget.MaximumDurationNanoseconds > 0) {
+                        drain.deadlineNanoseconds =
+                            startNanoseconds + budget.MaximumDurationNanoseconds;
+                    }
+
+                    EventSchedulingPolicy schedulingPolicy;
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        schedulingPolicy = _schedulingPolicy;
+                    }
+                    if (schedulingPolicy ==
+                        EventSchedulingPolicy::WeightedRoundRobin) {
+                        DrainWeightedRoundRobin(callback, drain);
+                    } else {
+                        DrainStrictPriority(callback, drain);
+                    }
+
+                    const uint64_t endNanoseconds = GetDrainTimeNanoseconds();
+                    EventDrainResult result;
+                    result.ProcessedEventCount = drain.processedEventCount;
+                    result.ExpiredEventCount = drain.expiredEventCount;
+                    result.BudgetExhausted = drain.budgetExhausted;
+                    result.ElapsedNanoseconds =
+                        endNanoseconds >= startNanoseconds
+                            ? endNanoseconds - startNanoseconds
+                            : 0;
+
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _expiredEventCount += result.ExpiredEventCount;
+                    ++_drainStatistics.DrainCount;
+                    _drainStatistics.ProcessedEventCount +=
+                        result.ProcessedEventCount;
+                    if (result.BudgetExhausted) {
+                        ++_drainStatistics.BudgetExhaustedCount;
+                    }
+                    _drainStatistics.TotalDrainNanoseconds +=
+                        result.ElapsedNanoseconds;
+                    _drainStatistics.MaximumDrainNanoseconds = std::max(
+                        _drainStatistics.MaximumDrainNanoseconds,
+                        result.ElapsedNanoseconds
+                    );
+                    _drainStatistics.LastProcessedEventCount =
+                        result.ProcessedEventCount;
+                    _drainStatistics.LastDrainNanoseconds =
+                        result.ElapsedNanoseconds;
+                    return result;
+                }
+
+            public:
+                /*
+                 * In-object pending storage for a receiver of at most
+                 * Capacity Events. Each of the six priority/method
+                 * collections gets CollectionCapacity entries, plus Capacity
+                 * Event pointers used while clearing. By default a
+                 * collection may hold every pending Event; a smaller
+                 * CollectionCapacity trades that for RAM, and a collection
+                 * that fills up applies the overflow policy on its own.
+                 * Drains work in place (see TakeStaticChunkLocked). See
+                 * StaticEventReceiver.
+                 */
+                template<size_t Capacity, size_t CollectionCapacity = Capacity>
+                class StaticPendingStorage {
+                    static_assert(
+                        Capacity > 0,
+                        "StaticPendingStorage needs a non-zero Capacity"
+                    );
+                    static_assert(
+                        CollectionCapacity > 0 &&
+                            CollectionCapacity <= Capacity,
+                        "StaticPendingStorage needs a CollectionCapacity "
+                        "between 1 and Capacity"
+                    );
+
+                    private:
+                        friend class EventReceiver;
+
+                        std::array<
+                            PendingEvent,
+                            CollectionCapacity * CollectionCount
+                        > _events{};
+                        std::array<IEvent*, Capacity> _released{};
+
+                    public:
+                        static constexpr size_t PendingEntryCount =
+                            CollectionCapacity * CollectionCount;
+                };
+
+            protected:
+                /*
+                 * Moves all pending storage into storage, which must outlive
+                 * the receiver's destructor (hold it in a base class listed
+                 * before EventReceiver). From then on the pending Event
+                 * maximum is capped at Capacity and pending storage never
+                 * allocates. Returns false, changing nothing, if the receiver
+                 * already uses static storage or has Events retained. With a
+                 * CollectionCapacity below Capacity, submissions always take
+                 * the Locked path, which checks the collection's room.
+                 */
+                template<size_t Capacity, size_t CollectionCapacity>
+                bool UseStaticPendingStorage(
+                    StaticPendingStorage<Capacity, CollectionCapacity>& storage
+                ) {
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        if (_staticCapacity > 0 ||
+                            _retainedEventCount.load(
+                                std::memory_order_acquire) > 0) {
+                            return false;
+                        }
+                        for (size_t collectionID = 0;
+                            collectionID < CollectionCount;
+                            ++collectionID) {
+                            CollectionLocked(collectionID).use_storage(
+                                &storage._events[
+                                    collectionID * CollectionCapacity
+                                ],
+                                CollectionCapacity
+                            );
+                        }
+                        _staticReleaseStorage = storage._released.data();
+                        _staticCapacity = Capacity;
+                        _staticCollectionCapacity = CollectionCapacity;
+                        if (CollectionsLimitedLocked()) {
+                            _submissionMode.store(
+                                EventSubmissionMode::Locked,
+                                std::memory_order_release
+                            );
+                        }
+                        const size_t maximum = _maximumPendingEventCount;
+                        if (maximum == 0 || maximum > Capacity) {
+                            _maximumPendingEventCount = Capacity;
+                        }
+                    }
+                    _capacityAvailable.notify_all();
+                    return true;
+                }
+
+                void StopAcceptingEvents() noexcept {
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        _acceptingPendingEvents = false;
+                        _acceptingSubmissions.store(
+                            false, std::memory_order_release
                         );
                     }
+                    _capacityAvailable.notify_all();
+                }
+
+                /*
+                 * Drains pending Events using the receiver's configured
+                 * EventDrainBudget. Any callable taking (IEvent*,
+                 * EventDispatchMethod, EventPriority) is accepted and
+                 * inlined into the drain loop, so a capturing lambda costs
+                 * neither an allocation nor an indirect call per Event.
+                 */
+                template<typename TCallback>
+                EventDrainResult WithEvents(TCallback&& callback) {
+                    return DrainPendingEvents(callback, GetEventDrainBudget());
+                }
+
+                template<typename TCallback>
+                EventDrainResult WithEvents(
+                    TCallback&& callback,
+                    const EventDrainBudget& budget
+                ) {
+                    return DrainPendingEvents(callback, budget);
+                }
+
+                /*
+                 * std::function overloads, kept for existing callers. Overload
+                 * resolution selects these only for std::function arguments.
+                 */
+                EventDrainResult WithEvents(
+                    std::function<void(
+                        IEvent*, EventDispatchMethod, EventPriority
+                    )> callback
+                ) {
+                    return DrainPendingEvents(callback, GetEventDrainBudget());
+                }
+
+                EventDrainResult WithEvents(
+                    std::function<void(
+                        IEvent*, EventDispatchMethod, EventPriority
+                    )> callback,
+                    const EventDrainBudget& budget
+                ) {
+                    return DrainPendingEvents(callback, budget);
                 }
 
                 void ClearPendingEvents() noexcept {
                     EventCollection queues;
                     EventCollection stacks;
+                    std::vector<IEvent*> submitted;
+                    size_t staticReleaseCount = 0;
                     {
                         std::lock_guard<std::mutex> lock(_eventsMutex);
-                        queues.swap(_priorityQueues);
-                        stacks.swap(_priorityStacks);
+                        if (_staticCapacity > 0) {
+                            /*
+                             * Fixed storage must stay attached, so the
+                             * Events are parked in the release scratch and
+                             * unreferenced outside the lock.
+                             */
+                            for (size_t collectionID = 0;
+                                collectionID < CollectionCount;
+                                ++collectionID) {
+                                EventDispatchCollection& collection =
+                                    CollectionLocked(collectionID);
+                                for (size_t index = 0;
+                                    index < collection.size(); ++index) {
+                                    _staticReleaseStorage[
+                                        staticReleaseCount++
+                                    ] = collection[index].event;
+                                }
+                                collection.clear();
+                            }
+                        } else {
+                            queues.swap(_priorityQueues);
+                            stacks.swap(_priorityStacks);
+                        }
+                        _coalescingIndex.clear();
+                        size_t released = _pendingEventCount;
                         _pendingEventCount = 0;
+                        for (auto& ring : _submissionRings) {
+                            if (ring == nullptr) {
+                                continue;
+                            }
+                            EventSubmissionRing::Submission submission;
+                            while (ring->TryPop(submission)) {
+                                _submittedEventCount.fetch_sub(
+                                    1, std::memory_order_acq_rel
+                                );
+                                ++released;
+                                try {
+                                    submitted.push_back(submission.event);
+                                } catch (...) {
+                                    submission.event->__unref();
+                                }
+                            }
+                        }
+                        for (size_t shardID = 0;
+                            shardID < _submissionShardCount;
+                            ++shardID) {
+                            SubmissionShard& shard =
+                                _submissionShards[shardID];
+                            std::lock_guard<std::mutex> shardLock(
+                                shard.mutex
+                            );
+                            while (!shard.submissions.empty()) {
+                                IEvent* event =
+                                    shard.submissions.front().submission.event;
+                                shard.submissions.pop_front();
+                                _submittedEventCount.fetch_sub(
+                                    1, std::memory_order_acq_rel
+                                );
+                                ++released;
+                                try {
+                                    submitted.push_back(event);
+                                } catch (...) {
+                                    event->__unref();
+                                }
+                            }
+                        }
+                        _retainedEventCount.fetch_sub(
+                            released, std::memory_order_acq_rel
+                        );
                     }
                     _capacityAvailable.notify_all();
+                    for (IEvent* event : submitted) {
+                        event->__unref();
+                    }
+                    for (size_t index = 0;
+                        index < staticReleaseCount; ++index) {
+                        _staticReleaseStorage[index]->__unref();
+                    }
                     auto release = [](EventCollection& collections) {
                         for (auto& collection : collections) {
-                            for (PendingEvent& pending : collection) {
-                                pending.event->__unref();
+                            for (size_t index = 0;
+                                index < collection.size(); ++index) {
+                                collection[index].event->__unref();
                             }
                         }
                     };
@@ -508,13 +2240,110 @@ namespace ESPressio {
                     AddEvent(event, priority, EventDispatchMethod::Stack);
                 }
 
+                void QueueEvents(
+                    EventSpan events,
+                    EventPriority priority = EventPriority::Normal
+                ) override {
+                    AddEvents(events, priority, EventDispatchMethod::Queue);
+                }
+
+                void StackEvents(
+                    EventSpan events,
+                    EventPriority priority = EventPriority::Normal
+                ) override {
+                    AddEvents(events, priority, EventDispatchMethod::Stack);
+                }
+
                 size_t GetMaximumPendingEventCount() const {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
                     return _maximumPendingEventCount;
                 }
+                /*
+                 * Selects how producers hand Events to this receiver. The
+                 * per-priority rings (LockFree) or the shards (Sharded) are
+                 * allocated on the first switch to that mode and retained
+                 * for the receiver's lifetime, so a later capacity is
+                 * ignored. capacity is the ring capacity for LockFree and
+                 * the shard count for Sharded; zero selects the
+                 * ESPRESSIO_EVENT_DEFAULT_SUBMISSION_* default. Neither
+                 * bounds the receiver as a whole: the maximum pending Event
+                 * count still does. Static storage with a limited
+                 * CollectionCapacity stays Locked.
+                 */
+                void SetEventSubmissionMode(
+                    EventSubmissionMode mode,
+                    size_t capacity = 0
+                ) {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    if (CollectionsLimitedLocked()) {
+                        return;
+                    }
+                    if (mode == EventSubmissionMode::LockFree) {
+                        for (auto& ring : _submissionRings) {
+                            if (ring == nullptr) {
+                                ring.reset(new EventSubmissionRing(
+                                    capacity == 0
+                                        ? ESPRESSIO_EVENT_DEFAULT_SUBMISSION_RING_CAPACITY
+                                        : capacity
+                                ));
+                            }
+                        }
+                    } else if (mode == EventSubmissionMode::Sharded &&
+                        _submissionShardCount == 0) {
+                        const size_t shardCount = capacity == 0
+                            ? ESPRESSIO_EVENT_DEFAULT_SUBMISSION_SHARD_COUNT
+                            : capacity;
+                        _submissionShards.reset(
+                            new SubmissionShard[shardCount]
+                        );
+                        _submissionShardCount = shardCount;
+                    }
+                    _submissionMode.store(mode, std::memory_order_release);
+                }
+                EventSubmissionMode GetEventSubmissionMode() const {
+                    return _submissionMode.load(std::memory_order_acquire);
+                }
+                EventSubmissionStatistics GetEventSubmissionStatistics() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    EventSubmissionStatistics statistics;
+                    statistics.LockedSubmissionCount = _lockedSubmissionCount;
+                    statistics.LockedContentionCount = _lockedContentionCount;
+                    for (size_t shardID = 0;
+                        shardID < _submissionShardCount;
+                        ++shardID) {
+                        SubmissionShard& shard = _submissionShards[shardID];
+                        std::lock_guard<std::mutex> shardLock(shard.mutex);
+                        statistics.ShardedSubmissionCount +=
+                            shard.submissionCount;
+                        statistics.ShardContentionCount +=
+                            shard.contentionCount;
+                    }
+                    return statistics;
+                }
+                void ResetEventSubmissionStatistics() {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _lockedSubmissionCount = 0;
+                    _lockedContentionCount = 0;
+                    for (size_t shardID = 0;
+                        shardID < _submissionShardCount;
+                        ++shardID) {
+                        SubmissionShard& shard = _submissionShards[shardID];
+                        std::lock_guard<std::mutex> shardLock(shard.mutex);
+                        shard.submissionCount = 0;
+                        shard.contentionCount = 0;
+                    }
+                }
+                /*
+                 * Zero means unbounded, except on a receiver using static
+                 * storage, where the maximum is capped at its Capacity.
+                 */
                 void SetMaximumPendingEventCount(size_t maximum) {
                     {
                         std::lock_guard<std::mutex> lock(_eventsMutex);
+                        if (_staticCapacity > 0 &&
+                            (maximum == 0 || maximum > _staticCapacity)) {
+                            maximum = _staticCapacity;
+                        }
                         _maximumPendingEventCount = maximum;
                     }
                     _capacityAvailable.notify_all();
@@ -552,11 +2381,57 @@ namespace ESPressio {
                 }
                 size_t GetPendingEventCount() const {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
-                    return _pendingEventCount;
+                    return _pendingEventCount +
+                        _submittedEventCount.load(std::memory_order_acquire);
                 }
                 size_t GetPeakPendingEventCount() const {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
-                    return _peakPendingEventCount;
+                    return std::max(
+                        _peakPendingEventCount,
+                        _peakSubmittedRetainedCount.load(
+                            std::memory_order_relaxed
+                        )
+                    );
+                }
+                /*
+                 * Time from enqueue until the Event's callback starts, per
+                 * priority and dispatch method, measured on the drain clock.
+                 * Empty unless ESPRESSIO_EVENT_LATENCY_HISTOGRAMS is set.
+                 */
+                EventLatencySnapshot GetEventLatencySnapshot(
+                    EventPriority priority,
+                    EventDispatchMethod method
+                ) const {
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _latencyHistograms[
+                        CollectionID(method, PriorityIndex(priority))
+                    ].GetSnapshot();
+#else
+                    (void)priority;
+                    (void)method;
+                    return EventLatencySnapshot{};
+#endif
+                }
+                EventLatencySnapshot GetEventLatencySnapshot() const {
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    EventLatencyHistogram<> merged;
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    for (const auto& histogram : _latencyHistograms) {
+                        merged.Merge(histogram);
+                    }
+                    return merged.GetSnapshot();
+#else
+                    return EventLatencySnapshot{};
+#endif
+                }
+                void ResetEventLatencyStatistics() {
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    for (auto& histogram : _latencyHistograms) {
+                        histogram.Reset();
+                    }
+#endif
                 }
                 size_t GetRetainedEventCapacity() const {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
@@ -581,8 +2456,115 @@ namespace ESPressio {
                 void ResetEventQueueStatistics() {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
                     _peakPendingEventCount = _pendingEventCount;
+                    _peakSubmittedRetainedCount.store(
+                        0, std::memory_order_relaxed
+                    );
                     _rejectedEventCount = 0;
                     _droppedEventCount = 0;
+                    _coalescedEventCount = 0;
+                    _expiredEventCount = 0;
+                }
+                EventCoalescingPolicy GetEventCoalescingPolicy() const {
+                    return _coalescingPolicy.load(std::memory_order_acquire);
+                }
+                /*
+                 * Disabling coalescing discards the index; Events already
+                 * pending are delivered normally.
+                 */
+                void SetEventCoalescingPolicy(EventCoalescingPolicy policy) {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _coalescingPolicy.store(policy, std::memory_order_release);
+                    if (policy == EventCoalescingPolicy::Disabled) {
+                        _coalescingIndex.clear();
+                    }
+                }
+                uint64_t GetCoalescedEventCount() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _coalescedEventCount;
+                }
+                /*
+                 * Events released at drain time because their TTL had
+                 * passed. Counted when the drain pass completes.
+                 */
+                uint64_t GetExpiredEventCount() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _expiredEventCount;
+                }
+                EventSchedulingPolicy GetEventSchedulingPolicy() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _schedulingPolicy;
+                }
+                void SetEventSchedulingPolicy(EventSchedulingPolicy policy) {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _schedulingPolicy = policy;
+                    _schedulingDeficits.fill(0);
+                    _schedulingCursor = PriorityIndex(EventPriority::High);
+                }
+                size_t GetEventPriorityWeight(EventPriority priority) const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _priorityWeights[PriorityIndex(priority)];
+                }
+                void SetEventPriorityWeight(
+                    EventPriority priority,
+                    size_t weight
+                ) {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _priorityWeights[PriorityIndex(priority)] =
+                        std::max<size_t>(weight, 1);
+                }
+                EventDrainBudget GetEventDrainBudget() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _drainBudget;
+                }
+                void SetEventDrainBudget(const EventDrainBudget& budget) {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _drainBudget = budget;
+                }
+                EventBackpressurePolicy GetEventBackpressurePolicy() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _backpressurePolicy;
+                }
+                void SetEventBackpressurePolicy(
+                    const EventBackpressurePolicy& policy
+                ) {
+                    {
+                        std::lock_guard<std::mutex> lock(_eventsMutex);
+                        _backpressurePolicy = policy;
+                    }
+                    _capacityAvailable.notify_all();
+                }
+                /*
+                 * Time producers spent blocked by BlockProducer, from first
+                 * hitting a full receiver until admitted or rejected,
+                 * measured on the drain clock.
+                 */
+                EventBackpressureStatistics
+                GetEventBackpressureStatistics() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _backpressureStatistics;
+                }
+                void ResetEventBackpressureStatistics() {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _backpressureStatistics = EventBackpressureStatistics{};
+                }
+                /*
+                 * Clock used for drain time quotas and statistics. nullptr
+                 * selects the EventClock, which is the System Clock outside
+                 * simulation. The clock must outlive the receiver or be
+                 * reset before it is destroyed.
+                 */
+                void SetEventDrainClock(
+                    Timing::ISystemClock<EventTime>* clock
+                ) {
+                    _drainClock.store(clock, std::memory_order_release);
+                }
+                EventDrainStatistics GetEventDrainStatistics() const {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    return _drainStatistics;
+                }
+                void ResetEventDrainStatistics() {
+                    std::lock_guard<std::mutex> lock(_eventsMutex);
+                    _drainStatistics = EventDrainStatistics{};
                 }
                 size_t GetMinimumRetainedEventCapacity() const {
                     std::lock_guard<std::mutex> lock(_eventsMutex);
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Growable circular buffer used for receiver pending storage.
+         *
+         * Unlike std::vector it removes from the front in constant time,
+         * which keeps overflow eviction and partially drained collections
+         * O(1). Capacity is exact (no power-of-two rounding) so receiver
+         * capacity policies can shrink to a precise target.
+         *
+         * Every entry also has an absolute position that does not change
+         * while it stays in the buffer, even when earlier entries are
+         * removed from the front or the storage is reallocated. Receivers
+         * use it to find a pending entry again in constant time.
+         *
+         * use_storage() switches a buffer to caller-owned fixed storage. It
+         * then never allocates: reserving beyond that capacity, or pushing
+         * into a full buffer, throws std::length_error, and shrinking is a
+         * no-op. Swapping or moving carries the storage (and its ownership)
+         * with it.
+         */
+        template<typename T>
+        class EventRingBuffer {
+            private:
+                struct StorageDeleter {
+                    bool owned = true;
+                    void operator()(T* items) const noexcept {
+                        if (owned) {
+                            delete[] items;
+                        }
+                    }
+                };
+
+                std::unique_ptr<T[], StorageDeleter> _items;
+                size_t _capacity = 0;
+                size_t _head = 0;
+                size_t _size = 0;
+                uint64_t _frontPosition = 0;
+
+                size_t Slot(size_t index) const noexcept {
+                    const size_t slot = _head + index;
+                    return slot >= _capacity ? slot - _capacity : slot;
+                }
+
+                void Reallocate(size_t capacity) {
+                    if (fixed_storage()) {
+                        throw std::length_error(
+                            "EventRingBuffer fixed storage is full"
+                        );
+                    }
+                    std::unique_ptr<T[], StorageDeleter> items(
+                        capacity == 0 ? nullptr : new T[capacity]
+                    );
+                    for (size_t index = 0; index < _size; ++index) {
+                        items[index] = std::move((*this)[index]);
+                    }
+                    _items.swap(items);
+                    _capacity = capacity;
+                    _head = 0;
+                }
+
+                void Grow() {
+                    Reallocate(_capacity == 0 ? 1 : _capacity * 2);
+                }
+
+            public:
+                EventRingBuffer() = default;
+
+                EventRingBuffer(EventRingBuffer&& other) noexcept :
+                    _items(std::move(other._items)),
+                    _capacity(other._capacity),
+                    _head(other._head),
+                    _size(other._size),
+                    _frontPosition(other._frontPosition) {
+                    other._capacity = 0;
+                    other._head = 0;
+                    other._size = 0;
+                    other._frontPosition = 0;
+                }
+
+                EventRingBuffer& operator=(
+                    EventRingBuffer&& other
+                ) noexcept {
+                    if (this != &other) {
+                        EventRingBuffer moved(std::move(other));
+                        swap(moved);
+                    }
+                    return *this;
+                }
+
+                EventRingBuffer(const EventRingBuffer&) = delete;
+                EventRingBuffer& operator=(const EventRingBuffer&) = delete;
+
+                size_t size() const noexcept { return _size; }
+                bool empty() const noexcept { return _size == 0; }
+                size_t capacity() const noexcept { return _capacity; }
+                bool fixed_storage() const noexcept {
+                    return !_items.get_deleter().owned;
+                }
+
+                /*
+                 * Adopts capacity entries of caller-owned storage, which must
+                 * outlive the buffer (or whichever buffer it is swapped
+                 * into). The buffer must be empty; any owned storage is
+                 * released.
+                 */
+                void use_storage(T* items, size_t capacity) noexcept {
+                    _items = std::unique_ptr<T[], StorageDeleter>(
+                        items, StorageDeleter{false}
+                    );
+                    _capacity = capacity;
+                    _head = 0;
+                    _size = 0;
+                }
+
+                T& operator[](size_t index) noexcept {
+                    return _items[Slot(index)];
+                }
+
+                const T& operator[](size_t index) const noexcept {
+                    return _items[Slot(index)];
+                }
+
+                T& front() noexcept { return _items[_head]; }
+                const T& front() const noexcept { return _items[_head]; }
+                T& back() noexcept { return (*this)[_size - 1]; }
+                const T& back() const noexcept { return (*this)[_size - 1]; }
+
+                uint64_t front_position() const noexcept {
+                    return _frontPosition;
+                }
+
+                /*
+                 * Returns the entry at an absolute position, or nullptr when
+                 * that position is no longer (or not yet) in the buffer.
+                 * Positions wrap modulo 2^64, so push_front below position 0
+                 * is fine.
+                 */
+                T* at_position(uint64_t position) noexcept {
+                    const uint64_t index = position - _frontPosition;
+                    return index >= _size
+                        ? nullptr
+                        : &(*this)[static_cast<size_t>(index)];
+                }
+
+                void push_back(const T& item) {
+                    if (_size == _capacity) {
+                        Grow();
+                    }
+                    _items[Slot(_size)] = item;
+                    ++_size;
+                }
+
+                void push_front(const T& item) {
+                    if (_size == _capacity) {
+                        Grow();
+                    }
+                    _head = _head == 0 ? _capacity - 1 : _head - 1;
+                    _items[_head] = item;
+                    ++_size;
+                    --_frontPosition;
+                }
+
+                void pop_front() noexcept {
+                    _items[_head] = T{};
+                    _head = Slot(1);
+                    --_size;
+                    ++_frontPosition;
+                    if (_size == 0) {
+                        _head = 0;
+                    }
+                }
+
+                void pop_back() noexcept {
+                    (*this)[_size - 1] = T{};
+                    --_size;
+                    if (_size == 0) {
+                        _head = 0;
+                    }
+                }
+
+                void clear() noexcept {
+                    for (size_t index = 0; index < _size; ++index) {
+                        (*this)[index] = T{};
+                    }
+                    _frontPosition += _size;
+                    _head = 0;
+                    _size = 0;
+                }
+
+                void reserve(size_t capacity) {
+                    if (capacity > _capacity) {
+                        Reallocate(capacity);
+                    }
+                }
+
+                /*
+                 * Reallocates to exactly max(capacity, size()). Releases all
+                 * storage when the buffer is empty and capacity is zero.
+                 */
+                void shrink_to(size_t capacity) {
+                    if (fixed_storage()) {
+                        return;
+                    }
+                    if (capacity < _size) {
+                        capacity = _size;
+                    }
+                    if (capacity < _capacity) {
+                        Reallocate(capacity);
+                    }
+                }
+
+                void shrink_to_fit() {
+                    shrink_to(_size);
+                }
+
+                void swap(EventRingBuffer& other) noexcept {
+                    _items.swap(other._items);
+                    std::swap(_capacity, other._capacity);
+                    std::swap(_head, other._head);
+                    std::swap(_size, other._size);
+                    std::swap(_frontPosition, other._frontPosition);
+                }
+        };
+
+
+        template<typename T>
+        inline void swap(
+            EventRingBuffer<T>& left,
+            EventRingBuffer<T>& right
+        ) noexcept {
+            left.swap(right);
+        }
+
+    }
+
+}
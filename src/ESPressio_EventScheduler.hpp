@@ -0,0 +1,390 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include <ESPressio_Thread.hpp>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
+#include "ESPressio_EventEnums.hpp"
+#include "ESPressio_EventManager.hpp"
+#include "ESPressio_EventSimulation.hpp"
+#include "ESPressio_EventSpan.hpp"
+#include "ESPressio_EventTimerWheel.hpp"
+
+#ifndef ESPRESSIO_EVENT_SCHEDULER_PRIORITY
+    #define ESPRESSIO_EVENT_SCHEDULER_PRIORITY ESPRESSIO_EVENT_MANAGER_PRIORITY
+#endif
+
+#ifndef ESPRESSIO_EVENT_SCHEDULER_CORE_ID
+    #define ESPRESSIO_EVENT_SCHEDULER_CORE_ID ESPRESSIO_EVENT_MANAGER_CORE_ID
+#endif
+
+using namespace ESPressio::Threads;
+
+namespace ESPressio {
+
+    namespace Event {
+
+        class EventScheduler;
+
+        /*
+         * Cancels one Event scheduled through Event::QueueAfter/QueueAt.
+         * Copies refer to the same timer; cancelling after the Event was
+         * queued, or twice, returns false and has no effect.
+         */
+        class EventScheduleHandle {
+            private:
+                EventScheduler* _scheduler = nullptr;
+                EventTimerHandle _timer{};
+
+            public:
+                EventScheduleHandle() = default;
+
+                EventScheduleHandle(
+                    EventScheduler* scheduler,
+                    EventTimerHandle timer
+                ) :
+                    _scheduler(scheduler),
+                    _timer(timer) {
+                }
+
+                bool IsValid() const noexcept {
+                    return
+                        _scheduler != nullptr &&
+                        _timer.IsValid();
+                }
+
+                inline bool Cancel();
+        };
+
+
+        /*
+         * Holds delayed Events on an EventTimerWheel and hands them to the
+         * EventManager when due. One Thread serves every timer; it sleeps
+         * until the wheel's next wake time and queues all Events falling
+         * due together with one batch enqueue per bus, priority and method.
+         */
+        class EventScheduler :
+            public Thread
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
+            private:
+                struct DueEvent {
+                    IEvent* event;
+                    EventManager* bus;
+                    EventPriority priority;
+                    EventDispatchMethod method;
+                };
+
+                std::mutex _mutex;
+                std::condition_variable _wake;
+                EventTimerWheel _wheel;
+
+                uint64_t _wakeNanoseconds =
+                    std::numeric_limits<uint64_t>::max();
+
+                std::vector<DueEvent> _dueEvents;
+
+                /*
+                 * One bus/priority/method run of Events being queued.
+                 * Only Deliver touches it, on this Thread or simulation
+                 * step, so its capacity is reused without a lock.
+                 */
+                std::vector<IEvent*> _batch;
+
+                static uint64_t GetNowNanoseconds() {
+                    return EventClock::GetNowNanoseconds();
+                }
+
+                // Wakes the Thread if deadline is earlier than its current sleep
+                void WakeForLocked(uint64_t deadline) {
+                    if (deadline < _wakeNanoseconds) {
+                        _wakeNanoseconds = deadline;
+                        _wake.notify_one();
+                    }
+                }
+
+                void Deliver(
+                    const DueEvent* events,
+                    size_t count
+                ) {
+                    _batch.reserve(count);
+
+                    size_t index = 0;
+                    while (index < count) {
+                        EventManager* bus =
+                            events[index].bus;
+                        const EventPriority priority =
+                            events[index].priority;
+                        const EventDispatchMethod method =
+                            events[index].method;
+
+                        _batch.clear();
+                        while (
+                            index < count &&
+                            events[index].bus == bus &&
+                            events[index].priority == priority &&
+                            events[index].method == method
+                        ) {
+                            _batch.push_back(events[index++].event);
+                        }
+
+                        if (method == EventDispatchMethod::Stack) {
+                            bus->StackEvents(
+                                EventSpan(_batch.data(), _batch.size()),
+                                priority
+                            );
+                        } else {
+                            bus->QueueEvents(
+                                EventSpan(_batch.data(), _batch.size()),
+                                priority
+                            );
+                        }
+                    }
+
+                    _batch.clear();
+                }
+
+                /*
+                 * Queues every Event now due. Returns false, still holding
+                 * the lock, when none was.
+                 */
+                bool DeliverDueLocked(
+                    std::unique_lock<std::mutex>& lock
+                ) {
+                    _dueEvents.clear();
+                    try {
+                        _wheel.Advance(
+                            GetNowNanoseconds(),
+                            [this](
+                                IEvent* event,
+                                EventPriority priority,
+                                EventDispatchMethod method
+                            ) {
+                                EventManager* bus = event->GetEventBus();
+                                _dueEvents.push_back(
+                                    DueEvent{
+                                        event,
+                                        bus == nullptr
+                                            ? EventManager::GetInstance()
+                                            : bus,
+                                        priority,
+                                        method
+                                    }
+                                );
+                                event->__ref();
+                            }
+                        );
+                    } catch (...) {
+                        /*
+                         * A failed push_back leaves its timer, and every
+                         * later one, due in the wheel. Deliver what was
+                         * collected; the next pass retries the rest.
+                         */
+                        if (_dueEvents.empty()) {
+                            throw;
+                        }
+                    }
+
+                    if (_dueEvents.empty()) {
+                        return false;
+                    }
+
+                    /*
+                     * Queue outside the lock so scheduling never waits on
+                     * the EventManager. The swap keeps _dueEvents' capacity
+                     * with this Thread while the lock is released.
+                     */
+                    std::vector<DueEvent> dueEvents;
+                    dueEvents.swap(_dueEvents);
+                    lock.unlock();
+
+                    Deliver(
+                        dueEvents.data(),
+                        dueEvents.size()
+                    );
+
+                    for (const DueEvent& due : dueEvents) {
+                        due.event->__unref();
+                    }
+
+                    dueEvents.clear();
+                    lock.lock();
+                    if (_dueEvents.capacity() < dueEvents.capacity()) {
+                        _dueEvents.swap(dueEvents);
+                    }
+                    return true;
+                }
+
+            protected:
+                EventScheduler() :
+                    Thread(true),
+                    _wheel(
+                        ESPRESSIO_EVENT_TIMER_WHEEL_TICK_NANOSECONDS,
+                        GetNowNanoseconds()
+                    ) {
+                    SetPriority(
+                        ESPRESSIO_EVENT_SCHEDULER_PRIORITY
+                    );
+                    SetCoreID(
+                        ESPRESSIO_EVENT_SCHEDULER_CORE_ID
+                    );
+#if !ESPRESSIO_EVENT_SIMULATION
+                    Initialize();
+                    Start();
+#endif
+                }
+
+                void OnLoop() override {
+                    std::unique_lock<std::mutex> lock(_mutex);
+
+                    if (DeliverDueLocked(lock)) {
+                        return;
+                    }
+
+                    _wakeNanoseconds = _wheel.GetNextWakeNanoseconds();
+                    if (
+                        _wakeNanoseconds ==
+                        std::numeric_limits<uint64_t>::max()
+                    ) {
+                        _wake.wait(lock);
+                    } else {
+                        const uint64_t now = GetNowNanoseconds();
+                        if (_wakeNanoseconds > now) {
+                            _wake.wait_for(
+                                lock,
+                                std::chrono::nanoseconds(
+                                    _wakeNanoseconds - now
+                                )
+                            );
+                        }
+                    }
+                    _wakeNanoseconds = 0;
+                }
+
+            public:
+                static EventScheduler* GetInstance() {
+                    static EventScheduler* instance = new EventScheduler();
+                    return instance;
+                }
+
+                /*
+                 * Queues (or Stacks) event through the EventManager once
+                 * delayNanoseconds have passed, rounded up to the timer
+                 * wheel tick. The scheduler holds a reference until then.
+                 */
+                EventScheduleHandle ScheduleAfter(
+                    IEvent* event,
+                    uint64_t delayNanoseconds,
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue
+                ) {
+                    const uint64_t now = GetNowNanoseconds();
+
+                    return
+                        ScheduleAt(
+                            event,
+                            delayNanoseconds >
+                                std::numeric_limits<uint64_t>::max() - now
+                                ? std::numeric_limits<uint64_t>::max()
+                                : now + delayNanoseconds,
+                            priority,
+                            method
+                        );
+                }
+
+                /*
+                 * As ScheduleAfter, at an absolute SystemClock time in
+                 * nanoseconds. A time already passed queues on the next
+                 * wake-up.
+                 */
+                EventScheduleHandle ScheduleAt(
+                    IEvent* event,
+                    uint64_t timeNanoseconds,
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue
+                ) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    const EventTimerHandle timer =
+                        _wheel.Schedule(
+                            timeNanoseconds,
+                            event,
+                            priority,
+                            method
+                        );
+
+                    if (!timer.IsValid()) {
+                        return EventScheduleHandle{};
+                    }
+
+                    WakeForLocked(timeNanoseconds);
+
+                    return
+                        EventScheduleHandle(
+                            this,
+                            timer
+                        );
+                }
+
+                /*
+                 * Cancels a timer that has not fired and releases the
+                 * scheduler's reference to its Event.
+                 */
+                bool Cancel(
+                    const EventTimerHandle& timer
+                ) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _wheel.Cancel(timer);
+                }
+
+#if ESPRESSIO_EVENT_SIMULATION
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t
+                ) override {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _wheel.GetNextWakeNanoseconds();
+                }
+
+                void RunSimulationStep(uint64_t) override {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    DeliverDueLocked(lock);
+                }
+#endif
+
+                size_t GetScheduledEventCount() {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _wheel.GetScheduledCount();
+                }
+
+                virtual ~EventScheduler() {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _wheel.Clear();
+                }
+        };
+
+
+        inline bool EventScheduleHandle::Cancel() {
+            return
+                IsValid() &&
+                _scheduler->Cancel(
+                    _timer
+                );
+        }
+
+    }
+
+}
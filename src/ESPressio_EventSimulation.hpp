@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <ESPressio_SystemClock.hpp>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
+
+/*
+ * Steps allowed at one virtual instant before a simulation run gives up,
+ * catching processes that keep each other runnable forever.
+ */
+#ifndef ESPRESSIO_EVENT_SIMULATION_MAX_STEPS_PER_INSTANT
+    #define ESPRESSIO_EVENT_SIMULATION_MAX_STEPS_PER_INSTANT 1000000
+#endif
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Something EventSimulation runs in place of a Thread. In simulation
+         * builds the EventManager, EventThread, PrecisionEventThread,
+         * EventScheduler and PeriodicEventSource all implement it.
+         */
+        class IEventSimulationProcess {
+            public:
+                virtual ~IEventSimulationProcess() = default;
+
+                /*
+                 * Virtual time at which the process next has work: at or
+                 * before nowNanoseconds when it can run now, UINT64_MAX when
+                 * it is idle until another process gives it work.
+                 */
+                virtual uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t nowNanoseconds
+                ) = 0;
+
+                // Does the work one Thread loop would, without blocking
+                virtual void RunSimulationStep(uint64_t nowNanoseconds) = 0;
+        };
+
+        // Virtual clock that only moves when told to
+        class EventSimulationClock final : public Timing::ISystemClock<EventTime> {
+            private:
+                uint64_t _nowNanoseconds = 0;
+
+            public:
+                explicit EventSimulationClock(uint64_t startNanoseconds = 0) :
+                    _nowNanoseconds(startNanoseconds) {
+                }
+
+                EventTime GetTime() override { return EventTime(_nowNanoseconds); }
+                EventTime GetResolution() override { return EventTime(1); }
+
+                uint64_t GetNowNanoseconds() const noexcept { return _nowNanoseconds; }
+
+                // Never moves backwards
+                void SetNowNanoseconds(uint64_t nowNanoseconds) noexcept {
+                    _nowNanoseconds = std::max(_nowNanoseconds, nowNanoseconds);
+                }
+        };
+
+        /*
+         * Deterministic discrete-event scheduler over a virtual clock.
+         *
+         * Registered processes run on the calling thread. At each virtual
+         * instant every runnable process is stepped in registration order,
+         * repeatedly, until none is runnable; the clock then jumps straight
+         * to the earliest wake time. Idle time therefore costs nothing, and
+         * the same inputs always give the same interleaving and the same
+         * timestamps. Consume() lets a step model its own processing time.
+         *
+         * While it exists, the simulation installs its clock as the
+         * EventClock override, so Event timestamps, YoungerThan interest,
+         * time-to-live and drain budgets all read virtual time. Only one
+         * simulation should exist at a time.
+         */
+        class EventSimulation {
+            private:
+                EventSimulationClock _clock;
+                Timing::ISystemClock<EventTime>* _previousClock;
+                std::vector<IEventSimulationProcess*> _processes;
+                uint64_t _stepCount = 0;
+                bool _stalled = false;
+
+                // Runs runnable processes until none is; false if the step limit was hit
+                bool RunInstant() {
+                    size_t steps = 0;
+                    bool progressed = true;
+                    while (progressed) {
+                        progressed = false;
+                        for (size_t index = 0; index < _processes.size(); ++index) {
+                            IEventSimulationProcess* process = _processes[index];
+                            const uint64_t now = _clock.GetNowNanoseconds();
+                            if (process->GetNextSimulationWakeNanoseconds(now) > now) {
+                                continue;
+                            }
+                            if (steps++ == ESPRESSIO_EVENT_SIMULATION_MAX_STEPS_PER_INSTANT) {
+                                _stalled = true;
+                                return false;
+                            }
+                            process->RunSimulationStep(now);
+                            ++_stepCount;
+                            progressed = true;
+                        }
+                    }
+                    return true;
+                }
+
+                uint64_t GetNextWakeNanoseconds() {
+                    const uint64_t now = _clock.GetNowNanoseconds();
+                    uint64_t next = std::numeric_limits<uint64_t>::max();
+                    for (IEventSimulationProcess* process : _processes) {
+                        next = std::min(next, process->GetNextSimulationWakeNanoseconds(now));
+                    }
+                    return next;
+                }
+
+            public:
+                explicit EventSimulation(uint64_t startNanoseconds = 0) :
+                    _clock(startNanoseconds),
+                    _previousClock(EventClock::SetOverride(&_clock)) {
+                }
+
+                ~EventSimulation() {
+                    EventClock::SetOverride(_previousClock);
+                }
+
+                EventSimulation(const EventSimulation&) = delete;
+                EventSimulation& operator=(const EventSimulation&) = delete;
+
+                EventSimulationClock& GetClock() noexcept { return _clock; }
+
+                uint64_t GetNowNanoseconds() const noexcept { return _clock.GetNowNanoseconds(); }
+
+                // Processes run in the order they were added
+                void AddProcess(IEventSimulationProcess* process) {
+                    if (
+                        process != nullptr &&
+                        std::find(_processes.begin(), _processes.end(), process) == _processes.end()
+                    ) {
+                        _processes.push_back(process);
+                    }
+                }
+
+                void RemoveProcess(IEventSimulationProcess* process) {
+                    _processes.erase(
+                        std::remove(_processes.begin(), _processes.end(), process),
+                        _processes.end()
+                    );
+                }
+
+                /*
+                 * Advances virtual time by durationNanoseconds from inside a
+                 * step, modelling the time that step spent working.
+                 */
+                void Consume(uint64_t durationNanoseconds) noexcept {
+                    _clock.SetNowNanoseconds(_clock.GetNowNanoseconds() + durationNanoseconds);
+                }
+
+                /*
+                 * Runs every process due up to endNanoseconds, then leaves
+                 * the clock at endNanoseconds (or later, if a step consumed
+                 * past it). Returns false if the run stalled.
+                 */
+                bool RunUntil(uint64_t endNanoseconds) {
+                    while (true) {
+                        if (!RunInstant()) {
+                            return false;
+                        }
+                        const uint64_t next = GetNextWakeNanoseconds();
+                        if (next > endNanoseconds) {
+                            _clock.SetNowNanoseconds(endNanoseconds);
+                            return true;
+                        }
+                        _clock.SetNowNanoseconds(next);
+                    }
+                }
+
+                bool RunFor(uint64_t durationNanoseconds) {
+                    const uint64_t now = _clock.GetNowNanoseconds();
+                    return RunUntil(
+                        durationNanoseconds > std::numeric_limits<uint64_t>::max() - now
+                            ? std::numeric_limits<uint64_t>::max()
+                            : now + durationNanoseconds
+                    );
+                }
+
+                uint64_t GetStepCount() const noexcept { return _stepCount; }
+
+                bool HasStalled() const noexcept { return _stalled; }
+        };
+
+    }
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "ESPressio_IEvent.hpp"
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Non-owning view over a contiguous sequence of Event pointers.
+         *
+         * Event targets C++17, so this stands in for std::span<IEvent* const>
+         * in the batch enqueue APIs. The referenced storage must outlive the
+         * call it is passed to; receivers take their own references.
+         */
+        class EventSpan {
+            private:
+                IEvent* const* _events = nullptr;
+                size_t _size = 0;
+
+            public:
+                constexpr EventSpan() noexcept = default;
+
+                constexpr EventSpan(
+                    IEvent* const* events,
+                    size_t size
+                ) noexcept :
+                    _events(events),
+                    _size(size) {
+                }
+
+                template<size_t Size>
+                constexpr EventSpan(
+                    IEvent* const (&events)[Size]
+                ) noexcept :
+                    _events(events),
+                    _size(Size) {
+                }
+
+                template<size_t Size>
+                EventSpan(
+                    const std::array<IEvent*, Size>& events
+                ) noexcept :
+                    _events(events.data()),
+                    _size(Size) {
+                }
+
+                EventSpan(
+                    const std::vector<IEvent*>& events
+                ) noexcept :
+                    _events(events.data()),
+                    _size(events.size()) {
+                }
+
+                constexpr IEvent* const* data() const noexcept {
+                    return _events;
+                }
+
+                constexpr size_t size() const noexcept {
+                    return _size;
+                }
+
+                constexpr bool empty() const noexcept {
+                    return _size == 0;
+                }
+
+                constexpr IEvent* operator[](size_t index) const noexcept {
+                    return _events[index];
+                }
+
+                constexpr IEvent* const* begin() const noexcept {
+                    return _events;
+                }
+
+                constexpr IEvent* const* end() const noexcept {
+                    return _events + _size;
+                }
+        };
+
+    }
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ESPressio_EventEnums.hpp"
+#include "ESPressio_EventLatencyHistogram.hpp"
+#include "ESPressio_IEvent.hpp"
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Bounded multi-producer/single-consumer submission ring.
+         *
+         * Producers claim a cell with a single compare-exchange on the
+         * enqueue position and publish it through the cell sequence, so no
+         * producer ever waits on another producer's lock. The consumer side
+         * is not synchronised internally: EventReceiver only pops while it
+         * holds its receiver mutex, which makes whichever thread holds that
+         * mutex the single consumer.
+         */
+        class EventSubmissionRing {
+            public:
+                struct Submission {
+                    IEvent* event = nullptr;
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue;
+                    uint64_t expiresAtNanoseconds = 0;
+#if ESPRESSIO_EVENT_LATENCY_HISTOGRAMS
+                    uint64_t enqueuedAtNanoseconds = 0;
+#endif
+                };
+
+            private:
+                struct Cell {
+                    std::atomic<size_t> sequence{0};
+                    Submission submission{};
+                };
+
+                std::unique_ptr<Cell[]> _cells;
+                size_t _mask = 0;
+                std::atomic<size_t> _enqueuePosition{0};
+                size_t _dequeuePosition = 0;
+
+                static size_t RoundCapacity(size_t capacity) {
+                    size_t rounded = 2;
+                    while (rounded < capacity) {
+                        rounded <<= 1;
+                    }
+                    return rounded;
+                }
+
+            public:
+                explicit EventSubmissionRing(size_t capacity) {
+                    const size_t rounded = RoundCapacity(capacity);
+                    _cells.reset(new Cell[rounded]);
+                    _mask = rounded - 1;
+                    for (size_t index = 0; index < rounded; ++index) {
+                        _cells[index].sequence.store(
+                            index, std::memory_order_relaxed
+                        );
+                    }
+                }
+
+                EventSubmissionRing(const EventSubmissionRing&) = delete;
+                EventSubmissionRing& operator=(
+                    const EventSubmissionRing&
+                ) = delete;
+
+                size_t GetCapacity() const noexcept {
+                    return _mask + 1;
+                }
+
+                bool TryPush(const Submission& submission) noexcept {
+                    size_t position = _enqueuePosition.load(
+                        std::memory_order_relaxed
+                    );
+                    Cell* cell = nullptr;
+
+                    for (;;) {
+                        cell = &_cells[position & _mask];
+                        const size_t sequence = cell->sequence.load(
+                            std::memory_order_acquire
+                        );
+                        const intptr_t difference =
+                            static_cast<intptr_t>(sequence) -
+                            static_cast<intptr_t>(position);
+
+                        if (difference == 0) {
+                            if (_enqueuePosition.compare_exchange_weak(
+                                    position,
+                                    position + 1,
+                                    std::memory_order_relaxed
+                                )) {
+                                break;
+                            }
+                        } else if (difference < 0) {
+                            return false;
+                        } else {
+                            position = _enqueuePosition.load(
+                                std::memory_order_relaxed
+                            );
+                        }
+                    }
+
+                    cell->submission = submission;
+                    cell->sequence.store(
+                        position + 1, std::memory_order_release
+                    );
+                    return true;
+                }
+
+                /*
+                 * Single-consumer pop. Returns false when the ring is empty or
+                 * when the next claimed cell has not been published yet; the
+                 * remaining submissions are collected on a later pass.
+                 */
+                bool TryPop(Submission& submission) noexcept {
+                    Cell& cell = _cells[_dequeuePosition & _mask];
+                    const size_t sequence = cell.sequence.load(
+                        std::memory_order_acquire
+                    );
+
+                    if (sequence != _dequeuePosition + 1) {
+                        return false;
+                    }
+
+                    submission = cell.submission;
+                    cell.submission = Submission{};
+                    cell.sequence.store(
+                        _dequeuePosition + _mask + 1,
+                        std::memory_order_release
+                    );
+                    ++_dequeuePosition;
+                    return true;
+                }
+        };
+
+    }
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <limits>
+#include <mutex>
 #include <typeindex>
 
 #include <ESPressio_Thread.hpp>
@@ -8,6 +10,7 @@
 
 #include "ESPressio_EventListener.hpp"
 #include "ESPressio_EventManager.hpp"
+#include "ESPressio_StaticEventReceiver.hpp"
 
 namespace ESPressio {
 
@@ -26,6 +29,32 @@ namespace ESPressio {
                 std::atomic<bool>
                     _acceptingEvents{true};
 
+                std::atomic<EventManager*>
+                    _eventBus{nullptr};
+
+                /*
+                 * Set by the first listener registration; the bus can no
+                 * longer change, so unregistration reaches the same bus.
+                 */
+                bool _eventBusLatched = false;
+
+                std::mutex _eventBusMutex;
+
+
+                EventManager* LatchEventBus() {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    _eventBusLatched =
+                        true;
+
+                    return
+                        GetEventBus();
+                }
+
 
                 void StopReceivingEvents()
                     noexcept {
@@ -69,8 +98,7 @@ namespace ESPressio {
                 void OnListenerRegistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    LatchEventBus()->
                         RegisterReceiver(
                             eventType,
                             this
@@ -81,8 +109,7 @@ namespace ESPressio {
                 void OnListenerUnregistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    GetEventBus()->
                         UnregisterReceiver(
                             eventType,
                             this
@@ -90,6 +117,56 @@ namespace ESPressio {
                 }
 
 
+                void OnPolymorphicListenerRegistered(
+                    EventTypeID baseType,
+                    EventTypeMatcher matcher
+                ) override {
+                    LatchEventBus()->
+                        RegisterPolymorphicReceiver(
+                            baseType,
+                            matcher,
+                            this
+                        );
+                }
+
+
+                void OnPolymorphicListenerUnregistered(
+                    EventTypeID baseType
+                ) override {
+                    GetEventBus()->
+                        UnregisterPolymorphicReceiver(
+                            baseType,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerRegistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    LatchEventBus()->
+                        RegisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerUnregistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    GetEventBus()->
+                        UnregisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
             public:
                 explicit EventThread(
                     bool freeOnTerminate
@@ -100,6 +177,49 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Subscribes this thread's listeners on bus (see
+                 * EventManager::CreateBus) instead of the default bus.
+                 * Returns false, leaving the bus unchanged, once any
+                 * listener has been registered.
+                 */
+                bool SetEventBus(
+                    EventManager* bus
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    if (_eventBusLatched) {
+                        return false;
+                    }
+
+                    _eventBus.store(
+                        bus,
+                        std::memory_order_release
+                    );
+                    return true;
+                }
+
+
+                EventManager*
+                GetEventBus()
+                    const noexcept {
+                    EventManager* bus =
+                        _eventBus.load(
+                            std::memory_order_acquire
+                        );
+
+                    return
+                        bus == nullptr
+                            ? EventManager::
+                                GetInstance()
+                            : bus;
+                }
+
+
                 ~EventThread() override {
                     Shutdown();
                     StopReceivingEvents();
@@ -122,12 +242,23 @@ namespace ESPressio {
         };
 
 
+        /*
+         * In simulation builds (ESPRESSIO_EVENT_SIMULATION) an
+         * EventThreadWithLoop added to an EventSimulation is run by it
+         * instead of being started: each step runs one loop iteration,
+         * Events and OnThreadLoop in the configured order, while Events
+         * are pending.
+         */
         class EventThreadWithLoop :
             public Threads::Thread,
             public EventReceiver,
             public IEventThreadBase,
             public EventListener,
-            public IEventThread {
+            public IEventThread
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
 
             private:
                 EventThreadProcessOrder
@@ -138,6 +269,32 @@ namespace ESPressio {
                 std::atomic<bool>
                     _acceptingEvents{true};
 
+                std::atomic<EventManager*>
+                    _eventBus{nullptr};
+
+                /*
+                 * Set by the first listener registration; the bus can no
+                 * longer change, so unregistration reaches the same bus.
+                 */
+                bool _eventBusLatched = false;
+
+                std::mutex _eventBusMutex;
+
+
+                EventManager* LatchEventBus() {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    _eventBusLatched =
+                        true;
+
+                    return
+                        GetEventBus();
+                }
+
 
                 void StopReceivingEvents()
                     noexcept {
@@ -217,8 +374,7 @@ namespace ESPressio {
                 void OnListenerRegistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    LatchEventBus()->
                         RegisterReceiver(
                             eventType,
                             this
@@ -229,8 +385,7 @@ namespace ESPressio {
                 void OnListenerUnregistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    GetEventBus()->
                         UnregisterReceiver(
                             eventType,
                             this
@@ -238,6 +393,56 @@ namespace ESPressio {
                 }
 
 
+                void OnPolymorphicListenerRegistered(
+                    EventTypeID baseType,
+                    EventTypeMatcher matcher
+                ) override {
+                    LatchEventBus()->
+                        RegisterPolymorphicReceiver(
+                            baseType,
+                            matcher,
+                            this
+                        );
+                }
+
+
+                void OnPolymorphicListenerUnregistered(
+                    EventTypeID baseType
+                ) override {
+                    GetEventBus()->
+                        UnregisterPolymorphicReceiver(
+                            baseType,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerRegistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    LatchEventBus()->
+                        RegisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerUnregistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    GetEventBus()->
+                        UnregisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
             public:
                 explicit EventThreadWithLoop(
                     bool freeOnTerminate
@@ -254,6 +459,65 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Subscribes this thread's listeners on bus (see
+                 * EventManager::CreateBus) instead of the default bus.
+                 * Returns false, leaving the bus unchanged, once any
+                 * listener has been registered.
+                 */
+                bool SetEventBus(
+                    EventManager* bus
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    if (_eventBusLatched) {
+                        return false;
+                    }
+
+                    _eventBus.store(
+                        bus,
+                        std::memory_order_release
+                    );
+                    return true;
+                }
+
+
+                EventManager*
+                GetEventBus()
+                    const noexcept {
+                    EventManager* bus =
+                        _eventBus.load(
+                            std::memory_order_acquire
+                        );
+
+                    return
+                        bus == nullptr
+                            ? EventManager::
+                                GetInstance()
+                            : bus;
+                }
+
+
+#if ESPRESSIO_EVENT_SIMULATION
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t nowNanoseconds
+                ) override {
+                    return
+                        GetPendingEventCount() == 0
+                            ? std::numeric_limits<uint64_t>::max()
+                            : nowNanoseconds;
+                }
+
+                void RunSimulationStep(uint64_t) override {
+                    OnLoop();
+                }
+#endif
+
+
                 ~EventThreadWithLoop()
                     override {
                     Shutdown();
@@ -285,6 +549,54 @@ namespace ESPressio {
                 }
         };
 
+
+        /*
+         * EventThread with heap-free, fixed-size pending storage for at most
+         * Capacity Events, CollectionCapacity per priority and dispatch
+         * method. See StaticEventReceiver.
+         */
+        template<size_t Capacity, size_t CollectionCapacity = Capacity>
+        class StaticEventThread :
+            private StaticEventStorage<Capacity, CollectionCapacity>,
+            public EventThread {
+
+            public:
+                explicit StaticEventThread(
+                    bool freeOnTerminate
+                ) :
+                    EventThread(
+                        freeOnTerminate
+                    ) {
+                    UseStaticPendingStorage(
+                        this->_staticPendingStorage
+                    );
+                }
+        };
+
+
+        /*
+         * EventThreadWithLoop with heap-free, fixed-size pending storage for
+         * at most Capacity Events, CollectionCapacity per priority and
+         * dispatch method. See StaticEventReceiver.
+         */
+        template<size_t Capacity, size_t CollectionCapacity = Capacity>
+        class StaticEventThreadWithLoop :
+            private StaticEventStorage<Capacity, CollectionCapacity>,
+            public EventThreadWithLoop {
+
+            public:
+                explicit StaticEventThreadWithLoop(
+                    bool freeOnTerminate
+                ) :
+                    EventThreadWithLoop(
+                        freeOnTerminate
+                    ) {
+                    UseStaticPendingStorage(
+                        this->_staticPendingStorage
+                    );
+                }
+        };
+
     }
 
 }
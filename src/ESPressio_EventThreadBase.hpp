@@ -1,12 +1,15 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <limits>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
 #include <ESPressio_Thread.hpp>
 #include "ESPressio_EventReceiver.hpp"
+#include "ESPressio_EventSimulation.hpp"
 
 #ifndef ESPRESSIO_EVENT_THREAD_DEFAULT_PRIORITY
     #define ESPRESSIO_EVENT_THREAD_DEFAULT_PRIORITY 2
@@ -26,7 +29,19 @@ namespace ESPressio {
 
         };
 
-        class EventThreadBase : public Thread, public EventReceiver, public IEventThreadBase {
+        /*
+         * In simulation builds (ESPRESSIO_EVENT_SIMULATION) an EventThread
+         * added to an EventSimulation is run by it instead of being
+         * started: each step drains the pending Events as one loop would.
+         */
+        class EventThreadBase :
+            public Thread,
+            public EventReceiver,
+            public IEventThreadBase
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
             private:
                 std::atomic<TaskHandle_t>
                     _notificationTask{
@@ -52,6 +67,10 @@ namespace ESPressio {
                         );
                     }
 
+                    ProcessPendingEvents();
+                }
+
+                void ProcessPendingEvents() {
                     WithEvents(
                         [&](
                             IEvent* event,
@@ -87,6 +106,21 @@ namespace ESPressio {
                 }
 
             public:
+#if ESPRESSIO_EVENT_SIMULATION
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t nowNanoseconds
+                ) override {
+                    return
+                        GetPendingEventCount() == 0
+                            ? std::numeric_limits<uint64_t>::max()
+                            : nowNanoseconds;
+                }
+
+                void RunSimulationStep(uint64_t) override {
+                    ProcessPendingEvents();
+                }
+#endif
+
                 EventThreadBase(bool freeOnTerminate) :
                     Thread(freeOnTerminate) {
                     SetPriority(
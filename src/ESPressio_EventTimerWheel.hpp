@@ -0,0 +1,409 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventEnums.hpp"
+
+/*
+ * Granularity of delayed Event dispatch. A timer fires on the first tick at
+ * or after its deadline, never early.
+ */
+#ifndef ESPRESSIO_EVENT_TIMER_WHEEL_TICK_NANOSECONDS
+    #define ESPRESSIO_EVENT_TIMER_WHEEL_TICK_NANOSECONDS 1000000ULL
+#endif
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Identifies one scheduled timer. The generation makes a handle go
+         * stale once its timer fires or is cancelled, even after the slot
+         * is reused, so cancelling late is always safe.
+         */
+        struct EventTimerHandle {
+            uint32_t Index = std::numeric_limits<uint32_t>::max();
+            uint32_t Generation = 0;
+
+            bool IsValid() const noexcept {
+                return Index != std::numeric_limits<uint32_t>::max();
+            }
+        };
+
+        /*
+         * Hierarchical timer wheel holding Events until a deadline.
+         *
+         * LevelCount levels of SlotCount slots each cover 64^6 ticks (about
+         * 2 years at the default 1 ms tick); later deadlines wait in an
+         * overflow list. A timer lives in the level of the highest 6-bit
+         * tick group in which its deadline differs from the current tick,
+         * and moves down a level each time the wheel reaches that group.
+         * Timers are intrusive list nodes in a pooled vector, so scheduling
+         * and cancelling are O(1) and each timer is moved at most
+         * LevelCount times before it fires. Advancing skips empty levels,
+         * so a long idle period costs no per-tick work.
+         *
+         * The wheel holds a reference to each scheduled Event and releases
+         * it after the Event fires or is cancelled. It is not thread-safe;
+         * EventScheduler serialises access.
+         */
+        class EventTimerWheel {
+            public:
+                static constexpr unsigned SlotBits = 6;
+                static constexpr size_t SlotCount = size_t(1) << SlotBits;
+                static constexpr size_t LevelCount = 6;
+
+            private:
+                static constexpr uint32_t None =
+                    std::numeric_limits<uint32_t>::max();
+
+                static constexpr size_t SlotListCount =
+                    LevelCount * SlotCount;
+                static constexpr size_t OverflowList = SlotListCount;
+                static constexpr size_t DueList = SlotListCount + 1;
+                static constexpr size_t ListCount = SlotListCount + 2;
+
+                struct Timer {
+                    uint64_t deadlineTick = 0;
+                    IEvent* event = nullptr;
+                    uint32_t previous = None;
+                    uint32_t next = None;
+                    uint32_t generation = 0;
+                    uint32_t list = None;
+                    EventPriority priority = EventPriority::Normal;
+                    EventDispatchMethod method = EventDispatchMethod::Queue;
+                };
+
+                struct TimerList {
+                    uint32_t head = None;
+                    uint32_t tail = None;
+                };
+
+                std::vector<Timer> _timers;
+                uint32_t _freeTimers = None;
+                std::array<TimerList, ListCount> _lists{};
+                std::array<uint64_t, LevelCount> _occupiedSlots{};
+                uint64_t _tickNanoseconds;
+                uint64_t _currentTick;
+                size_t _scheduledCount = 0;
+
+                static uint64_t LevelSpan(size_t level) noexcept {
+                    return uint64_t(1) << (level * SlotBits);
+                }
+
+                void Link(uint32_t index, size_t list) noexcept {
+                    Timer& timer = _timers[index];
+                    TimerList& timers = _lists[list];
+                    timer.list = static_cast<uint32_t>(list);
+                    timer.previous = timers.tail;
+                    timer.next = None;
+                    if (timers.tail == None) {
+                        timers.head = index;
+                    } else {
+                        _timers[timers.tail].next = index;
+                    }
+                    timers.tail = index;
+                    if (list < SlotListCount) {
+                        _occupiedSlots[list / SlotCount] |=
+                            uint64_t(1) << (list % SlotCount);
+                    }
+                }
+
+                void Unlink(uint32_t index) noexcept {
+                    Timer& timer = _timers[index];
+                    TimerList& timers = _lists[timer.list];
+                    if (timer.previous == None) {
+                        timers.head = timer.next;
+                    } else {
+                        _timers[timer.previous].next = timer.next;
+                    }
+                    if (timer.next == None) {
+                        timers.tail = timer.previous;
+                    } else {
+                        _timers[timer.next].previous = timer.previous;
+                    }
+                    if (timers.head == None && timer.list < SlotListCount) {
+                        _occupiedSlots[timer.list / SlotCount] &=
+                            ~(uint64_t(1) << (timer.list % SlotCount));
+                    }
+                    timer.list = None;
+                }
+
+                void Place(uint32_t index) noexcept {
+                    const uint64_t deadline = _timers[index].deadlineTick;
+                    if (deadline <= _currentTick) {
+                        Link(index, DueList);
+                        return;
+                    }
+                    const uint64_t difference = deadline ^ _currentTick;
+                    for (size_t level = LevelCount; level-- > 0;) {
+                        if ((difference >> (level * SlotBits)) != 0) {
+                            Link(
+                                index,
+                                level * SlotCount +
+                                    ((deadline >> (level * SlotBits)) &
+                                        (SlotCount - 1))
+                            );
+                            return;
+                        }
+                    }
+                }
+
+                void PlaceOverflowing(uint32_t index) noexcept {
+                    const uint64_t deadline = _timers[index].deadlineTick;
+                    if (
+                        deadline > _currentTick &&
+                        (deadline ^ _currentTick) >= LevelSpan(LevelCount)
+                    ) {
+                        Link(index, OverflowList);
+                    } else {
+                        Place(index);
+                    }
+                }
+
+                // Re-places every timer in list relative to the current tick
+                void Redistribute(size_t list) noexcept {
+                    uint32_t index = _lists[list].head;
+                    _lists[list] = TimerList{};
+                    if (list < SlotListCount) {
+                        _occupiedSlots[list / SlotCount] &=
+                            ~(uint64_t(1) << (list % SlotCount));
+                    }
+                    while (index != None) {
+                        const uint32_t next = _timers[index].next;
+                        PlaceOverflowing(index);
+                        index = next;
+                    }
+                }
+
+                void Free(uint32_t index) noexcept {
+                    Timer& timer = _timers[index];
+                    ++timer.generation;
+                    timer.event = nullptr;
+                    timer.next = _freeTimers;
+                    _freeTimers = index;
+                    --_scheduledCount;
+                }
+
+                /*
+                 * A timer stays due, holding its reference, until fire
+                 * returns, so a fire that throws leaves it for the next
+                 * Advance rather than leaking its Event. fire may have
+                 * cancelled it meanwhile, which the generation tells.
+                 */
+                template<typename TFire>
+                size_t FireDue(TFire& fire) {
+                    size_t fired = 0;
+                    while (_lists[DueList].head != None) {
+                        const uint32_t index = _lists[DueList].head;
+                        IEvent* event = _timers[index].event;
+                        const uint32_t generation =
+                            _timers[index].generation;
+                        fire(
+                            event,
+                            _timers[index].priority,
+                            _timers[index].method
+                        );
+                        if (_timers[index].generation == generation) {
+                            Unlink(index);
+                            Free(index);
+                            event->__unref();
+                        }
+                        ++fired;
+                    }
+                    return fired;
+                }
+
+                // Moves _currentTick to tick, cascading and firing on the way
+                void StepTo(uint64_t tick) noexcept {
+                    _currentTick = tick;
+                    if ((tick & (LevelSpan(LevelCount) - 1)) == 0) {
+                        Redistribute(OverflowList);
+                    }
+                    for (size_t level = LevelCount; level-- > 1;) {
+                        if ((tick & (LevelSpan(level) - 1)) == 0) {
+                            Redistribute(
+                                level * SlotCount +
+                                    ((tick >> (level * SlotBits)) &
+                                        (SlotCount - 1))
+                            );
+                        }
+                    }
+                    Redistribute(tick & (SlotCount - 1));
+                }
+
+                /*
+                 * The next tick after the current one at which StepTo has
+                 * any work: the next occupied level 0 slot, otherwise the
+                 * next boundary of the lowest occupied level.
+                 */
+                uint64_t NextWorkTick() const noexcept {
+                    const uint64_t slot = _currentTick & (SlotCount - 1);
+                    const uint64_t ahead = slot + 1 < SlotCount
+                        ? _occupiedSlots[0] >> (slot + 1)
+                        : 0;
+                    if (ahead != 0) {
+                        uint64_t offset = 1;
+                        for (uint64_t bits = ahead; (bits & 1) == 0; bits >>= 1) {
+                            ++offset;
+                        }
+                        return _currentTick + offset;
+                    }
+                    size_t level = 1;
+                    while (level < LevelCount && _occupiedSlots[level] == 0) {
+                        ++level;
+                    }
+                    const uint64_t span = LevelSpan(level);
+                    return (_currentTick / span + 1) * span;
+                }
+
+            public:
+                explicit EventTimerWheel(
+                    uint64_t tickNanoseconds =
+                        ESPRESSIO_EVENT_TIMER_WHEEL_TICK_NANOSECONDS,
+                    uint64_t nowNanoseconds = 0
+                ) :
+                    _tickNanoseconds(tickNanoseconds == 0 ? 1 : tickNanoseconds),
+                    _currentTick(nowNanoseconds / _tickNanoseconds) {
+                    _lists.fill(TimerList{});
+                }
+
+                ~EventTimerWheel() {
+                    Clear();
+                }
+
+                EventTimerWheel(const EventTimerWheel&) = delete;
+                EventTimerWheel& operator=(const EventTimerWheel&) = delete;
+
+                uint64_t GetTickNanoseconds() const noexcept {
+                    return _tickNanoseconds;
+                }
+
+                size_t GetScheduledCount() const noexcept {
+                    return _scheduledCount;
+                }
+
+                /*
+                 * Holds event until deadlineNanoseconds, on the clock that
+                 * drives Advance(). A deadline already passed fires on the
+                 * next Advance().
+                 */
+                EventTimerHandle Schedule(
+                    uint64_t deadlineNanoseconds,
+                    IEvent* event,
+                    EventPriority priority = EventPriority::Normal,
+                    EventDispatchMethod method = EventDispatchMethod::Queue
+                ) {
+                    if (event == nullptr) {
+                        return EventTimerHandle{};
+                    }
+                    uint32_t index = _freeTimers;
+                    if (index == None) {
+                        _timers.emplace_back();
+                        index = static_cast<uint32_t>(_timers.size() - 1);
+                    } else {
+                        _freeTimers = _timers[index].next;
+                    }
+                    Timer& timer = _timers[index];
+                    timer.deadlineTick =
+                        deadlineNanoseconds / _tickNanoseconds +
+                        (deadlineNanoseconds % _tickNanoseconds != 0 ? 1 : 0);
+                    timer.event = event;
+                    timer.priority = priority;
+                    timer.method = method;
+                    event->__ref();
+                    ++_scheduledCount;
+                    PlaceOverflowing(index);
+                    return EventTimerHandle{index, timer.generation};
+                }
+
+                /*
+                 * Removes a timer that has not fired yet and releases its
+                 * Event. Returns false for a stale or invalid handle.
+                 */
+                bool Cancel(const EventTimerHandle& handle) noexcept {
+                    if (
+                        handle.Index >= _timers.size() ||
+                        _timers[handle.Index].generation != handle.Generation ||
+                        _timers[handle.Index].list == None
+                    ) {
+                        return false;
+                    }
+                    Unlink(handle.Index);
+                    IEvent* event = _timers[handle.Index].event;
+                    Free(handle.Index);
+                    event->__unref();
+                    return true;
+                }
+
+                /*
+                 * Advances the wheel to nowNanoseconds and calls
+                 * fire(IEvent*, EventPriority, EventDispatchMethod) for
+                 * every timer now due, earliest tick first. The wheel
+                 * releases its reference once fire returns, so fire must
+                 * take its own (queueing does). If fire throws, that timer
+                 * and any later ones stay due. Returns the number fired.
+                 */
+                template<typename TFire>
+                size_t Advance(uint64_t nowNanoseconds, TFire&& fire) {
+                    const uint64_t targetTick = nowNanoseconds / _tickNanoseconds;
+                    size_t fired = FireDue(fire);
+                    while (_currentTick < targetTick) {
+                        if (_scheduledCount == 0) {
+                            _currentTick = targetTick;
+                            break;
+                        }
+                        const uint64_t tick = NextWorkTick();
+                        if (tick > targetTick) {
+                            _currentTick = targetTick;
+                            break;
+                        }
+                        StepTo(tick);
+                        fired += FireDue(fire);
+                    }
+                    return fired;
+                }
+
+                /*
+                 * Earliest time at which Advance() may have work, for
+                 * sleeping until then. May be earlier than the next
+                 * deadline when timers only need to move down a level.
+                 * UINT64_MAX when nothing is scheduled.
+                 */
+                uint64_t GetNextWakeNanoseconds() const noexcept {
+                    if (_scheduledCount == 0) {
+                        return std::numeric_limits<uint64_t>::max();
+                    }
+                    if (_lists[DueList].head != None) {
+                        return _currentTick * _tickNanoseconds;
+                    }
+                    const uint64_t tick = NextWorkTick();
+                    return tick >
+                        std::numeric_limits<uint64_t>::max() / _tickNanoseconds
+                        ? std::numeric_limits<uint64_t>::max()
+                        : tick * _tickNanoseconds;
+                }
+
+                // Releases every scheduled Event without firing it
+                void Clear() noexcept {
+                    for (uint32_t index = 0; index < _timers.size(); ++index) {
+                        if (_timers[index].list != None) {
+                            _timers[index].list = None;
+                            IEvent* event = _timers[index].event;
+                            Free(index);
+                            event->__unref();
+                        }
+                    }
+                    _lists.fill(TimerList{});
+                    _occupiedSlots.fill(0);
+                }
+        };
+
+    }
+
+}
@@ -31,6 +31,7 @@
 #include "ESPressio_EventManager.hpp"
 #include "ESPressio_EventTransportManagerObservable.hpp"
 #include "ESPressio_EventTransportTypes.hpp"
+#include "ESPressio_EventTypeID.hpp"
 #include "ESPressio_IEventManagerObserver.hpp"
 #include "ESPressio_IEventTransport.hpp"
 #include "ESPressio_SerializableEventDescriptor.hpp"
@@ -56,6 +57,7 @@ private:
         std::string_view TypeName{};
         uint32_t SchemaVersion = 1;
         std::type_index RuntimeType = std::type_index(typeid(void));
+        EventTypeID RuntimeTypeID = 0;
         EventTransportDirection DefaultDirection = EventTransportDirection::None;
         std::unordered_map<IEventTransport*, EventTransportDirection>
             TransportDirections;
@@ -107,8 +109,15 @@ private:
     };
 
     mutable std::mutex _mutex;
+    std::mutex _interestMutex;
     std::unordered_map<uint64_t, Registration> _registrations;
-    std::unordered_map<std::type_index, uint64_t> _runtimeTypes;
+    struct RuntimeTypeRoute {
+        bool Registered = false;
+        uint64_t TypeID = 0;
+    };
+
+    // Indexed by EventTypeID, so outbound routing needs no hash lookup.
+    std::vector<RuntimeTypeRoute> _runtimeTypes;
     std::vector<IEventTransport*> _transports;
     std::deque<OutboundWork> _outbound;
     std::deque<InboundWork> _inbound;
@@ -124,6 +133,44 @@ private:
         SetCoreID(ESPRESSIO_EVENT_TRANSPORT_MANAGER_CORE_ID);
     }
 
+    // The caller syncs observer interest once _mutex is released.
+    void MapRuntimeTypeLocked(EventTypeID runtimeType, uint64_t typeID) {
+        if (runtimeType >= _runtimeTypes.size()) {
+            _runtimeTypes.resize(runtimeType + 1);
+        }
+        _runtimeTypes[runtimeType] = RuntimeTypeRoute{true, typeID};
+    }
+
+    /*
+     * Declares or withdraws observer interest in runtimeType to match its
+     * current route. Called after _mutex is released, so the EventManager's
+     * interest lock is never taken under it; _interestMutex orders racing
+     * calls so the last one applies the final route.
+     */
+    void SyncRuntimeTypeInterest(EventTypeID runtimeType) {
+        if (runtimeType == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> interestLock(_interestMutex);
+        bool registered = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            registered = runtimeType < _runtimeTypes.size() &&
+                _runtimeTypes[runtimeType].Registered;
+        }
+        if (registered) {
+            EventManager::GetInstance()->DeclareObserverInterest(
+                this,
+                runtimeType
+            );
+        } else {
+            EventManager::GetInstance()->WithdrawObserverInterest(
+                this,
+                runtimeType
+            );
+        }
+    }
+
     static bool ParseEnvelope(
         const uint8_t* data,
         std::size_t size,
@@ -173,10 +220,14 @@ private:
         ) != _transports.end();
     }
 
-    void RemoveRegistrationIfUnusedLocked(uint64_t typeID) {
+    /*
+     * Returns the runtime type whose route was removed, or 0, for the
+     * caller to pass to SyncRuntimeTypeInterest once _mutex is released.
+     */
+    EventTypeID RemoveRegistrationIfUnusedLocked(uint64_t typeID) {
         auto found = _registrations.find(typeID);
         if (found == _registrations.end() || found->second.HasAnyDirection()) {
-            return;
+            return 0;
         }
         /*
          * A registration whose default/overrides are all None may still be a
@@ -187,10 +238,17 @@ private:
             found->second.ConstructFromNode ||
             !found->second.Properties.empty()
         ) {
-            return;
+            return 0;
+        }
+        EventTypeID unmapped = 0;
+        if (found->second.RuntimeTypeID < _runtimeTypes.size()) {
+            if (_runtimeTypes[found->second.RuntimeTypeID].Registered) {
+                unmapped = found->second.RuntimeTypeID;
+            }
+            _runtimeTypes[found->second.RuntimeTypeID] = RuntimeTypeRoute{};
         }
-        _runtimeTypes.erase(found->second.RuntimeType);
         _registrations.erase(found);
+        return unmapped;
     }
 
     void NotifyTransaction(
@@ -556,6 +614,7 @@ private:
         proposed.TypeName = EventTransportTypeTraits<TEvent>::Name;
         proposed.SchemaVersion = TEvent::GetSchemaVersion();
         proposed.RuntimeType = std::type_index(typeid(TEvent));
+        proposed.RuntimeTypeID = EventTypeRegistry::Of<TEvent>();
         proposed.DefaultDirection = defaultDirection;
         proposed.Properties = Serializable::SchemaInspector<TEvent>::Properties();
 
@@ -670,7 +729,7 @@ private:
             auto found = _registrations.find(typeID);
             if (found == _registrations.end()) {
                 _registrations.emplace(typeID, proposed);
-                _runtimeTypes[proposed.RuntimeType] = typeID;
+                MapRuntimeTypeLocked(proposed.RuntimeTypeID, typeID);
                 result = EventTransportRegistrationResult::Registered;
                 after = direction;
             } else if (found->second.RuntimeType != proposed.RuntimeType) {
@@ -691,10 +750,11 @@ private:
                 if (!found->second.ConstructFromNode && proposed.ConstructFromNode) {
                     found->second.ConstructFromNode = proposed.ConstructFromNode;
                 }
-                _runtimeTypes[proposed.RuntimeType] = typeID;
+                MapRuntimeTypeLocked(proposed.RuntimeTypeID, typeID);
                 result = EventTransportRegistrationResult::Updated;
             }
         }
+        SyncRuntimeTypeInterest(proposed.RuntimeTypeID);
 
         if (result == EventTransportRegistrationResult::Registered) {
             _observable->Notify([&](IEventTransportManagerObserver* observer) {
@@ -737,7 +797,7 @@ private:
             if (found == _registrations.end()) {
                 proposed.TransportDirections[transport] = direction;
                 _registrations.emplace(typeID, proposed);
-                _runtimeTypes[proposed.RuntimeType] = typeID;
+                MapRuntimeTypeLocked(proposed.RuntimeTypeID, typeID);
                 after = direction;
                 createdOverride = true;
             } else if (found->second.RuntimeType != proposed.RuntimeType) {
@@ -766,9 +826,10 @@ private:
                 if (!found->second.ConstructFromNode && proposed.ConstructFromNode) {
                     found->second.ConstructFromNode = proposed.ConstructFromNode;
                 }
-                _runtimeTypes[proposed.RuntimeType] = typeID;
+                MapRuntimeTypeLocked(proposed.RuntimeTypeID, typeID);
             }
         }
+        SyncRuntimeTypeInterest(proposed.RuntimeTypeID);
 
         if (createdOverride) {
             _observable->Notify([&](IEventTransportManagerObserver* observer) {
@@ -1236,6 +1297,7 @@ public:
         EventTransportUnregistrationResult result;
         std::vector<OutboundWork> discardedOutbound;
         std::size_t discardedInbound = 0;
+        EventTypeID unmapped = 0;
         {
             std::lock_guard<std::mutex> lock(_mutex);
             auto found = _registrations.find(typeID);
@@ -1261,8 +1323,9 @@ public:
             result = found->second.HasAnyDirection()
                 ? EventTransportUnregistrationResult::Updated
                 : EventTransportUnregistrationResult::Removed;
-            RemoveRegistrationIfUnusedLocked(typeID);
+            unmapped = RemoveRegistrationIfUnusedLocked(typeID);
         }
+        SyncRuntimeTypeInterest(unmapped);
         for (auto& work : discardedOutbound) {
             ReleaseOutbound(work);
         }
@@ -1293,6 +1356,7 @@ public:
             EventTransportUnregistrationResult::NotRegistered;
         std::vector<OutboundWork> discardedOutbound;
         std::size_t discardedInbound = 0;
+        EventTypeID unmapped = 0;
         {
             std::lock_guard<std::mutex> lock(_mutex);
             auto found = _registrations.find(typeID);
@@ -1325,8 +1389,9 @@ public:
                     ? EventTransportUnregistrationResult::Removed
                     : EventTransportUnregistrationResult::Updated)
                 : EventTransportUnregistrationResult::Removed;
-            RemoveRegistrationIfUnusedLocked(typeID);
+            unmapped = RemoveRegistrationIfUnusedLocked(typeID);
         }
+        SyncRuntimeTypeInterest(unmapped);
         for (auto& work : discardedOutbound) {
             ReleaseOutbound(work);
         }
@@ -1399,6 +1464,7 @@ public:
             EventTransportDirection after = EventTransportDirection::None;
             std::vector<OutboundWork> discardedOutbound;
             std::size_t discardedInbound = 0;
+            EventTypeID unmapped = 0;
             bool changed = false;
             {
                 std::lock_guard<std::mutex> lock(_mutex);
@@ -1423,9 +1489,10 @@ public:
                         discardedOutbound, discardedInbound
                     );
                 }
-                RemoveRegistrationIfUnusedLocked(typeID);
+                unmapped = RemoveRegistrationIfUnusedLocked(typeID);
                 changed = true;
             }
+            SyncRuntimeTypeInterest(unmapped);
             for (auto& work : discardedOutbound) {
                 ReleaseOutbound(work);
             }
@@ -1464,6 +1531,7 @@ public:
             EventTransportDirection after = EventTransportDirection::None;
             std::vector<OutboundWork> discardedOutbound;
             std::size_t discardedInbound = 0;
+            EventTypeID unmapped = 0;
             bool changed = false;
             {
                 std::lock_guard<std::mutex> lock(_mutex);
@@ -1491,9 +1559,10 @@ public:
                 ) {
                     found->second.TransportDirections.erase(transport);
                 }
-                RemoveRegistrationIfUnusedLocked(typeID);
+                unmapped = RemoveRegistrationIfUnusedLocked(typeID);
                 changed = true;
             }
+            SyncRuntimeTypeInterest(unmapped);
             for (auto& work : discardedOutbound) {
                 ReleaseOutbound(work);
             }
@@ -1560,6 +1629,11 @@ public:
         _observable->UnregisterObserver(observer);
     }
 
+    // Only registered runtime types are transported
+    bool DeclaresEventTypeInterest() const override {
+        return true;
+    }
+
     void OnEventDispatched(
         IEvent* event,
         EventDispatchMethod method,
@@ -1581,11 +1655,15 @@ public:
 
         {
             std::lock_guard<std::mutex> lock(_mutex);
-            auto runtime = _runtimeTypes.find(std::type_index(typeid(*event)));
-            if (runtime == _runtimeTypes.end()) {
+            const EventTypeID runtimeType = event->GetEventTypeID();
+            if (
+                runtimeType >= _runtimeTypes.size() ||
+                !_runtimeTypes[runtimeType].Registered
+            ) {
                 return;
             }
-            auto registration = _registrations.find(runtime->second);
+            auto registration =
+                _registrations.find(_runtimeTypes[runtimeType].TypeID);
             if (registration == _registrations.end()) {
                 return;
             }
@@ -1600,7 +1678,7 @@ public:
             if (targetTransports.empty()) {
                 return;
             }
-            typeID = runtime->second;
+            typeID = _runtimeTypes[runtimeType].TypeID;
             messageID = _nextMessageID.fetch_add(1);
             registrationSnapshot = registration->second;
             for (IEventTransport* transport : targetTransports) {
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Slots in the lock-free type_info -> EventTypeID cache consulted when an
+ * Event instance first needs its ID. A power of two; types beyond it still
+ * resolve correctly, through the registry lock.
+ */
+#ifndef ESPRESSIO_EVENT_TYPE_ID_CACHE_SIZE
+    #define ESPRESSIO_EVENT_TYPE_ID_CACHE_SIZE 256
+#endif
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Dense process-wide identifier of a concrete Event type.
+         *
+         * IDs are assigned from 1 in order of first use and never reused, so
+         * routing tables can index flat arrays by them. Zero never names a
+         * type. IDs are not stable across runs; use EventTransportTypeID for
+         * anything that leaves the process.
+         */
+        using EventTypeID = uint32_t;
+
+
+        class EventTypeRegistry {
+            private:
+                static constexpr size_t CacheSize =
+                    ESPRESSIO_EVENT_TYPE_ID_CACHE_SIZE;
+
+                static_assert(
+                    CacheSize != 0 && (CacheSize & (CacheSize - 1)) == 0,
+                    "ESPRESSIO_EVENT_TYPE_ID_CACHE_SIZE must be a power of two"
+                );
+
+                /*
+                 * Written once under the registry lock, id before type, and
+                 * never cleared, so readers probe without locking.
+                 */
+                struct CacheEntry {
+                    std::atomic<const std::type_info*> type{nullptr};
+                    std::atomic<EventTypeID> id{0};
+                };
+
+                struct State {
+                    std::mutex mutex;
+                    std::unordered_map<
+                        std::type_index,
+                        EventTypeID
+                    > ids;
+                    std::vector<std::type_index> types;
+                    CacheEntry cache[CacheSize];
+                    std::atomic<uint64_t> lockedResolveCount{0};
+                };
+
+                static State& GetState() {
+                    static State state;
+                    return state;
+                }
+
+                static size_t GetCacheSlot(const std::type_info& type) {
+                    const uintptr_t address =
+                        reinterpret_cast<uintptr_t>(&type);
+                    return static_cast<size_t>(
+                        (address >> 4) * UINT64_C(0x9E3779B97F4A7C15) >> 32
+                    ) & (CacheSize - 1);
+                }
+
+                static EventTypeID FindCached(
+                    State& state,
+                    const std::type_info& type
+                ) {
+                    size_t slot = GetCacheSlot(type);
+                    for (size_t probe = 0; probe < CacheSize; ++probe) {
+                        CacheEntry& entry = state.cache[slot];
+                        const std::type_info* cached =
+                            entry.type.load(std::memory_order_acquire);
+                        if (cached == &type) {
+                            return entry.id.load(std::memory_order_relaxed);
+                        }
+                        if (cached == nullptr) {
+                            return 0;
+                        }
+                        slot = (slot + 1) & (CacheSize - 1);
+                    }
+                    return 0;
+                }
+
+                // Called with the registry lock held
+                static void CacheLocked(
+                    State& state,
+                    const std::type_info& type,
+                    EventTypeID id
+                ) {
+                    size_t slot = GetCacheSlot(type);
+                    for (size_t probe = 0; probe < CacheSize; ++probe) {
+                        CacheEntry& entry = state.cache[slot];
+                        const std::type_info* cached =
+                            entry.type.load(std::memory_order_relaxed);
+                        if (cached == &type) {
+                            return;
+                        }
+                        if (cached == nullptr) {
+                            entry.id.store(id, std::memory_order_relaxed);
+                            entry.type.store(&type, std::memory_order_release);
+                            return;
+                        }
+                        slot = (slot + 1) & (CacheSize - 1);
+                    }
+                }
+
+            public:
+                /*
+                 * As Resolve(std::type_index), but a type seen before is
+                 * found in a lock-free cache keyed by its type_info. This
+                 * is the path every new Event instance takes.
+                 */
+                static EventTypeID Resolve(const std::type_info& type) {
+                    State& state = GetState();
+                    const EventTypeID cached = FindCached(state, type);
+                    if (cached != 0) {
+                        return cached;
+                    }
+                    const EventTypeID id = Resolve(std::type_index(type));
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    CacheLocked(state, type, id);
+                    return id;
+                }
+
+                /*
+                 * Returns the ID of type, assigning the next one on first
+                 * use. Takes a lock; hot paths use Of<T>() or the ID cached
+                 * in each Event instead.
+                 */
+                static EventTypeID Resolve(std::type_index type) {
+                    State& state = GetState();
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.lockedResolveCount.fetch_add(
+                        1,
+                        std::memory_order_relaxed
+                    );
+                    const auto found = state.ids.find(type);
+                    if (found != state.ids.end()) {
+                        return found->second;
+                    }
+                    state.types.push_back(type);
+                    const EventTypeID id =
+                        static_cast<EventTypeID>(state.types.size());
+                    state.ids.emplace(type, id);
+                    return id;
+                }
+
+                template<typename TEvent>
+                static EventTypeID Of() {
+                    static const EventTypeID id = Resolve(typeid(TEvent));
+                    return id;
+                }
+
+                /*
+                 * The type an ID was assigned to, or typeid(void) for an ID
+                 * that has not been assigned.
+                 */
+                static std::type_index TypeOf(EventTypeID id) {
+                    State& state = GetState();
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    return id == 0 || id > state.types.size()
+                        ? std::type_index(typeid(void))
+                        : state.types[id - 1];
+                }
+
+                static size_t GetCount() {
+                    State& state = GetState();
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    return state.types.size();
+                }
+
+                // Resolutions that had to take the registry lock
+                static uint64_t GetLockedResolveCount() {
+                    return GetState().lockedResolveCount.load(
+                        std::memory_order_relaxed
+                    );
+                }
+        };
+
+    }
+
+}
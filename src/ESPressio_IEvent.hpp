@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <typeinfo>
 
 #include <ESPressio_ClockTypes.hpp>
 
 #include "ESPressio_EventEnums.hpp"
 #include "ESPressio_EventTransportTypes.hpp"
+#include "ESPressio_EventTypeID.hpp"
 
 namespace ESPressio {
 
@@ -19,6 +22,9 @@ namespace ESPressio {
             Timing::DefaultClockTime;
 
 
+        class EventManager;
+
+
         /*
          * Type-erased Event engine contract.
          *
@@ -27,9 +33,37 @@ namespace ESPressio {
          * remain independent of the selected Event<TTime> representation.
          */
         class IEvent {
+            private:
+                mutable std::atomic<EventTypeID> _eventTypeID{0};
+
             public:
+                IEvent() = default;
+
+                /*
+                 * A copy may have a different dynamic type than its source,
+                 * so the cached type ID is never copied.
+                 */
+                IEvent(const IEvent&) noexcept { }
+                IEvent& operator=(const IEvent&) noexcept { return *this; }
+
                 virtual ~IEvent() = default;
 
+                /*
+                 * Dense ID of this Event's dynamic type, cached in the
+                 * Event. A new instance finds its type's ID in the
+                 * registry's lock-free type_info cache; only the first
+                 * Event of a type ever takes the registry lock.
+                 */
+                EventTypeID GetEventTypeID() const {
+                    EventTypeID id =
+                        _eventTypeID.load(std::memory_order_relaxed);
+                    if (id == 0) {
+                        id = EventTypeRegistry::Resolve(typeid(*this));
+                        _eventTypeID.store(id, std::memory_order_relaxed);
+                    }
+                    return id;
+                }
+
                 // Engine Methods
                 virtual void __ref() noexcept = 0;
                 virtual void __unref() noexcept = 0;
@@ -48,6 +82,40 @@ namespace ESPressio {
                         EventPriority::Normal
                 ) = 0;
 
+                /*
+                 * Coalescing key used by receivers configured with
+                 * EventCoalescingPolicy::LatestValueWins. State-snapshot
+                 * Events return true and set key; a newer pending Event of
+                 * the same type and key then replaces this one. Must be cheap
+                 * and must not call back into the receiver.
+                 */
+                virtual bool GetCoalescingKey(uint64_t& key) const {
+                    (void)key;
+                    return false;
+                }
+
+                /*
+                 * Routing key for keyed subscriptions, such as a device ID
+                 * or channel. Events returning true and setting key reach
+                 * the listeners and receivers subscribed to their type and
+                 * that key, found through a hash index rather than a
+                 * predicate per listener. Must be cheap and must not call
+                 * back into the dispatcher.
+                 */
+                virtual bool GetRoutingKey(uint64_t& key) const {
+                    (void)key;
+                    return false;
+                }
+
+                /*
+                 * Event bus this Event is queued on, including when the
+                 * EventScheduler or PeriodicEventSource queues it. nullptr
+                 * selects the default bus, EventManager::GetInstance().
+                 */
+                virtual EventManager* GetEventBus() const {
+                    return nullptr;
+                }
+
                 /*
                  * Type-erased lifecycle timing for Event infrastructure.
                  *
@@ -59,8 +127,33 @@ namespace ESPressio {
 
                 virtual uint64_t
                 GetTimeSinceDispatchNanoseconds() const = 0;
+
+                /*
+                 * Time-to-live measured from the dispatch time. Receivers
+                 * release an Event whose TTL has passed when they drain it,
+                 * without invoking any callback. Zero means the Event never
+                 * expires.
+                 */
+                virtual uint64_t
+                GetTimeToLiveNanoseconds() const {
+                    return 0;
+                }
         };
 
+
+        /*
+         * Tests whether an Event's dynamic type is, or derives from, a
+         * subscribed base type. Polymorphic subscriptions evaluate it once
+         * per concrete Event type and cache the outcome.
+         */
+        using EventTypeMatcher =
+            bool (*)(const IEvent*);
+
+        template<typename TEvent>
+        bool IsEventOfType(const IEvent* event) {
+            return dynamic_cast<const TEvent*>(event) != nullptr;
+        }
+
     }
 
 }
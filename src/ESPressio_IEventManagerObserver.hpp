@@ -1,14 +1,47 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 #include <ESPressio_IObserver.hpp>
 #include "ESPressio_EventTransportTypes.hpp"
 #include "ESPressio_IEvent.hpp"
 
 namespace ESPressio::Event {
 
+class EventManager;
+
 class IEventManagerObserver : public virtual Observable::IObserver {
+private:
+    friend class EventManager;
+
+    /*
+     * Interest mask bit the EventManagers assigned this observer, shared by
+     * every bus it is registered with, and how many of them hold it. Zero
+     * means notified of every type. Not copied with the observer.
+     */
+    struct EventTypeInterestSlot {
+        std::atomic<uint32_t> bit{0};
+        size_t holders = 0;
+
+        EventTypeInterestSlot() = default;
+        EventTypeInterestSlot(const EventTypeInterestSlot&) {}
+        EventTypeInterestSlot& operator=(const EventTypeInterestSlot&) {
+            return *this;
+        }
+    } _eventTypeInterestSlot;
+
 public:
     virtual ~IEventManagerObserver() = default;
+
+    /*
+     * Observers returning true are only notified of Event types declared
+     * through EventManager::DeclareObserverInterest(), so the EventManager
+     * can skip notification for every other type.
+     */
+    virtual bool DeclaresEventTypeInterest() const { return false; }
+
     virtual void OnEventDispatched(
         IEvent*,
         EventDispatchMethod,
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventEnums.hpp"
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Passed to an emitter's factory for each emission. ScheduledNanoseconds
+         * is the cadence point being emitted; MissedTicks counts cadence
+         * points skipped since the previous emission because the source ran
+         * too late to emit them.
+         */
+        struct PeriodicEventTick {
+            uint64_t ScheduledNanoseconds = 0;
+            uint64_t LatenessNanoseconds = 0;
+            uint32_t MissedTicks = 0;
+        };
+
+        struct PeriodicEventStatistics {
+            uint64_t EmittedTickCount = 0;
+            uint64_t MissedTickCount = 0;
+            uint64_t LateTickCount = 0;
+            uint64_t MaximumLatenessNanoseconds = 0;
+        };
+
+        struct PeriodicEventHandle {
+            uint32_t Index = std::numeric_limits<uint32_t>::max();
+            uint32_t Generation = 0;
+
+            bool IsValid() const noexcept {
+                return Index != std::numeric_limits<uint32_t>::max();
+            }
+        };
+
+        struct PeriodicEventEmission {
+            IEvent* Event;
+            EventPriority Priority;
+            EventDispatchMethod Method;
+        };
+
+        /*
+         * Cadence bookkeeping for many periodic emitters sharing one thread.
+         *
+         * Each emitter's n-th tick is due at start + n * period, so late
+         * wake-ups never accumulate drift. When the source wakes more than a
+         * period late it emits once for the latest passed tick and reports
+         * the earlier ones as missed rather than emitting a burst. A tick
+         * emitted more than the late tolerance after its cadence point is
+         * counted late. Due ticks are kept in a min-heap; removed emitters
+         * leave a stale heap entry that is dropped when it surfaces.
+         *
+         * Not thread-safe; PeriodicEventSource serialises access.
+         */
+        class PeriodicEventSchedule {
+            public:
+                using Factory = std::function<IEvent*(const PeriodicEventTick&)>;
+
+            private:
+                struct Emitter {
+                    uint64_t start = 0;
+                    uint64_t period = 0;
+                    uint64_t tick = 0;
+                    uint32_t generation = 0;
+                    bool active = false;
+                    EventPriority priority = EventPriority::Normal;
+                    EventDispatchMethod method = EventDispatchMethod::Queue;
+                    Factory factory;
+                    PeriodicEventStatistics statistics{};
+                };
+
+                struct Due {
+                    uint64_t time;
+                    uint32_t index;
+                    uint32_t generation;
+
+                    bool operator>(const Due& other) const noexcept {
+                        return time != other.time
+                            ? time > other.time
+                            : index > other.index;
+                    }
+                };
+
+                std::vector<Emitter> _emitters;
+                std::vector<uint32_t> _freeEmitters;
+                std::priority_queue<Due, std::vector<Due>, std::greater<Due>> _due;
+                size_t _emitterCount = 0;
+                uint64_t _lateToleranceNanoseconds;
+                PeriodicEventStatistics _statistics{};
+
+                static uint64_t DueTime(const Emitter& emitter) noexcept {
+                    return emitter.start + emitter.tick * emitter.period;
+                }
+
+                // Drops heap entries left behind by removed emitters
+                void DropStale() {
+                    while (!_due.empty()) {
+                        const Due& top = _due.top();
+                        const Emitter& emitter = _emitters[top.index];
+                        if (emitter.active && emitter.generation == top.generation) {
+                            return;
+                        }
+                        _due.pop();
+                    }
+                }
+
+                static void Record(
+                    PeriodicEventStatistics& statistics,
+                    uint32_t missed,
+                    uint64_t lateness,
+                    bool late
+                ) noexcept {
+                    ++statistics.EmittedTickCount;
+                    statistics.MissedTickCount += missed;
+                    statistics.LateTickCount += late ? 1 : 0;
+                    if (lateness > statistics.MaximumLatenessNanoseconds) {
+                        statistics.MaximumLatenessNanoseconds = lateness;
+                    }
+                }
+
+            public:
+                explicit PeriodicEventSchedule(uint64_t lateToleranceNanoseconds = 0) :
+                    _lateToleranceNanoseconds(lateToleranceNanoseconds) {
+                }
+
+                /*
+                 * Adds an emitter whose first tick is due at
+                 * startNanoseconds and every periodNanoseconds after it.
+                 * factory creates each Event; returning nullptr skips that
+                 * emission. Returns an invalid handle for a zero period or
+                 * an empty factory.
+                 */
+                PeriodicEventHandle Add(
+                    uint64_t startNanoseconds,
+                    uint64_t periodNanoseconds,
+                    Factory factory,
+                    EventPriority priority = EventPriority::Normal,
+                    EventDispatchMethod method = EventDispatchMethod::Queue
+                ) {
+                    if (periodNanoseconds == 0 || !factory) {
+                        return PeriodicEventHandle{};
+                    }
+                    uint32_t index;
+                    if (_freeEmitters.empty()) {
+                        _emitters.emplace_back();
+                        index = static_cast<uint32_t>(_emitters.size() - 1);
+                    } else {
+                        index = _freeEmitters.back();
+                        _freeEmitters.pop_back();
+                    }
+                    Emitter& emitter = _emitters[index];
+                    emitter.start = startNanoseconds;
+                    emitter.period = periodNanoseconds;
+                    emitter.tick = 0;
+                    emitter.active = true;
+                    emitter.priority = priority;
+                    emitter.method = method;
+                    emitter.factory = std::move(factory);
+                    emitter.statistics = PeriodicEventStatistics{};
+                    _due.push(Due{startNanoseconds, index, emitter.generation});
+                    ++_emitterCount;
+                    return PeriodicEventHandle{index, emitter.generation};
+                }
+
+                bool Remove(const PeriodicEventHandle& handle) {
+                    if (!IsActive(handle)) {
+                        return false;
+                    }
+                    Emitter& emitter = _emitters[handle.Index];
+                    emitter.active = false;
+                    ++emitter.generation;
+                    emitter.factory = nullptr;
+                    _freeEmitters.push_back(handle.Index);
+                    --_emitterCount;
+                    DropStale();
+                    return true;
+                }
+
+                bool IsActive(const PeriodicEventHandle& handle) const noexcept {
+                    return
+                        handle.Index < _emitters.size() &&
+                        _emitters[handle.Index].active &&
+                        _emitters[handle.Index].generation == handle.Generation;
+                }
+
+                size_t GetEmitterCount() const noexcept { return _emitterCount; }
+
+                void SetLateToleranceNanoseconds(uint64_t tolerance) noexcept {
+                    _lateToleranceNanoseconds = tolerance;
+                }
+
+                uint64_t GetLateToleranceNanoseconds() const noexcept {
+                    return _lateToleranceNanoseconds;
+                }
+
+                // UINT64_MAX when no emitter is active
+                uint64_t GetNextDueNanoseconds() const noexcept {
+                    return _due.empty()
+                        ? std::numeric_limits<uint64_t>::max()
+                        : _due.top().time;
+                }
+
+                bool GetStatistics(
+                    const PeriodicEventHandle& handle,
+                    PeriodicEventStatistics& statistics
+                ) const noexcept {
+                    if (!IsActive(handle)) {
+                        return false;
+                    }
+                    statistics = _emitters[handle.Index].statistics;
+                    return true;
+                }
+
+                PeriodicEventStatistics GetStatistics() const noexcept {
+                    return _statistics;
+                }
+
+                /*
+                 * Emits every tick due at or before nowNanoseconds, earliest
+                 * first, appending the created Events to emissions. Each
+                 * emitter emits at most once per call. Factories run here
+                 * and must not add or remove emitters. Returns the number
+                 * of Events appended.
+                 */
+                size_t Poll(
+                    uint64_t nowNanoseconds,
+                    std::vector<PeriodicEventEmission>& emissions
+                ) {
+                    const size_t initialSize = emissions.size();
+                    DropStale();
+                    while (!_due.empty() && _due.top().time <= nowNanoseconds) {
+                        const uint32_t index = _due.top().index;
+                        _due.pop();
+                        Emitter& emitter = _emitters[index];
+
+                        const uint64_t behind = nowNanoseconds - DueTime(emitter);
+                        const uint64_t missed = behind / emitter.period;
+                        emitter.tick += missed;
+
+                        PeriodicEventTick tick;
+                        tick.ScheduledNanoseconds = DueTime(emitter);
+                        tick.LatenessNanoseconds = nowNanoseconds - tick.ScheduledNanoseconds;
+                        tick.MissedTicks = missed > std::numeric_limits<uint32_t>::max()
+                            ? std::numeric_limits<uint32_t>::max()
+                            : static_cast<uint32_t>(missed);
+                        const bool late = tick.LatenessNanoseconds > _lateToleranceNanoseconds;
+                        Record(emitter.statistics, tick.MissedTicks, tick.LatenessNanoseconds, late);
+                        Record(_statistics, tick.MissedTicks, tick.LatenessNanoseconds, late);
+
+                        ++emitter.tick;
+                        _due.push(Due{DueTime(emitter), index, emitter.generation});
+
+                        if (IEvent* event = emitter.factory(tick)) {
+                            emissions.push_back(
+                                PeriodicEventEmission{event, emitter.priority, emitter.method}
+                            );
+                        }
+                        DropStale();
+                    }
+                    return emissions.size() - initialSize;
+                }
+        };
+
+    }
+
+}
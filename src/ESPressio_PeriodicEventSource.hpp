@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ESPressio_Thread.hpp>
+#include <ESPressio_TimeTraits.hpp>
+
+#include "ESPressio_IEvent.hpp"
+#include "ESPressio_EventClock.hpp"
+#include "ESPressio_EventEnums.hpp"
+#include "ESPressio_EventManager.hpp"
+#include "ESPressio_EventSimulation.hpp"
+#include "ESPressio_EventSpan.hpp"
+#include "ESPressio_PeriodicEventSchedule.hpp"
+
+#ifndef ESPRESSIO_PERIODIC_EVENT_SOURCE_PRIORITY
+    #define ESPRESSIO_PERIODIC_EVENT_SOURCE_PRIORITY ESPRESSIO_EVENT_MANAGER_PRIORITY
+#endif
+
+#ifndef ESPRESSIO_PERIODIC_EVENT_SOURCE_CORE_ID
+    #define ESPRESSIO_PERIODIC_EVENT_SOURCE_CORE_ID ESPRESSIO_EVENT_MANAGER_CORE_ID
+#endif
+
+/*
+ * Wake-up granularity of the PeriodicEventSource. Emitters falling due
+ * within the same tick are emitted on one wake-up and queued together. It
+ * is also the default late tolerance.
+ */
+#ifndef ESPRESSIO_PERIODIC_EVENT_SOURCE_TICK_NANOSECONDS
+    #define ESPRESSIO_PERIODIC_EVENT_SOURCE_TICK_NANOSECONDS 1000000ULL
+#endif
+
+using namespace ESPressio::Threads;
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * One Thread emitting Events for any number of periodic emitters.
+         *
+         * Cadence follows PeriodicEventSchedule: tick n of an emitter is due
+         * at start + n * period on the System Clock, however late earlier
+         * ticks were. The Thread sleeps until the next due tick, rounded up
+         * to ESPRESSIO_PERIODIC_EVENT_SOURCE_TICK_NANOSECONDS, and hands
+         * every Event created on that wake-up to the EventManager with one
+         * batch enqueue per bus, priority and dispatch method.
+         */
+        class PeriodicEventSource :
+            public Thread
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
+            private:
+                std::mutex _mutex;
+                std::condition_variable _wake;
+                PeriodicEventSchedule _schedule{
+                    ESPRESSIO_PERIODIC_EVENT_SOURCE_TICK_NANOSECONDS
+                };
+
+                uint64_t _wakeNanoseconds =
+                    std::numeric_limits<uint64_t>::max();
+
+                std::vector<PeriodicEventEmission> _emissions;
+
+                /*
+                 * One bus/priority/method run of Events being enqueued.
+                 * Only Deliver touches it, on this Thread or simulation
+                 * step, so its capacity is reused without a lock.
+                 */
+                std::vector<IEvent*> _batch;
+
+                static uint64_t GetNowNanoseconds() {
+                    return EventClock::GetNowNanoseconds();
+                }
+
+                static uint64_t RoundUpToTick(uint64_t time) {
+                    const uint64_t tick =
+                        ESPRESSIO_PERIODIC_EVENT_SOURCE_TICK_NANOSECONDS;
+                    const uint64_t remainder = time % tick;
+
+                    return
+                        remainder == 0 ||
+                        time > std::numeric_limits<uint64_t>::max() - tick
+                            ? time
+                            : time + (tick - remainder);
+                }
+
+                static EventManager* GetBus(
+                    const PeriodicEventEmission& emission
+                ) {
+                    EventManager* bus = emission.Event->GetEventBus();
+                    return bus == nullptr ? EventManager::GetInstance() : bus;
+                }
+
+                static bool DeliversBefore(
+                    const PeriodicEventEmission& first,
+                    const PeriodicEventEmission& second
+                ) {
+                    if (first.Method != second.Method) {
+                        return first.Method < second.Method;
+                    }
+                    if (first.Priority != second.Priority) {
+                        return first.Priority > second.Priority;
+                    }
+                    return std::less<EventManager*>()(
+                        GetBus(first),
+                        GetBus(second)
+                    );
+                }
+
+                void Deliver(
+                    std::vector<PeriodicEventEmission>& emissions
+                ) {
+                    std::stable_sort(
+                        emissions.begin(),
+                        emissions.end(),
+                        DeliversBefore
+                    );
+
+                    _batch.reserve(emissions.size());
+
+                    size_t index = 0;
+                    while (index < emissions.size()) {
+                        EventManager* bus =
+                            GetBus(emissions[index]);
+                        const EventPriority priority =
+                            emissions[index].Priority;
+                        const EventDispatchMethod method =
+                            emissions[index].Method;
+
+                        _batch.clear();
+                        while (
+                            index < emissions.size() &&
+                            GetBus(emissions[index]) == bus &&
+                            emissions[index].Priority == priority &&
+                            emissions[index].Method == method
+                        ) {
+                            _batch.push_back(emissions[index++].Event);
+                        }
+
+                        if (method == EventDispatchMethod::Stack) {
+                            bus->StackEvents(
+                                EventSpan(_batch.data(), _batch.size()),
+                                priority
+                            );
+                        } else {
+                            bus->QueueEvents(
+                                EventSpan(_batch.data(), _batch.size()),
+                                priority
+                            );
+                        }
+                    }
+
+                    _batch.clear();
+                }
+
+                /*
+                 * Emits every tick now due. Returns false, still holding
+                 * the lock, when no Event was created.
+                 */
+                bool EmitDueLocked(
+                    std::unique_lock<std::mutex>& lock
+                ) {
+                    _emissions.clear();
+                    _schedule.Poll(
+                        GetNowNanoseconds(),
+                        _emissions
+                    );
+
+                    if (_emissions.empty()) {
+                        return false;
+                    }
+
+                    std::vector<PeriodicEventEmission> emissions;
+                    emissions.swap(_emissions);
+                    lock.unlock();
+
+                    Deliver(emissions);
+
+                    emissions.clear();
+                    lock.lock();
+                    if (_emissions.capacity() < emissions.capacity()) {
+                        _emissions.swap(emissions);
+                    }
+                    return true;
+                }
+
+            protected:
+                PeriodicEventSource() : Thread(true) {
+                    SetPriority(
+                        ESPRESSIO_PERIODIC_EVENT_SOURCE_PRIORITY
+                    );
+                    SetCoreID(
+                        ESPRESSIO_PERIODIC_EVENT_SOURCE_CORE_ID
+                    );
+#if !ESPRESSIO_EVENT_SIMULATION
+                    Initialize();
+                    Start();
+#endif
+                }
+
+                void OnLoop() override {
+                    std::unique_lock<std::mutex> lock(_mutex);
+
+                    if (EmitDueLocked(lock)) {
+                        return;
+                    }
+
+                    _wakeNanoseconds =
+                        RoundUpToTick(
+                            _schedule.GetNextDueNanoseconds()
+                        );
+                    if (
+                        _wakeNanoseconds ==
+                        std::numeric_limits<uint64_t>::max()
+                    ) {
+                        _wake.wait(lock);
+                    } else {
+                        const uint64_t now = GetNowNanoseconds();
+                        if (_wakeNanoseconds > now) {
+                            _wake.wait_for(
+                                lock,
+                                std::chrono::nanoseconds(
+                                    _wakeNanoseconds - now
+                                )
+                            );
+                        }
+                    }
+                    _wakeNanoseconds = 0;
+                }
+
+            public:
+                static PeriodicEventSource* GetInstance() {
+                    static PeriodicEventSource* instance =
+                        new PeriodicEventSource();
+                    return instance;
+                }
+
+                /*
+                 * Emits factory(tick) every periodNanoseconds, first one
+                 * period from now. factory runs on the source Thread, must
+                 * not add or remove emitters, and may return nullptr to
+                 * skip a tick.
+                 */
+                PeriodicEventHandle AddEmitter(
+                    uint64_t periodNanoseconds,
+                    PeriodicEventSchedule::Factory factory,
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue
+                ) {
+                    const uint64_t now = GetNowNanoseconds();
+
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    const PeriodicEventHandle handle =
+                        _schedule.Add(
+                            now + periodNanoseconds,
+                            periodNanoseconds,
+                            std::move(factory),
+                            priority,
+                            method
+                        );
+
+                    const uint64_t wake =
+                        RoundUpToTick(
+                            _schedule.GetNextDueNanoseconds()
+                        );
+
+                    if (wake < _wakeNanoseconds) {
+                        _wakeNanoseconds = wake;
+                        _wake.notify_one();
+                    }
+
+                    return handle;
+                }
+
+                template<
+                    typename TTime,
+                    typename = std::enable_if_t<
+                        !std::is_integral<TTime>::value
+                    >
+                >
+                PeriodicEventHandle AddEmitter(
+                    TTime period,
+                    PeriodicEventSchedule::Factory factory,
+                    EventPriority priority =
+                        EventPriority::Normal,
+                    EventDispatchMethod method =
+                        EventDispatchMethod::Queue
+                ) {
+                    return
+                        AddEmitter(
+                            Timing::TimeTraits<
+                                TTime
+                            >::template
+                                ToNanoseconds<
+                                    uint64_t
+                                >(
+                                    period
+                                ),
+                            std::move(factory),
+                            priority,
+                            method
+                        );
+                }
+
+                /*
+                 * Stops an emitter. An Event it created on a wake-up in
+                 * progress may still be queued.
+                 */
+                bool RemoveEmitter(
+                    const PeriodicEventHandle& handle
+                ) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _schedule.Remove(handle);
+                }
+
+                /*
+                 * Emissions, missed ticks, late ticks (emitted more than
+                 * the late tolerance after their cadence point) and the
+                 * worst lateness of one emitter.
+                 */
+                bool GetEmitterStatistics(
+                    const PeriodicEventHandle& handle,
+                    PeriodicEventStatistics& statistics
+                ) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _schedule.GetStatistics(handle, statistics);
+                }
+
+                PeriodicEventStatistics GetStatistics() {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _schedule.GetStatistics();
+                }
+
+                void SetLateToleranceNanoseconds(uint64_t tolerance) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _schedule.SetLateToleranceNanoseconds(tolerance);
+                }
+
+#if ESPRESSIO_EVENT_SIMULATION
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t
+                ) override {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return
+                        RoundUpToTick(
+                            _schedule.GetNextDueNanoseconds()
+                        );
+                }
+
+                void RunSimulationStep(uint64_t) override {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    EmitDueLocked(lock);
+                }
+#endif
+
+                size_t GetEmitterCount() {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _schedule.GetEmitterCount();
+                }
+        };
+
+    }
+
+}
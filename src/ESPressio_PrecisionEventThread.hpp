@@ -2,16 +2,20 @@
 
 #include <atomic>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <typeindex>
+#include <utility>
 
 #include <ESPressio_PrecisionThread.hpp>
 
 #include "ESPressio_EventListener.hpp"
 #include "ESPressio_EventManager.hpp"
 #include "ESPressio_EventReceiver.hpp"
+#include "ESPressio_EventSimulation.hpp"
 #include "ESPressio_EventThread.hpp"
+#include "ESPressio_StaticEventReceiver.hpp"
 
 namespace ESPressio {
 
@@ -50,7 +54,11 @@ namespace ESPressio {
             public EventReceiver,
             public IEventThreadBase,
             public EventListener,
-            public IEventThread {
+            public IEventThread
+#if ESPRESSIO_EVENT_SIMULATION
+            , public IEventSimulationProcess
+#endif
+            {
 
             private:
                 using PrecisionThreadBase =
@@ -76,6 +84,81 @@ namespace ESPressio {
                 std::atomic<bool>
                     _acceptingEvents{true};
 
+                std::atomic<EventManager*>
+                    _eventBus{nullptr};
+
+                /*
+                 * Set by the first listener registration; the bus can no
+                 * longer change, so unregistration reaches the same bus.
+                 */
+                bool _eventBusLatched = false;
+
+                std::mutex _eventBusMutex;
+
+
+                EventManager* LatchEventBus() {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    _eventBusLatched =
+                        true;
+
+                    return
+                        GetEventBus();
+                }
+
+#if ESPRESSIO_EVENT_SIMULATION
+                /*
+                 * Simulated cadence: iteration n is due at
+                 * _simulationStartNanoseconds + n * period, as a
+                 * PrecisionThread schedules it.
+                 */
+                uint64_t
+                    _simulationPeriodNanoseconds = 0;
+
+                uint64_t
+                    _simulationStartNanoseconds = 0;
+
+                uint64_t
+                    _simulationIteration = 0;
+
+                uint64_t
+                    _simulationLastIterationNanoseconds = 0;
+
+                std::atomic<bool>
+                    _simulationBumped{false};
+
+
+                static typename PrecisionThreadBase::IterationTime
+                CreateSimulationTime(
+                    uint64_t nanoseconds
+                ) {
+                    return
+                        Timing::TimeTraits<
+                            TTime
+                        >::template
+                            FromNanoseconds<
+                                uint64_t
+                            >(
+                                nanoseconds,
+                                1
+                            );
+                }
+
+
+                uint64_t
+                GetSimulationDueNanoseconds()
+                    const noexcept {
+                    return
+                        _simulationStartNanoseconds +
+                        _simulationIteration *
+                            _simulationPeriodNanoseconds;
+                }
+#endif
+
 
                 class LifecycleObserver final :
                     public Threads::
@@ -272,13 +355,22 @@ namespace ESPressio {
                         PrecisionEventArrivalPolicy::
                             TriggerImmediateIteration
                     ) {
+#if ESPRESSIO_EVENT_SIMULATION
+                        _simulationBumped.store(
+                            true,
+                            std::memory_order_release
+                        );
+#else
                         this->Bump();
+#endif
                     } else if (
                         arrivalPolicy ==
                         PrecisionEventArrivalPolicy::
                             ProcessImmediately
                     ) {
+#if !ESPRESSIO_EVENT_SIMULATION
                         this->WakeForWork();
+#endif
                     }
                 }
 
@@ -286,8 +378,7 @@ namespace ESPressio {
                 void OnListenerRegistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    LatchEventBus()->
                         RegisterReceiver(
                             eventType,
                             this
@@ -298,8 +389,7 @@ namespace ESPressio {
                 void OnListenerUnregistered(
                     std::type_index eventType
                 ) override {
-                    EventManager::
-                        GetInstance()->
+                    GetEventBus()->
                         UnregisterReceiver(
                             eventType,
                             this
@@ -307,6 +397,56 @@ namespace ESPressio {
                 }
 
 
+                void OnPolymorphicListenerRegistered(
+                    EventTypeID baseType,
+                    EventTypeMatcher matcher
+                ) override {
+                    LatchEventBus()->
+                        RegisterPolymorphicReceiver(
+                            baseType,
+                            matcher,
+                            this
+                        );
+                }
+
+
+                void OnPolymorphicListenerUnregistered(
+                    EventTypeID baseType
+                ) override {
+                    GetEventBus()->
+                        UnregisterPolymorphicReceiver(
+                            baseType,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerRegistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    LatchEventBus()->
+                        RegisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
+                void OnKeyedListenerUnregistered(
+                    EventTypeID eventType,
+                    uint64_t key
+                ) override {
+                    GetEventBus()->
+                        UnregisterKeyedReceiver(
+                            eventType,
+                            key,
+                            this
+                        );
+                }
+
+
             public:
                 using ClockType =
                     Timing::
@@ -367,6 +507,163 @@ namespace ESPressio {
                 }
 
 
+                /*
+                 * Subscribes this thread's listeners on bus (see
+                 * EventManager::CreateBus) instead of the default bus.
+                 * Returns false, leaving the bus unchanged, once any
+                 * listener has been registered.
+                 */
+                bool SetEventBus(
+                    EventManager* bus
+                ) {
+                    std::lock_guard<
+                        std::mutex
+                    > lock(
+                        _eventBusMutex
+                    );
+
+                    if (_eventBusLatched) {
+                        return false;
+                    }
+
+                    _eventBus.store(
+                        bus,
+                        std::memory_order_release
+                    );
+                    return true;
+                }
+
+
+                EventManager*
+                GetEventBus()
+                    const noexcept {
+                    EventManager* bus =
+                        _eventBus.load(
+                            std::memory_order_acquire
+                        );
+
+                    return
+                        bus == nullptr
+                            ? EventManager::
+                                GetInstance()
+                            : bus;
+                }
+
+
+#if ESPRESSIO_EVENT_SIMULATION
+                /*
+                 * Iteration period when run by an EventSimulation; the
+                 * first iteration is due one period after
+                 * startNanoseconds. Zero stops simulated iterations.
+                 */
+                void SetSimulationIterationPeriodNanoseconds(
+                    uint64_t periodNanoseconds,
+                    uint64_t startNanoseconds = 0
+                ) {
+                    _simulationPeriodNanoseconds =
+                        periodNanoseconds;
+
+                    _simulationStartNanoseconds =
+                        startNanoseconds;
+
+                    _simulationIteration = 1;
+
+                    _simulationLastIterationNanoseconds =
+                        startNanoseconds;
+                }
+
+
+                uint64_t GetNextSimulationWakeNanoseconds(
+                    uint64_t nowNanoseconds
+                ) override {
+                    if (
+                        _simulationBumped.load(
+                            std::memory_order_acquire
+                        ) ||
+                        (
+                            GetEventArrivalPolicy() ==
+                                PrecisionEventArrivalPolicy::
+                                    ProcessImmediately &&
+                            GetPendingEventCount() != 0
+                        )
+                    ) {
+                        return nowNanoseconds;
+                    }
+
+                    return
+                        _simulationPeriodNanoseconds == 0
+                            ? std::numeric_limits<uint64_t>::max()
+                            : GetSimulationDueNanoseconds();
+                }
+
+
+                /*
+                 * Runs one iteration when one is due or was triggered by an
+                 * arriving Event, reporting the due iterations that were
+                 * missed; otherwise processes the pending Events as an
+                 * immediate work wake would.
+                 */
+                void RunSimulationStep(
+                    uint64_t nowNanoseconds
+                ) override {
+                    const bool bumped =
+                        _simulationBumped.exchange(
+                            false,
+                            std::memory_order_acq_rel
+                        );
+
+                    const bool due =
+                        _simulationPeriodNanoseconds != 0 &&
+                        GetSimulationDueNanoseconds() <=
+                            nowNanoseconds;
+
+                    if (!due && !bumped) {
+                        OnWorkWake();
+                        return;
+                    }
+
+                    Threads::SkippedIterationCount
+                        skippedIterations = 0;
+
+                    if (due) {
+                        const uint64_t missed =
+                            (
+                                nowNanoseconds -
+                                GetSimulationDueNanoseconds()
+                            ) /
+                            _simulationPeriodNanoseconds;
+
+                        skippedIterations =
+                            static_cast<
+                                Threads::SkippedIterationCount
+                            >(
+                                missed
+                            );
+
+                        _simulationIteration +=
+                            missed + 1;
+                    }
+
+                    const uint64_t delta =
+                        nowNanoseconds -
+                        _simulationLastIterationNanoseconds;
+
+                    _simulationLastIterationNanoseconds =
+                        nowNanoseconds;
+
+                    Iterate(
+                        CreateSimulationTime(
+                            delta
+                        ),
+                        CreateSimulationTime(
+                            nowNanoseconds
+                        ),
+                        skippedIterations
+                    );
+                }
+#endif
+
+
                 PrecisionEventProcessOrder
                 GetEventProcessOrder()
                     const {
@@ -425,6 +722,49 @@ namespace ESPressio {
                 }
         };
 
+
+        /*
+         * PrecisionEventThread with heap-free, fixed-size pending storage for
+         * at most Capacity Events, CollectionCapacity per priority and
+         * dispatch method. See StaticEventReceiver.
+         */
+        template<
+            size_t Capacity,
+            size_t CollectionCapacity = Capacity,
+            typename TTime =
+                Timing::DefaultClockTime,
+            typename TRepresentationTraits =
+                Threads::
+                    PrecisionThreadTraits<
+                        TTime
+                    >
+        >
+        class StaticPrecisionEventThread :
+            private StaticEventStorage<Capacity, CollectionCapacity>,
+            public PrecisionEventThread<
+                TTime,
+                TRepresentationTraits
+            > {
+
+            public:
+                template<typename... TArguments>
+                explicit StaticPrecisionEventThread(
+                    TArguments&&... arguments
+                ) :
+                    PrecisionEventThread<
+                        TTime,
+                        TRepresentationTraits
+                    >(
+                        std::forward<TArguments>(
+                            arguments
+                        )...
+                    ) {
+                    this->UseStaticPendingStorage(
+                        this->_staticPendingStorage
+                    );
+                }
+        };
+
     }
 
 }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ESPressio_EventReceiver.hpp"
+
+namespace ESPressio {
+
+    namespace Event {
+
+        /*
+         * Holds a receiver's static pending storage. Listed as a base before
+         * EventReceiver (or a class derived from it) so the storage is built
+         * first and destroyed last, after the receiver releases its Events.
+         */
+        template<size_t Capacity, size_t CollectionCapacity = Capacity>
+        class StaticEventStorage {
+            protected:
+                EventReceiver::StaticPendingStorage<
+                    Capacity,
+                    CollectionCapacity
+                > _staticPendingStorage;
+        };
+
+        /*
+         * EventReceiver whose pending storage is a fixed in-object array, so
+         * queueing, overflow handling and draining never touch the heap
+         * after construction. Holds at most Capacity Events; overflow
+         * policies, statistics and WithEvents behave exactly as on
+         * EventReceiver.
+         *
+         * By default storage is sized for the worst case of every Event
+         * sharing one priority and dispatch method: 2 x priorities x
+         * Capacity pending entries. A smaller CollectionCapacity caps each
+         * priority/method collection instead, for 2 x priorities x
+         * CollectionCapacity entries; a full collection applies the
+         * overflow policy even while the receiver has room, and
+         * submissions stay Locked. Drains work in place, so concurrent and
+         * nested WithEvents calls are safe. Keyed coalescing and the
+         * LockFree/Sharded submission modes allocate their own structures
+         * when enabled and are outside the heap-free guarantee.
+         */
+        template<size_t Capacity, size_t CollectionCapacity = Capacity>
+        class StaticEventReceiver :
+            private StaticEventStorage<Capacity, CollectionCapacity>,
+            public EventReceiver {
+
+            public:
+                static constexpr size_t StaticCapacity = Capacity;
+
+                StaticEventReceiver() {
+                    UseStaticPendingStorage(this->_staticPendingStorage);
+                }
+        };
+
+    }
+
+}
@@ -70,8 +70,19 @@ public:
 };
 
 
-class ThreadCleanupClaimedEvent final :
+/*
+ * Common base of the ThreadManager cleanup Events, so one polymorphic
+ * listener can observe the whole cleanup lifecycle.
+ */
+class ThreadCleanupEvent :
     public Event<> {
+protected:
+    ThreadCleanupEvent() = default;
+};
+
+
+class ThreadCleanupClaimedEvent final :
+    public ThreadCleanupEvent {
 public:
     const ThreadSnapshot Snapshot;
 
@@ -84,7 +95,7 @@ public:
 
 
 #define ESPRESSIO_DEFINE_THREAD_CLEANUP_EVENT(CLASS_NAME) \
-class CLASS_NAME final : public Event<> { \
+class CLASS_NAME final : public ThreadCleanupEvent { \
 public: \
     const ThreadCleanupResult Result; \
     explicit CLASS_NAME(const ThreadCleanupResult& result) : Result(result) {} \
@@ -98,7 +109,7 @@ ESPRESSIO_DEFINE_THREAD_CLEANUP_EVENT(ThreadCleanupCompletedEvent)
 
 
 class ThreadCleanupFailedEvent final :
-    public Event<> {
+    public ThreadCleanupEvent {
 public:
     const ThreadCleanupResult Result;
     const std::exception_ptr Cause;
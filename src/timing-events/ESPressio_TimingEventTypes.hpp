@@ -21,6 +21,7 @@ public:
     const int64_t DifferenceNanoseconds;
     SystemClockTimeChangedEvent(TimingClockTick previousTime, TimingClockTick newTime, int64_t difference)
         : PreviousTimeNanoseconds(previousTime), NewTimeNanoseconds(newTime), DifferenceNanoseconds(difference) {}
+    bool GetCoalescingKey(uint64_t& key) const override { key = 0; return true; }
 };
 
 class SynchronizationSampleAcceptedEvent final : public Event<> {
@@ -99,6 +99,7 @@ public:
     SerializableSystemClockTimeChangedEvent() = default;
     SerializableSystemClockTimeChangedEvent(uint64_t before, uint64_t after, int64_t diff)
         : PreviousTimeNanoseconds(before), NewTimeNanoseconds(after), DifferenceNanoseconds(diff) {}
+    bool GetCoalescingKey(uint64_t& key) const override { key = 0; return true; }
     ESPRESSIO_SERIALIZABLE_TYPE(SerializableSystemClockTimeChangedEvent)
     ESPRESSIO_SERIALIZABLE_SCHEMA_VERSION(1)
     ESPRESSIO_SERIALIZABLE_PROPERTIES(
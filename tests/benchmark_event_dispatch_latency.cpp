@@ -0,0 +1,197 @@
+/*
+ * End-to-end latency of queued dispatch against DispatchNow.
+ *
+ * A receiver Thread waits for Events and records the time from the
+ * producer's call to its own callback. On the queued path the producer
+ * queues into a dispatcher whose own Thread is woken to route the Event,
+ * as the EventManager does; on the inline path the producer routes it
+ * with DispatchNow. Events are sent one at a time, each after the previous
+ * one was received, so the figures are unloaded latencies.
+ *
+ * Usage: espressio_event_dispatch_latency_benchmark [events]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "ESPressio_EventDispatcher.hpp"
+#include "ESPressio_EventLatencyHistogram.hpp"
+
+using namespace ESPressio::Event;
+
+namespace {
+
+    uint64_t NowNanoseconds() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count()
+        );
+    }
+
+    class LatencyEvent final : public IEvent {
+        private:
+            std::atomic<int> _references{0};
+            EventDispatchContext _dispatchContext{};
+
+        public:
+            uint64_t sentNanoseconds = 0;
+
+            void __ref() noexcept override { _references.fetch_add(1); }
+            void __unref() noexcept override { _references.fetch_sub(1); }
+            void __dispatch() override { }
+            void __setDispatchContext(
+                const EventDispatchContext& context
+            ) override {
+                _dispatchContext = context;
+            }
+            EventDispatchContext __getDispatchContext() const override {
+                return _dispatchContext;
+            }
+            void Queue(EventPriority = EventPriority::Normal) override { }
+            void Stack(EventPriority = EventPriority::Normal) override { }
+            uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+            uint64_t GetTimeSinceDispatchNanoseconds() const override {
+                return 0;
+            }
+    };
+
+    /*
+     * Runs OnWake() on its own thread each time EventAdded() signals it.
+     */
+    class Waker {
+        private:
+            std::mutex _mutex;
+            std::condition_variable _signal;
+            bool _signalled = false;
+            bool _stopping = false;
+            std::thread _thread;
+
+        protected:
+            virtual void OnWake() = 0;
+
+            void Signal() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _signalled = true;
+                }
+                _signal.notify_one();
+            }
+
+        public:
+            virtual ~Waker() = default;
+
+            void Start() {
+                _thread = std::thread([this]() {
+                    for (;;) {
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _signal.wait(lock, [this]() {
+                                return _signalled || _stopping;
+                            });
+                            if (!_signalled) {
+                                return;
+                            }
+                            _signalled = false;
+                        }
+                        OnWake();
+                    }
+                });
+            }
+
+            void Stop() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stopping = true;
+                }
+                _signal.notify_one();
+                _thread.join();
+            }
+    };
+
+    class TimingReceiver final : public EventReceiver, public Waker {
+        public:
+            EventLatencyHistogram<> latency;
+            std::atomic<uint64_t> received{0};
+
+        protected:
+            void EventAdded() override { Signal(); }
+
+            void OnWake() override {
+                WithEvents([this](
+                    IEvent* event, EventDispatchMethod, EventPriority
+                ) {
+                    latency.Record(
+                        NowNanoseconds() -
+                        static_cast<LatencyEvent*>(event)->sentNanoseconds
+                    );
+                    received.fetch_add(1, std::memory_order_release);
+                });
+            }
+    };
+
+    class ThreadedDispatcher final : public EventDispatcher, public Waker {
+        protected:
+            void EventAdded() override { Signal(); }
+            void OnWake() override { DispatchEvents(); }
+    };
+
+    EventLatencySnapshot Run(bool inlineDispatch, uint64_t eventCount) {
+        LatencyEvent event;
+        TimingReceiver receiver;
+        ThreadedDispatcher dispatcher;
+        dispatcher.RegisterReceiver(typeid(LatencyEvent), &receiver);
+        receiver.Start();
+        dispatcher.Start();
+
+        for (uint64_t index = 0; index < eventCount; ++index) {
+            event.sentNanoseconds = NowNanoseconds();
+            if (inlineDispatch) {
+                dispatcher.DispatchNow(&event);
+            } else {
+                dispatcher.QueueEvent(&event);
+            }
+            while (
+                receiver.received.load(std::memory_order_acquire) <=
+                index
+            ) {
+                std::this_thread::yield();
+            }
+        }
+
+        dispatcher.Stop();
+        receiver.Stop();
+        return receiver.latency.GetSnapshot();
+    }
+
+    void Print(const char* path, const EventLatencySnapshot& snapshot) {
+        std::printf(
+            "%-14s %10llu %10llu %10llu %10llu\n",
+            path,
+            static_cast<unsigned long long>(snapshot.SampleCount),
+            static_cast<unsigned long long>(snapshot.P50Nanoseconds),
+            static_cast<unsigned long long>(snapshot.P99Nanoseconds),
+            static_cast<unsigned long long>(snapshot.MaximumNanoseconds)
+        );
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const uint64_t eventCount = argc > 1
+        ? static_cast<uint64_t>(std::strtoull(argv[1], nullptr, 10))
+        : 20000;
+    std::printf(
+        "%-14s %10s %10s %10s %10s\n",
+        "path", "events", "p50 ns", "p99 ns", "max ns"
+    );
+    Print("queued", Run(false, eventCount));
+    Print("DispatchNow", Run(true, eventCount));
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * Dispatch throughput against dispatch worker count.
+ *
+ * Every Event type has several receivers doing a fixed amount of synthetic
+ * work per delivery, standing in for the lock and wake-up a real receiver
+ * costs. Each run queues the same Events, then times one dispatch pass
+ * until every worker has delivered its share. Worker count 0 is the
+ * single-threaded fan-out.
+ *
+ * Usage: espressio_event_dispatch_worker_benchmark [events-per-type]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "ESPressio_EventDispatcher.hpp"
+
+using namespace ESPressio::Event;
+
+namespace {
+
+    constexpr int TypeCount = 8;
+    constexpr int ReceiversPerType = 4;
+    constexpr int WorkPerDelivery = 400;
+
+    template<int Type>
+    class BenchmarkEvent final : public IEvent {
+        private:
+            std::atomic<int> _references{0};
+            EventDispatchContext _dispatchContext{};
+
+        public:
+            void __ref() noexcept override { _references.fetch_add(1); }
+            void __unref() noexcept override { _references.fetch_sub(1); }
+            void __dispatch() override { }
+            void __setDispatchContext(
+                const EventDispatchContext& context
+            ) override {
+                _dispatchContext = context;
+            }
+            EventDispatchContext __getDispatchContext() const override {
+                return _dispatchContext;
+            }
+            void Queue(EventPriority = EventPriority::Normal) override { }
+            void Stack(EventPriority = EventPriority::Normal) override { }
+            uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+            uint64_t GetTimeSinceDispatchNanoseconds() const override {
+                return 0;
+            }
+    };
+
+    class WorkingReceiver final : public IEventReceiver {
+        public:
+            std::atomic<uint64_t> deliveries{0};
+            std::atomic<uint64_t> checksum{0};
+
+            void QueueEvent(IEvent* event, EventPriority) override {
+                uint64_t value = reinterpret_cast<uintptr_t>(event);
+                for (int step = 0; step < WorkPerDelivery; ++step) {
+                    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+                }
+                checksum.fetch_add(value, std::memory_order_relaxed);
+                deliveries.fetch_add(1, std::memory_order_relaxed);
+            }
+            void StackEvent(IEvent* event, EventPriority priority) override {
+                QueueEvent(event, priority);
+            }
+    };
+
+    class BenchmarkDispatcher final : public EventDispatcher {
+        public:
+            void Dispatch() { DispatchEvents(); }
+            bool StartWorkers(size_t count) {
+                return StartDispatchWorkers(count);
+            }
+            bool ProcessWorker(size_t index) {
+                return ProcessDispatchWorker(index);
+            }
+            void StopWorkers() { StopDispatchWorkers(); }
+    };
+
+    struct EventSet {
+        std::vector<BenchmarkEvent<0>> type0;
+        std::vector<BenchmarkEvent<1>> type1;
+        std::vector<BenchmarkEvent<2>> type2;
+        std::vector<BenchmarkEvent<3>> type3;
+        std::vector<BenchmarkEvent<4>> type4;
+        std::vector<BenchmarkEvent<5>> type5;
+        std::vector<BenchmarkEvent<6>> type6;
+        std::vector<BenchmarkEvent<7>> type7;
+
+        explicit EventSet(size_t count) :
+            type0(count), type1(count), type2(count), type3(count),
+            type4(count), type5(count), type6(count), type7(count) {
+        }
+
+        IEvent* At(int type, size_t index) {
+            switch (type) {
+                case 0: return &type0[index];
+                case 1: return &type1[index];
+                case 2: return &type2[index];
+                case 3: return &type3[index];
+                case 4: return &type4[index];
+                case 5: return &type5[index];
+                case 6: return &type6[index];
+                default: return &type7[index];
+            }
+        }
+    };
+
+    double Run(size_t workerCount, size_t eventsPerType) {
+        EventSet events(eventsPerType);
+        std::vector<WorkingReceiver> receivers(TypeCount * ReceiversPerType);
+        BenchmarkDispatcher dispatcher;
+        dispatcher.SetMaximumPendingEventCount(0);
+        for (int type = 0; type < TypeCount; ++type) {
+            for (int receiver = 0; receiver < ReceiversPerType; ++receiver) {
+                dispatcher.RegisterReceiver(
+                    typeid(*events.At(type, 0)),
+                    &receivers[type * ReceiversPerType + receiver]
+                );
+            }
+        }
+        for (size_t index = 0; index < eventsPerType; ++index) {
+            for (int type = 0; type < TypeCount; ++type) {
+                dispatcher.QueueEvent(events.At(type, index));
+            }
+        }
+
+        std::vector<std::thread> workers;
+        if (workerCount > 0) {
+            dispatcher.StartWorkers(workerCount);
+            for (size_t index = 0; index < workerCount; ++index) {
+                workers.emplace_back([&dispatcher, index]() {
+                    while (dispatcher.ProcessWorker(index)) {
+                    }
+                });
+            }
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        dispatcher.Dispatch();
+        dispatcher.StopWorkers();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - started
+        ).count();
+
+        uint64_t deliveries = 0;
+        for (const WorkingReceiver& receiver : receivers) {
+            deliveries += receiver.deliveries.load();
+        }
+        if (deliveries != eventsPerType * TypeCount * ReceiversPerType) {
+            std::fprintf(stderr, "lost deliveries\n");
+            std::exit(1);
+        }
+        return static_cast<double>(eventsPerType * TypeCount) / seconds;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const size_t eventsPerType = argc > 1
+        ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10))
+        : 20000;
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf(
+        "%zu Event types x %zu Events, %d receivers per type, %zu cores\n",
+        static_cast<size_t>(TypeCount), eventsPerType,
+        ReceiversPerType, cores
+    );
+    std::printf("%8s %16s %8s\n", "workers", "events/s", "speedup");
+    const double baseline = Run(0, eventsPerType);
+    std::printf("%8d %16.0f %8.2f\n", 0, baseline, 1.0);
+    for (size_t workerCount = 1; workerCount <= 8; workerCount *= 2) {
+        const double throughput = Run(workerCount, eventsPerType);
+        std::printf(
+            "%8zu %16.0f %8.2f\n",
+            workerCount, throughput, throughput / baseline
+        );
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ESPressio {
+    namespace Threads {
+
+        /*
+         * Host stand-in for ESPressio-Threads. Threads are never started;
+         * tests drive them through ESPRESSIO_EVENT_SIMULATION instead.
+         */
+        class IThread {
+            public:
+                virtual ~IThread() = default;
+        };
+
+        class Thread : public IThread {
+            public:
+                explicit Thread(bool = false) {}
+                virtual ~Thread() = default;
+                void SetPriority(uint8_t) {}
+                void SetCoreID(int) {}
+                void Initialize() {}
+                void Start() {}
+                void Shutdown() {}
+                virtual void Terminate() {}
+
+            protected:
+                virtual void OnLoop() {}
+        };
+
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "ESPressio_IObservable.hpp"
+
+namespace ESPressio {
+    namespace Observable {
+
+        // Host stand-in for ESPressio-Threads: holds no observers
+        class IObserverHandle {
+            public:
+                virtual ~IObserverHandle() = default;
+        };
+
+        using ObserverHandlePtr = std::unique_ptr<IObserverHandle>;
+
+        class ThreadSafeObservable {
+            public:
+                class NotificationContext {
+                    public:
+                        template <class T>
+                        void WithObservers(std::function<void(T*)>) {}
+                };
+
+                virtual ~ThreadSafeObservable() = default;
+                ObserverHandlePtr RegisterObserver(IObserver*) { return nullptr; }
+                void UnregisterObserver(IObserver*) {}
+
+            protected:
+                void ExecuteNotification(
+                    std::function<void(NotificationContext&)> notification
+                ) {
+                    NotificationContext context;
+                    notification(context);
+                }
+        };
+
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+using TaskHandle_t = void*;
+using TickType_t = uint32_t;
+using BaseType_t = int;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xffffffffu
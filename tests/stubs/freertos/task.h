@@ -0,0 +1,9 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Host tests never block on task notifications; they step Threads directly
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline void taskYIELD() {}
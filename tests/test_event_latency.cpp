@@ -0,0 +1,112 @@
+#include <cassert>
+#include <cstdint>
+
+#include "ESPressio_EventReceiver.hpp"
+
+using namespace ESPressio::Event;
+
+class LatencyEvent final : public IEvent {
+    private:
+        int _references = 0;
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        void __ref() noexcept override { ++_references; }
+        void __unref() noexcept override {
+            assert(_references > 0);
+            --_references;
+        }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        int References() const { return _references; }
+};
+
+class ManualClock final :
+    public ESPressio::Timing::ISystemClock<EventTime> {
+    public:
+        uint64_t now = 0;
+
+        EventTime GetTime() override { return EventTime(now); }
+        EventTime GetResolution() override { return EventTime(1); }
+};
+
+class LatencyReceiver final : public EventReceiver {
+    public:
+        void Drain() {
+            WithEvents([](IEvent*, EventDispatchMethod, EventPriority) { });
+        }
+};
+
+int main() {
+    EventLatencyHistogram<> histogram;
+    assert(histogram.GetSnapshot().SampleCount == 0);
+    for (uint64_t latency = 1; latency <= 100; ++latency) {
+        histogram.Record(latency);
+    }
+    const EventLatencySnapshot distribution = histogram.GetSnapshot();
+    assert(distribution.SampleCount == 100);
+    assert(distribution.P50Nanoseconds == 63);
+    assert(distribution.P99Nanoseconds == 100);
+    assert(distribution.MaximumNanoseconds == 100);
+    histogram.Record(uint64_t(1) << 62);
+    assert(histogram.GetPercentileNanoseconds(100) == uint64_t(1) << 62);
+
+    ManualClock clock;
+    LatencyReceiver receiver;
+    receiver.SetEventDrainClock(&clock);
+
+    LatencyEvent first;
+    LatencyEvent second;
+    LatencyEvent urgent;
+    clock.now = 100;
+    receiver.QueueEvent(&first);
+    clock.now = 150;
+    receiver.QueueEvent(&second);
+    receiver.StackEvent(&urgent, EventPriority::High);
+    clock.now = 400;
+    receiver.Drain();
+
+    const EventLatencySnapshot queued = receiver.GetEventLatencySnapshot(
+        EventPriority::Normal, EventDispatchMethod::Queue
+    );
+    assert(queued.SampleCount == 2);
+    assert(queued.P50Nanoseconds == 255);
+    assert(queued.P99Nanoseconds == 300);
+    assert(queued.MaximumNanoseconds == 300);
+    const EventLatencySnapshot stacked = receiver.GetEventLatencySnapshot(
+        EventPriority::High, EventDispatchMethod::Stack
+    );
+    assert(stacked.SampleCount == 1);
+    assert(stacked.MaximumNanoseconds == 250);
+    assert(receiver.GetEventLatencySnapshot(
+        EventPriority::Low, EventDispatchMethod::Queue
+    ).SampleCount == 0);
+    assert(receiver.GetEventLatencySnapshot().SampleCount == 3);
+
+    receiver.SetEventSubmissionMode(EventSubmissionMode::LockFree);
+    clock.now = 1000;
+    receiver.QueueEvent(&first, EventPriority::Low);
+    clock.now = 1010;
+    receiver.Drain();
+    const EventLatencySnapshot submitted = receiver.GetEventLatencySnapshot(
+        EventPriority::Low, EventDispatchMethod::Queue
+    );
+    assert(submitted.SampleCount == 1);
+    assert(submitted.MaximumNanoseconds == 10);
+
+    receiver.ResetEventLatencyStatistics();
+    assert(receiver.GetEventLatencySnapshot().SampleCount == 0);
+    receiver.SetEventDrainClock(nullptr);
+    assert(first.References() == 0);
+    assert(second.References() == 0);
+    assert(urgent.References() == 0);
+}
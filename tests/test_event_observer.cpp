@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "ESPressio_EventListener.hpp"
 
@@ -56,6 +57,57 @@ class OtherEvent final : public IEvent {
         uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
 };
 
+class FamilyEvent : public IEvent {
+    private:
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        void __ref() noexcept override {}
+        void __unref() noexcept override {}
+        void __dispatch() override {}
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override {}
+        void Stack(EventPriority = EventPriority::Normal) override {}
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+};
+
+class FirstFamilyEvent final : public FamilyEvent {};
+class SecondFamilyEvent final : public FamilyEvent {};
+
+class ChannelEvent final : public IEvent {
+    private:
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        uint64_t channel = 0;
+        bool keyed = true;
+
+        explicit ChannelEvent(uint64_t eventChannel) : channel(eventChannel) {}
+        void __ref() noexcept override {}
+        void __unref() noexcept override {}
+        void __dispatch() override {}
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override {}
+        void Stack(EventPriority = EventPriority::Normal) override {}
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        bool GetRoutingKey(uint64_t& key) const override {
+            key = channel;
+            return keyed;
+        }
+};
+
 class TestObserver final : public IEventObserver<TestEvent> {
     public:
         int calls = 0;
@@ -103,12 +155,33 @@ class TrackingEventListener final : public EventListener {
     public:
         int registrations = 0;
         int unregistrations = 0;
+        int polymorphicRegistrations = 0;
+        int polymorphicUnregistrations = 0;
+        int keyedRegistrations = 0;
+        int keyedUnregistrations = 0;
+        EventTypeMatcher matcher = nullptr;
 
         void Shutdown() { UnregisterAllListeners(); }
 
     protected:
         void OnListenerRegistered(std::type_index) override { ++registrations; }
         void OnListenerUnregistered(std::type_index) override { ++unregistrations; }
+        void OnPolymorphicListenerRegistered(
+            EventTypeID baseType, EventTypeMatcher eventMatcher) override {
+            assert(baseType == EventTypeRegistry::Of<FamilyEvent>());
+            ++polymorphicRegistrations;
+            matcher = eventMatcher;
+        }
+        void OnPolymorphicListenerUnregistered(EventTypeID) override {
+            ++polymorphicUnregistrations;
+        }
+        void OnKeyedListenerRegistered(EventTypeID type, uint64_t) override {
+            assert(type == EventTypeRegistry::Of<ChannelEvent>());
+            ++keyedRegistrations;
+        }
+        void OnKeyedListenerUnregistered(EventTypeID, uint64_t) override {
+            ++keyedUnregistrations;
+        }
 };
 
 static_assert(std::is_base_of<
@@ -251,4 +324,107 @@ int main() {
     assert(shutdownListener.unregistrations == 1);
     assert(!shutdownHandle->IsRegistered());
     shutdownHandle.reset();
+
+    FirstFamilyEvent firstFamilyEvent;
+    SecondFamilyEvent secondFamilyEvent;
+    int familyCalls = 0;
+    int firstCalls = 0;
+    EventListenerHandlePtr familyHandle =
+        listener.RegisterPolymorphicListener<FamilyEvent>(
+            [&](FamilyEvent*, EventDispatchMethod, EventPriority) {
+                ++familyCalls;
+            });
+    EventListenerHandlePtr secondFamilyHandle =
+        listener.RegisterPolymorphicListener<FamilyEvent>(
+            [&](FamilyEvent*, EventDispatchMethod, EventPriority) {
+                ++familyCalls;
+            });
+    assert(listener.polymorphicRegistrations == 1);
+    assert(listener.matcher(&secondFamilyEvent));
+    assert(!listener.matcher(&event));
+    Process(listener, firstFamilyEvent);
+    Process(listener, secondFamilyEvent);
+    Process(listener, event);
+    assert(familyCalls == 4);
+    EventListenerHandlePtr firstHandle =
+        listener.RegisterListener<FirstFamilyEvent>(
+            [&](FirstFamilyEvent*, EventDispatchMethod, EventPriority) {
+                ++firstCalls;
+            });
+    Process(listener, firstFamilyEvent);
+    assert(familyCalls == 6 && firstCalls == 1);
+    secondFamilyHandle.reset();
+    assert(listener.polymorphicUnregistrations == 0);
+    Process(listener, firstFamilyEvent);
+    assert(familyCalls == 7 && firstCalls == 2);
+    familyHandle.reset();
+    assert(listener.polymorphicUnregistrations == 1);
+    Process(listener, firstFamilyEvent);
+    Process(listener, secondFamilyEvent);
+    assert(familyCalls == 7 && firstCalls == 3);
+    firstHandle.reset();
+
+    TrackingEventListener familyShutdownListener;
+    EventListenerHandlePtr familyShutdownHandle =
+        familyShutdownListener.RegisterPolymorphicListener<FamilyEvent>(
+            [](FamilyEvent*, EventDispatchMethod, EventPriority) {});
+    familyShutdownListener.Shutdown();
+    assert(familyShutdownListener.polymorphicUnregistrations == 1);
+    assert(!familyShutdownHandle->IsRegistered());
+    familyShutdownHandle.reset();
+
+    TrackingEventListener keyedListener;
+    int channelCalls[3] = {0, 0, 0};
+    int allChannelCalls = 0;
+    std::vector<EventListenerHandlePtr> channelHandles;
+    for (uint64_t channel = 0; channel < 3; ++channel) {
+        channelHandles.push_back(
+            keyedListener.RegisterKeyedListener<ChannelEvent>(
+                channel,
+                [&channelCalls, channel](
+                    ChannelEvent* channelEvent,
+                    EventDispatchMethod,
+                    EventPriority
+                ) {
+                    assert(channelEvent->channel == channel);
+                    ++channelCalls[channel];
+                }));
+    }
+    channelHandles.push_back(
+        keyedListener.RegisterKeyedListener<ChannelEvent>(
+            1,
+            [&](ChannelEvent*, EventDispatchMethod, EventPriority) {
+                ++channelCalls[1];
+            }));
+    EventListenerHandlePtr allChannelsHandle =
+        keyedListener.RegisterListener<ChannelEvent>(
+            [&](ChannelEvent*, EventDispatchMethod, EventPriority) {
+                ++allChannelCalls;
+            });
+    assert(keyedListener.keyedRegistrations == 3);
+    assert(keyedListener.registrations == 1);
+    ChannelEvent firstChannel(0);
+    ChannelEvent secondChannel(1);
+    ChannelEvent unknownChannel(7);
+    ChannelEvent unkeyedChannel(1);
+    unkeyedChannel.keyed = false;
+    Process(keyedListener, firstChannel);
+    Process(keyedListener, secondChannel);
+    Process(keyedListener, unknownChannel);
+    Process(keyedListener, unkeyedChannel);
+    assert(channelCalls[0] == 1 && channelCalls[1] == 2);
+    assert(channelCalls[2] == 0 && allChannelCalls == 4);
+    channelHandles[3].reset();
+    assert(keyedListener.keyedUnregistrations == 0);
+    channelHandles[1].reset();
+    assert(keyedListener.keyedUnregistrations == 1);
+    Process(keyedListener, secondChannel);
+    assert(channelCalls[1] == 2 && allChannelCalls == 5);
+    keyedListener.Shutdown();
+    assert(keyedListener.keyedUnregistrations == 3);
+    assert(keyedListener.unregistrations == 1);
+    assert(!channelHandles[0]->IsRegistered());
+    assert(!allChannelsHandle->IsRegistered());
+    Process(keyedListener, firstChannel);
+    assert(channelCalls[0] == 1);
 }
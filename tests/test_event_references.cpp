@@ -1,14 +1,53 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 #include <thread>
+#include <typeindex>
 #include <vector>
 
 #include "ESPressio_EventDispatcher.hpp"
+#include "ESPressio_StaticEventReceiver.hpp"
+#include "ESPressio_EventJournalTransport.hpp"
+#include "ESPressio_EventTimerWheel.hpp"
+#include "ESPressio_PeriodicEventSchedule.hpp"
 
 using namespace ESPressio::Event;
 
+static std::atomic<bool> countingAllocations{false};
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
 class ReferenceTrackingEvent final : public IEvent {
     private:
         int _references = 0;
@@ -30,6 +69,41 @@ class ReferenceTrackingEvent final : public IEvent {
         void Queue(EventPriority = EventPriority::Normal) override { }
         void Stack(EventPriority = EventPriority::Normal) override { }
         uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return age; }
+        uint64_t GetTimeToLiveNanoseconds() const override { return timeToLive; }
+        int References() const { return _references; }
+        uint64_t timeToLive = 0;
+        uint64_t age = 0;
+};
+
+class CoalescingEvent final : public IEvent {
+    private:
+        int _references = 0;
+        uint64_t _key;
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        explicit CoalescingEvent(uint64_t key) : _key(key) { }
+
+        void __ref() noexcept override { ++_references; }
+        void __unref() noexcept override {
+            assert(_references > 0);
+            --_references;
+        }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        bool GetCoalescingKey(uint64_t& key) const override {
+            key = _key;
+            return true;
+        }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
         uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
         int References() const { return _references; }
 };
@@ -49,6 +123,34 @@ class TrackingReceiver final : public EventReceiver {
             });
         }
 
+        /*
+         * A non-copyable callback cannot be wrapped in std::function, so
+         * this only compiles through the templated drain path.
+         */
+        size_t DrainWithMoveOnlyCallback() {
+            struct MoveOnlyCounter {
+                std::unique_ptr<size_t> count{new size_t(0)};
+                void operator()(
+                    IEvent*, EventDispatchMethod, EventPriority
+                ) {
+                    ++*count;
+                }
+            } counter;
+            WithEvents(counter);
+            return *counter.count;
+        }
+
+        void DrainWithFunction() {
+            std::function<void(
+                IEvent*, EventDispatchMethod, EventPriority
+            )> callback = [&](
+                IEvent*, EventDispatchMethod method, EventPriority
+            ) {
+                methods.push_back(method);
+            };
+            WithEvents(callback);
+        }
+
         void DrainWithoutRecording() {
             WithEvents([](
                 IEvent*, EventDispatchMethod, EventPriority
@@ -64,11 +166,268 @@ class TrackingReceiver final : public EventReceiver {
         }
 };
 
+class SteppingClock final :
+    public ESPressio::Timing::ISystemClock<EventTime> {
+    public:
+        uint64_t now = 0;
+        uint64_t step = 0;
+
+        EventTime GetTime() override {
+            now += step;
+            return EventTime(now);
+        }
+        EventTime GetResolution() override { return EventTime(1); }
+};
+
+class RecordingTransportReceiver final : public IEventTransportReceiver {
+    public:
+        std::vector<std::vector<uint8_t>> packets;
+        IEventTransport* transport = nullptr;
+
+        void ReceiveEventTransportPacket(
+            IEventTransport* source,
+            const uint8_t* data,
+            std::size_t size
+        ) override {
+            transport = source;
+            packets.emplace_back(data, data + size);
+        }
+};
+
+static std::vector<uint8_t> CreateTransportPacket(
+    uint64_t typeID,
+    uint64_t messageID,
+    uint8_t payloadByte
+) {
+    EventTransportEnvelope envelope;
+    envelope.EventTypeID = typeID;
+    envelope.MessageID = messageID;
+    envelope.PayloadLength = 3;
+    std::vector<uint8_t> packet(sizeof(envelope) + envelope.PayloadLength, payloadByte);
+    std::memcpy(packet.data(), &envelope, sizeof(envelope));
+    return packet;
+}
+
+class BudgetReceiver final : public EventReceiver {
+    public:
+        std::vector<IEvent*> events;
+
+        EventDrainResult Drain(const EventDrainBudget& budget) {
+            return WithEvents([&](
+                IEvent* event, EventDispatchMethod, EventPriority
+            ) {
+                events.push_back(event);
+            }, budget);
+        }
+};
+
+class StaticRecordingReceiver final : public StaticEventReceiver<4> {
+    public:
+        IEvent* events[8] = {};
+        size_t eventCount = 0;
+        IEvent* arrival = nullptr;
+
+        EventDrainResult Drain(const EventDrainBudget& budget) {
+            return WithEvents([&](
+                IEvent* event, EventDispatchMethod, EventPriority
+            ) {
+                events[eventCount++] = event;
+                if (arrival != nullptr) {
+                    StackEvent(arrival);
+                    arrival = nullptr;
+                }
+            }, budget);
+        }
+};
+
+// Two entries per priority/method collection, eight Events in total
+class LimitedStaticReceiver final : public StaticEventReceiver<8, 2> {
+    public:
+        size_t deliveredCount = 0;
+
+        void Drain() {
+            WithEvents([&](IEvent*, EventDispatchMethod, EventPriority) {
+                ++deliveredCount;
+            }, EventDrainBudget{});
+        }
+};
+
+class PriorityRecordingReceiver final : public EventReceiver {
+    public:
+        std::vector<EventPriority> priorities;
+
+        EventDrainResult Drain(const EventDrainBudget& budget) {
+            return WithEvents([&](
+                IEvent*, EventDispatchMethod, EventPriority priority
+            ) {
+                priorities.push_back(priority);
+            }, budget);
+        }
+};
+
 class TestDispatcher final : public EventDispatcher {
     public:
         void Dispatch() { DispatchEvents(); }
 };
 
+// Holds every dispatching thread inside its routing read until released
+class RoutingBarrierDispatcher final : public EventDispatcher {
+    public:
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t inside = 0;
+        bool released = false;
+
+    protected:
+        void OnEventDispatched(
+            IEvent*, EventDispatchMethod, EventPriority
+        ) override {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++inside;
+            changed.notify_all();
+            changed.wait(lock, [&]() { return released; });
+        }
+};
+
+class InterestRecordingDispatcher final : public EventDispatcher {
+    public:
+        std::vector<uint32_t> interests;
+
+        void Dispatch() { DispatchEvents(); }
+
+    protected:
+        void OnEventDispatched(
+            IEvent* event, EventDispatchMethod, EventPriority
+        ) override {
+            interests.push_back(
+                GetEventTypeObserverInterestRouted(event->GetEventTypeID())
+            );
+        }
+};
+
+class WorkerDispatcher final : public EventDispatcher {
+    public:
+        void Dispatch() { DispatchEvents(); }
+        bool StartWorkers(size_t count, size_t capacity) {
+            return StartDispatchWorkers(count, capacity);
+        }
+        bool ProcessWorker(size_t index) {
+            return ProcessDispatchWorker(index);
+        }
+        void StopWorkers() { StopDispatchWorkers(); }
+};
+
+template<int Type>
+class OrderedEvent final : public IEvent {
+    private:
+        std::atomic<int> _references{0};
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        int sequence = 0;
+
+        void __ref() noexcept override { _references.fetch_add(1); }
+        void __unref() noexcept override { _references.fetch_sub(1); }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        int References() const { return _references.load(); }
+};
+
+// Counts deliveries by OrderedEvent sequence; can queue arrivals and drain
+// again from inside its first callback
+class ChunkedStaticReceiver final : public StaticEventReceiver<32> {
+    public:
+        std::atomic<int> deliveries[256];
+        OrderedEvent<0>* arrivals = nullptr;
+        int arrivalCount = 0;
+
+        ChunkedStaticReceiver() {
+            for (std::atomic<int>& delivery : deliveries) {
+                delivery.store(0);
+            }
+        }
+
+        EventDrainResult Drain() {
+            return WithEvents([&](
+                IEvent* event, EventDispatchMethod, EventPriority
+            ) {
+                deliveries[static_cast<OrderedEvent<0>*>(event)->sequence]
+                    .fetch_add(1);
+                OrderedEvent<0>* nested = arrivals;
+                arrivals = nullptr;
+                if (nested != nullptr) {
+                    for (int index = 0; index < arrivalCount; ++index) {
+                        QueueEvent(&nested[index]);
+                    }
+                    Drain();
+                }
+            }, EventDrainBudget{});
+        }
+};
+
+class FamilyBaseEvent : public IEvent {
+    private:
+        std::atomic<int> _references{0};
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        void __ref() noexcept override { _references.fetch_add(1); }
+        void __unref() noexcept override { _references.fetch_sub(1); }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        int References() const { return _references.load(); }
+};
+
+template<int Member>
+class FamilyMemberEvent final : public FamilyBaseEvent { };
+
+class DeviceEvent final : public IEvent {
+    private:
+        std::atomic<int> _references{0};
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        uint64_t device = 0;
+
+        explicit DeviceEvent(uint64_t eventDevice = 0) : device(eventDevice) { }
+        void __ref() noexcept override { _references.fetch_add(1); }
+        void __unref() noexcept override { _references.fetch_sub(1); }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        bool GetRoutingKey(uint64_t& key) const override {
+            key = device;
+            return true;
+        }
+        int References() const { return _references.load(); }
+};
+
 class HeapTrackingEvent final : public IEvent {
     private:
         int _references = 0;
@@ -103,6 +462,39 @@ class HeapTrackingEvent final : public IEvent {
         uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
 };
 
+class SharedTrackingEvent final : public IEvent {
+    private:
+        std::atomic<int> _references{0};
+        std::atomic<int>& _liveEvents;
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        explicit SharedTrackingEvent(std::atomic<int>& liveEvents)
+            : _liveEvents(liveEvents) {
+            _liveEvents.fetch_add(1);
+        }
+
+        ~SharedTrackingEvent() { _liveEvents.fetch_sub(1); }
+
+        void __ref() noexcept override { _references.fetch_add(1); }
+        void __unref() noexcept override {
+            if (_references.fetch_sub(1) == 1) {
+                delete this;
+            }
+        }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+};
+
 int main() {
     ReferenceTrackingEvent dispatchedEvent;
     TrackingReceiver receiver;
@@ -134,6 +526,15 @@ int main() {
     assert(queuedEvent.References() == 0);
     assert(stackedEvent.References() == 0);
 
+    orderedReceiver.QueueEvent(&queuedEvent);
+    orderedReceiver.StackEvent(&stackedEvent);
+    assert(orderedReceiver.DrainWithMoveOnlyCallback() == 2);
+    orderedReceiver.QueueEvent(&queuedEvent);
+    orderedReceiver.DrainWithFunction();
+    assert(orderedReceiver.methods.size() == 3);
+    assert(queuedEvent.References() == 0);
+    assert(stackedEvent.References() == 0);
+
     ReferenceTrackingEvent abandonedQueueEvent;
     ReferenceTrackingEvent abandonedStackEvent;
     {
@@ -201,6 +602,109 @@ int main() {
         assert(liveHeapEvents == 1);
     }
 
+    {
+        PriorityRecordingReceiver inlineReceiver;
+        TestDispatcher inlineDispatcher;
+        inlineDispatcher.RegisterReceiver(
+            typeid(eventTypeProbe), &inlineReceiver
+        );
+        HeapTrackingEvent* inlineEvent =
+            new HeapTrackingEvent(liveHeapEvents);
+        inlineDispatcher.DispatchNow(
+            inlineEvent, EventPriority::High, EventDispatchMethod::Stack
+        );
+        assert(inlineDispatcher.GetPendingEventCount() == 0);
+        assert(inlineReceiver.GetPendingEventCount() == 1);
+        assert(liveHeapEvents == 2);
+        inlineReceiver.Drain(EventDrainBudget{});
+        assert(inlineReceiver.priorities.size() == 1);
+        assert(inlineReceiver.priorities[0] == EventPriority::High);
+        assert(liveHeapEvents == 1);
+        inlineDispatcher.UnregisterReceiver(
+            typeid(eventTypeProbe), &inlineReceiver
+        );
+        inlineDispatcher.DispatchNow(new HeapTrackingEvent(liveHeapEvents));
+        assert(liveHeapEvents == 1);
+    }
+
+    {
+        const EventTypeID heapType = eventTypeProbe.GetEventTypeID();
+        TrackingReceiver discardReceiver;
+        TestDispatcher discardDispatcher;
+        assert(!discardDispatcher.HasSubscribers(heapType));
+        assert(!discardDispatcher.HasSubscribers<HeapTrackingEvent>());
+        discardDispatcher.SetUnobservedEventPolicy(
+            UnobservedEventPolicy::Discard
+        );
+        discardDispatcher.QueueEvent(new HeapTrackingEvent(liveHeapEvents));
+        assert(liveHeapEvents == 1);
+        assert(discardDispatcher.GetPendingEventCount() == 0);
+        assert(discardDispatcher.GetDiscardedUnobservedEventCount() == 1);
+
+        discardDispatcher.RegisterObservedEventType(heapType);
+        assert(discardDispatcher.HasSubscribers<HeapTrackingEvent>());
+        discardDispatcher.StackEvent(new HeapTrackingEvent(liveHeapEvents));
+        assert(discardDispatcher.GetPendingEventCount() == 1);
+        discardDispatcher.Dispatch();
+        assert(liveHeapEvents == 1);
+        discardDispatcher.UnregisterObservedEventType(heapType);
+        assert(!discardDispatcher.HasSubscribers(heapType));
+
+        discardDispatcher.RegisterReceiver(heapType, &discardReceiver);
+        assert(discardDispatcher.HasSubscribers(heapType));
+        ReferenceTrackingEvent unobservedEvents[20];
+        IEvent* batch[40];
+        for (int index = 0; index < 20; ++index) {
+            batch[index * 2] = &unobservedEvents[index];
+            batch[index * 2 + 1] = new HeapTrackingEvent(liveHeapEvents);
+        }
+        discardDispatcher.QueueEvents(EventSpan(batch, 40));
+        assert(discardDispatcher.GetDiscardedUnobservedEventCount() == 21);
+        assert(discardDispatcher.GetPendingEventCount() == 20);
+        discardDispatcher.Dispatch();
+        discardReceiver.DrainWithoutRecording();
+        assert(liveHeapEvents == 1);
+        for (const ReferenceTrackingEvent& event : unobservedEvents) {
+            assert(event.References() == 0);
+        }
+
+        discardDispatcher.SetUnobservedEventPolicy(
+            UnobservedEventPolicy::Dispatch
+        );
+        discardDispatcher.QueueEvent(&unobservedEvents[0]);
+        assert(discardDispatcher.GetPendingEventCount() == 1);
+        discardDispatcher.Dispatch();
+        assert(unobservedEvents[0].References() == 0);
+        assert(discardDispatcher.GetDiscardedUnobservedEventCount() == 21);
+    }
+
+    {
+        ReferenceTrackingEvent interestEvent;
+        const EventTypeID interestType = interestEvent.GetEventTypeID();
+        InterestRecordingDispatcher interestDispatcher;
+        interestDispatcher.SetUnobservedEventPolicy(
+            UnobservedEventPolicy::Discard
+        );
+        interestDispatcher.RegisterObservedEventType(interestType, 0x1);
+        interestDispatcher.RegisterObservedEventType(interestType, 0x4);
+        assert(interestDispatcher.HasSubscribers(interestType));
+        interestDispatcher.QueueEvent(&interestEvent);
+        interestDispatcher.Dispatch();
+        interestDispatcher.UnregisterObservedEventType(interestType, 0x1);
+        interestDispatcher.DispatchNow(&interestEvent);
+        interestDispatcher.UnregisterObservedEventType(interestType, 0x4);
+        assert(!interestDispatcher.HasSubscribers(interestType));
+        interestDispatcher.SetUnobservedEventPolicy(
+            UnobservedEventPolicy::Dispatch
+        );
+        interestDispatcher.DispatchNow(&interestEvent);
+        assert(interestDispatcher.interests.size() == 3);
+        assert(interestDispatcher.interests[0] == 0x5);
+        assert(interestDispatcher.interests[1] == 0x4);
+        assert(interestDispatcher.interests[2] == 0);
+        assert(interestEvent.References() == 0);
+    }
+
     ReferenceTrackingEvent retainedEvent;
     ReferenceTrackingEvent rejectedEvent;
     TrackingReceiver boundedReceiver;
@@ -273,4 +777,1235 @@ int main() {
     boundedReceiver.DrainWithoutRecording();
     assert(capacityEvent.References() == 0);
     assert(boundedReceiver.GetRetainedEventCapacity() == 0);
+    TrackingReceiver lockFreeReceiver;
+    lockFreeReceiver.SetEventSubmissionMode(EventSubmissionMode::LockFree, 8);
+    assert(lockFreeReceiver.GetEventSubmissionMode() ==
+        EventSubmissionMode::LockFree);
+    lockFreeReceiver.SetMaximumPendingEventCount(2);
+    lockFreeReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::RejectIncoming
+    );
+    ReferenceTrackingEvent lockFreeQueued;
+    ReferenceTrackingEvent lockFreeStacked;
+    ReferenceTrackingEvent lockFreeRejected;
+    lockFreeReceiver.QueueEvent(&lockFreeQueued);
+    lockFreeReceiver.StackEvent(&lockFreeStacked);
+    lockFreeReceiver.QueueEvent(&lockFreeRejected);
+    assert(lockFreeReceiver.GetPendingEventCount() == 2);
+    assert(lockFreeReceiver.GetPeakPendingEventCount() == 2);
+    assert(lockFreeReceiver.GetRejectedEventCount() == 1);
+    assert(lockFreeRejected.References() == 0);
+    lockFreeReceiver.Drain();
+    assert(lockFreeReceiver.methods.size() == 2);
+    assert(lockFreeReceiver.methods[0] == EventDispatchMethod::Stack);
+    assert(lockFreeReceiver.methods[1] == EventDispatchMethod::Queue);
+    assert(lockFreeQueued.References() == 0);
+    assert(lockFreeStacked.References() == 0);
+
+    ReferenceTrackingEvent lockFreeOldest;
+    ReferenceTrackingEvent lockFreeNewest;
+    lockFreeReceiver.SetMaximumPendingEventCount(1);
+    lockFreeReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::DropOldest
+    );
+    lockFreeReceiver.QueueEvent(&lockFreeOldest);
+    lockFreeReceiver.QueueEvent(&lockFreeNewest);
+    assert(lockFreeOldest.References() == 0);
+    assert(lockFreeNewest.References() == 1);
+    assert(lockFreeReceiver.GetDroppedEventCount() == 1);
+    lockFreeReceiver.DrainWithoutRecording();
+    assert(lockFreeNewest.References() == 0);
+
+    std::atomic<int> liveLockFreeEvents{0};
+    {
+        TrackingReceiver contendedReceiver;
+        contendedReceiver.SetEventSubmissionMode(
+            EventSubmissionMode::LockFree, 16
+        );
+        contendedReceiver.SetMaximumPendingEventCount(32);
+        std::atomic<int> producersRunning{4};
+        std::vector<std::thread> producers;
+        for (int producerID = 0; producerID < 4; ++producerID) {
+            producers.emplace_back([&]() {
+                for (int index = 0; index < 2000; ++index) {
+                    contendedReceiver.QueueEvent(
+                        new SharedTrackingEvent(liveLockFreeEvents),
+                        static_cast<EventPriority>(index % 3)
+                    );
+                }
+                producersRunning.fetch_sub(1);
+            });
+        }
+        while (producersRunning.load() > 0 ||
+            contendedReceiver.GetPendingEventCount() > 0) {
+            contendedReceiver.DrainWithoutRecording();
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        contendedReceiver.DrainWithoutRecording();
+        assert(contendedReceiver.GetPendingEventCount() == 0);
+        assert(contendedReceiver.GetPeakPendingEventCount() <= 32);
+    }
+    assert(liveLockFreeEvents.load() == 0);
+
+    static ReferenceTrackingEvent shardedEvents[4][500];
+    BudgetReceiver shardedReceiver;
+    shardedReceiver.SetEventSubmissionMode(EventSubmissionMode::Sharded, 2);
+    shardedReceiver.SetMaximumPendingEventCount(0);
+    assert(shardedReceiver.GetEventSubmissionMode() ==
+        EventSubmissionMode::Sharded);
+    {
+        std::atomic<int> producersRunning{4};
+        std::vector<std::thread> producers;
+        for (int producerID = 0; producerID < 4; ++producerID) {
+            producers.emplace_back([&, producerID]() {
+                for (ReferenceTrackingEvent& event :
+                    shardedEvents[producerID]) {
+                    shardedReceiver.QueueEvent(&event);
+                }
+                producersRunning.fetch_sub(1);
+            });
+        }
+        while (producersRunning.load() > 0) {
+            shardedReceiver.Drain(EventDrainBudget{});
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        shardedReceiver.Drain(EventDrainBudget{});
+    }
+    assert(shardedReceiver.events.size() == 2000);
+    const ReferenceTrackingEvent* lastSharded[4] = {};
+    for (IEvent* event : shardedReceiver.events) {
+        const ReferenceTrackingEvent* tracked =
+            static_cast<ReferenceTrackingEvent*>(event);
+        const size_t producerID =
+            static_cast<size_t>(tracked - &shardedEvents[0][0]) / 500;
+        assert(lastSharded[producerID] == nullptr ||
+            lastSharded[producerID] < tracked);
+        lastSharded[producerID] = tracked;
+        assert(tracked->References() == 0);
+    }
+    const EventSubmissionStatistics submissionStatistics =
+        shardedReceiver.GetEventSubmissionStatistics();
+    assert(submissionStatistics.ShardedSubmissionCount == 2000);
+    assert(submissionStatistics.LockedSubmissionCount == 0);
+    shardedReceiver.ResetEventSubmissionStatistics();
+    assert(shardedReceiver.GetEventSubmissionStatistics()
+        .ShardedSubmissionCount == 0);
+    ReferenceTrackingEvent evictionEvents[5];
+    TrackingReceiver evictionReceiver;
+    evictionReceiver.SetMaximumPendingEventCount(3);
+    evictionReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::DropOldest
+    );
+    evictionReceiver.StackEvent(&evictionEvents[0], EventPriority::High);
+    evictionReceiver.QueueEvent(&evictionEvents[1], EventPriority::Low);
+    evictionReceiver.QueueEvent(&evictionEvents[2], EventPriority::High);
+    evictionReceiver.QueueEvent(&evictionEvents[3], EventPriority::Normal);
+    assert(evictionEvents[0].References() == 0);
+    assert(evictionEvents[1].References() == 1);
+    evictionReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::DropLowestPriority
+    );
+    evictionReceiver.StackEvent(&evictionEvents[4], EventPriority::Low);
+    assert(evictionEvents[1].References() == 0);
+    assert(evictionEvents[4].References() == 1);
+    assert(evictionReceiver.GetDroppedEventCount() == 2);
+    evictionReceiver.Drain();
+    assert(evictionReceiver.methods.size() == 3);
+    assert(evictionReceiver.methods[0] == EventDispatchMethod::Stack);
+    for (ReferenceTrackingEvent& evictionEvent : evictionEvents) {
+        assert(evictionEvent.References() == 0);
+    }
+    ReferenceTrackingEvent batchEvents[4];
+    IEvent* batch[] = {
+        &batchEvents[0], &batchEvents[1], nullptr,
+        &batchEvents[2], &batchEvents[3]
+    };
+    TrackingReceiver batchReceiver;
+    batchReceiver.SetMaximumPendingEventCount(3);
+    batchReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::RejectIncoming
+    );
+    batchReceiver.QueueEvents(batch, EventPriority::High);
+    assert(batchReceiver.GetPendingEventCount() == 3);
+    assert(batchReceiver.GetRejectedEventCount() == 1);
+    assert(batchEvents[2].References() == 1);
+    assert(batchEvents[3].References() == 0);
+    batchReceiver.DrainWithoutRecording();
+    batchReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::DropOldest
+    );
+    batchReceiver.StackEvents(batch);
+    assert(batchEvents[0].References() == 0);
+    assert(batchEvents[3].References() == 1);
+    assert(batchReceiver.GetDroppedEventCount() == 1);
+    batchReceiver.Drain();
+    assert(batchReceiver.methods.size() == 3);
+    for (ReferenceTrackingEvent& batchEvent : batchEvents) {
+        assert(batchEvent.References() == 0);
+    }
+
+    std::atomic<int> liveBatchEvents{0};
+    {
+        TrackingReceiver blockingBatchReceiver;
+        blockingBatchReceiver.SetMaximumPendingEventCount(4);
+        std::vector<IEvent*> burst;
+        for (int index = 0; index < 64; ++index) {
+            burst.push_back(new SharedTrackingEvent(liveBatchEvents));
+        }
+        std::atomic<bool> burstCompleted{false};
+        std::thread batchProducer([&]() {
+            blockingBatchReceiver.QueueEvents(burst);
+            burstCompleted.store(true);
+        });
+        while (!burstCompleted.load() ||
+            blockingBatchReceiver.GetPendingEventCount() > 0) {
+            blockingBatchReceiver.DrainWithoutRecording();
+        }
+        batchProducer.join();
+        assert(blockingBatchReceiver.GetPeakPendingEventCount() <= 4);
+        assert(blockingBatchReceiver.GetRejectedEventCount() == 0);
+    }
+    assert(liveBatchEvents.load() == 0);
+    ReferenceTrackingEvent budgetEvents[5];
+    BudgetReceiver budgetReceiver;
+    budgetReceiver.QueueEvent(&budgetEvents[0]);
+    budgetReceiver.QueueEvent(&budgetEvents[1]);
+    budgetReceiver.StackEvent(&budgetEvents[2]);
+    budgetReceiver.StackEvent(&budgetEvents[3]);
+    EventDrainBudget countBudget;
+    countBudget.MaximumEventCount = 1;
+    EventDrainResult budgetResult = budgetReceiver.Drain(countBudget);
+    assert(budgetResult.ProcessedEventCount == 1);
+    assert(budgetResult.BudgetExhausted);
+    assert(budgetReceiver.events.back() == &budgetEvents[3]);
+    budgetReceiver.StackEvent(&budgetEvents[4]);
+    countBudget.MaximumEventCount = 3;
+    budgetResult = budgetReceiver.Drain(countBudget);
+    assert(budgetResult.ProcessedEventCount == 3);
+    assert(budgetResult.BudgetExhausted);
+    assert(budgetReceiver.events[1] == &budgetEvents[4]);
+    assert(budgetReceiver.events[2] == &budgetEvents[2]);
+    assert(budgetReceiver.events[3] == &budgetEvents[0]);
+    assert(budgetReceiver.GetPendingEventCount() == 1);
+    budgetResult = budgetReceiver.Drain(countBudget);
+    assert(budgetResult.ProcessedEventCount == 1);
+    assert(!budgetResult.BudgetExhausted);
+    assert(budgetReceiver.events[4] == &budgetEvents[1]);
+    for (ReferenceTrackingEvent& budgetEvent : budgetEvents) {
+        assert(budgetEvent.References() == 0);
+    }
+
+    SteppingClock drainClock;
+    drainClock.step = 10;
+    budgetReceiver.SetEventDrainClock(&drainClock);
+    budgetReceiver.ResetEventDrainStatistics();
+    for (ReferenceTrackingEvent& budgetEvent : budgetEvents) {
+        budgetReceiver.QueueEvent(&budgetEvent, EventPriority::Low);
+    }
+    EventDrainBudget timeBudget;
+    timeBudget.MaximumDurationNanoseconds = 25;
+    budgetReceiver.SetEventDrainBudget(timeBudget);
+    budgetResult = budgetReceiver.Drain(budgetReceiver.GetEventDrainBudget());
+    assert(budgetResult.ProcessedEventCount == 3);
+    assert(budgetResult.BudgetExhausted);
+    assert(budgetReceiver.GetPendingEventCount() == 2);
+    assert(budgetEvents[2].References() == 0);
+    assert(budgetEvents[3].References() == 1);
+    const EventDrainStatistics drainStatistics =
+        budgetReceiver.GetEventDrainStatistics();
+    assert(drainStatistics.DrainCount == 1);
+    assert(drainStatistics.ProcessedEventCount == 3);
+    assert(drainStatistics.BudgetExhaustedCount == 1);
+    assert(drainStatistics.LastDrainNanoseconds == 40);
+    budgetReceiver.Drain(EventDrainBudget{});
+    assert(budgetReceiver.events.back() == &budgetEvents[4]);
+    budgetReceiver.SetEventDrainClock(nullptr);
+    for (ReferenceTrackingEvent& budgetEvent : budgetEvents) {
+        assert(budgetEvent.References() == 0);
+    }
+    ReferenceTrackingEvent scheduledEvents[10];
+    PriorityRecordingReceiver scheduledReceiver;
+    scheduledReceiver.SetMaximumPendingEventCount(0);
+    assert(scheduledReceiver.GetEventSchedulingPolicy() ==
+        EventSchedulingPolicy::StrictPriority);
+    scheduledReceiver.SetEventSchedulingPolicy(
+        EventSchedulingPolicy::WeightedRoundRobin
+    );
+    for (int index = 0; index < 5; ++index) {
+        scheduledReceiver.QueueEvent(
+            &scheduledEvents[index], EventPriority::Low
+        );
+        scheduledReceiver.QueueEvent(
+            &scheduledEvents[index + 5], EventPriority::High
+        );
+    }
+    scheduledReceiver.Drain(EventDrainBudget{});
+    const std::vector<EventPriority> expectedOrder{
+        EventPriority::High, EventPriority::High, EventPriority::High,
+        EventPriority::High, EventPriority::Low, EventPriority::High,
+        EventPriority::Low, EventPriority::Low, EventPriority::Low,
+        EventPriority::Low
+    };
+    assert(scheduledReceiver.priorities == expectedOrder);
+
+    EventDrainBudget starvationBudget;
+    starvationBudget.MaximumEventCount = 4;
+    scheduledReceiver.priorities.clear();
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int index = 5; index < 10; ++index) {
+            scheduledReceiver.QueueEvent(
+                &scheduledEvents[index], EventPriority::High
+            );
+        }
+        scheduledReceiver.QueueEvent(
+            &scheduledEvents[pass], EventPriority::Low
+        );
+        scheduledReceiver.Drain(starvationBudget);
+    }
+    assert(std::count(
+        scheduledReceiver.priorities.begin(),
+        scheduledReceiver.priorities.end(),
+        EventPriority::Low
+    ) >= 2);
+    scheduledReceiver.Drain(EventDrainBudget{});
+    for (ReferenceTrackingEvent& scheduledEvent : scheduledEvents) {
+        assert(scheduledEvent.References() == 0);
+    }
+
+    CoalescingEvent firstReading(1);
+    CoalescingEvent otherReading(2);
+    CoalescingEvent latestReading(1);
+    BudgetReceiver coalescingReceiver;
+    coalescingReceiver.SetMaximumPendingEventCount(2);
+    coalescingReceiver.SetEventQueueOverflowPolicy(
+        EventQueueOverflowPolicy::RejectIncoming
+    );
+    coalescingReceiver.QueueEvent(&firstReading);
+    coalescingReceiver.QueueEvent(&latestReading);
+    assert(coalescingReceiver.GetPendingEventCount() == 2);
+    coalescingReceiver.Drain(EventDrainBudget{});
+    coalescingReceiver.events.clear();
+    assert(firstReading.References() == 0);
+    assert(latestReading.References() == 0);
+
+    coalescingReceiver.SetEventCoalescingPolicy(
+        EventCoalescingPolicy::LatestValueWins
+    );
+    coalescingReceiver.QueueEvent(&firstReading);
+    coalescingReceiver.QueueEvent(&otherReading);
+    coalescingReceiver.QueueEvent(&latestReading);
+    assert(coalescingReceiver.GetPendingEventCount() == 2);
+    assert(coalescingReceiver.GetCoalescedEventCount() == 1);
+    assert(coalescingReceiver.GetRejectedEventCount() == 0);
+    assert(firstReading.References() == 0);
+    coalescingReceiver.Drain(EventDrainBudget{});
+    assert(coalescingReceiver.events.size() == 2);
+    assert(coalescingReceiver.events[0] == &latestReading);
+    assert(coalescingReceiver.events[1] == &otherReading);
+
+    CoalescingEvent queuedReadings[3] = {
+        CoalescingEvent(1), CoalescingEvent(2), CoalescingEvent(3)
+    };
+    CoalescingEvent replacementReading(3);
+    coalescingReceiver.events.clear();
+    coalescingReceiver.SetMaximumPendingEventCount(0);
+    for (CoalescingEvent& queuedReading : queuedReadings) {
+        coalescingReceiver.QueueEvent(&queuedReading);
+    }
+    EventDrainBudget singleEventBudget;
+    singleEventBudget.MaximumEventCount = 1;
+    coalescingReceiver.Drain(singleEventBudget);
+    coalescingReceiver.QueueEvent(&replacementReading);
+    assert(coalescingReceiver.GetPendingEventCount() == 2);
+    assert(queuedReadings[2].References() == 0);
+
+    CoalescingEvent stackedReading(1);
+    CoalescingEvent newerStackedReading(2);
+    CoalescingEvent latestStackedReading(1);
+    coalescingReceiver.StackEvent(&stackedReading);
+    coalescingReceiver.StackEvent(&newerStackedReading);
+    coalescingReceiver.Drain(singleEventBudget);
+    assert(coalescingReceiver.events.back() == &newerStackedReading);
+    coalescingReceiver.StackEvent(&latestStackedReading);
+    assert(stackedReading.References() == 0);
+    assert(coalescingReceiver.GetCoalescedEventCount() == 3);
+    coalescingReceiver.Drain(EventDrainBudget{});
+    const std::vector<IEvent*> expectedCoalesced{
+        &queuedReadings[0], &newerStackedReading, &latestStackedReading,
+        &queuedReadings[1], &replacementReading
+    };
+    assert(coalescingReceiver.events == expectedCoalesced);
+    assert(replacementReading.References() == 0);
+    assert(latestStackedReading.References() == 0);
+
+    ReferenceTrackingEvent longLivedEvent;
+    ReferenceTrackingEvent immortalEvent;
+    ReferenceTrackingEvent staleEvent;
+    ReferenceTrackingEvent staleSubmittedEvent;
+    longLivedEvent.timeToLive = 100;
+    staleEvent.timeToLive = 50;
+    staleSubmittedEvent.timeToLive = 50;
+    SteppingClock expiryClock;
+    BudgetReceiver expiryReceiver;
+    expiryReceiver.SetEventDrainClock(&expiryClock);
+    expiryReceiver.QueueEvent(&longLivedEvent);
+    expiryReceiver.QueueEvent(&staleEvent);
+    expiryReceiver.StackEvent(&immortalEvent);
+    expiryReceiver.SetEventSubmissionMode(EventSubmissionMode::LockFree);
+    expiryReceiver.QueueEvent(&staleSubmittedEvent, EventPriority::High);
+    expiryClock.now = 75;
+    const EventDrainResult expiryResult =
+        expiryReceiver.Drain(EventDrainBudget{});
+    assert(expiryResult.ProcessedEventCount == 2);
+    assert(expiryResult.ExpiredEventCount == 2);
+    assert(expiryReceiver.GetExpiredEventCount() == 2);
+    const std::vector<IEvent*> expectedLive{
+        &immortalEvent, &longLivedEvent
+    };
+    assert(expiryReceiver.events == expectedLive);
+    assert(staleEvent.References() == 0);
+    assert(staleSubmittedEvent.References() == 0);
+    expiryReceiver.ResetEventQueueStatistics();
+    assert(expiryReceiver.GetExpiredEventCount() == 0);
+
+    // Expiry counts on the drain clock from acceptance, less the Event's age
+    ReferenceTrackingEvent freshEvent;
+    ReferenceTrackingEvent agedEvent;
+    freshEvent.timeToLive = 50;
+    agedEvent.timeToLive = 50;
+    agedEvent.age = 30;
+    expiryClock.now = 1000;
+    expiryReceiver.QueueEvent(&freshEvent);
+    expiryReceiver.QueueEvent(&agedEvent);
+    expiryClock.now = 1025;
+    const EventDrainResult agedResult =
+        expiryReceiver.Drain(EventDrainBudget{});
+    assert(agedResult.ProcessedEventCount == 1);
+    assert(agedResult.ExpiredEventCount == 1);
+    assert(expiryReceiver.events.back() == &freshEvent);
+    assert(agedEvent.References() == 0);
+    expiryReceiver.SetEventDrainClock(nullptr);
+
+    ReferenceTrackingEvent saturatingEvents[4];
+    ReferenceTrackingEvent parkedEvent;
+    BudgetReceiver watermarkReceiver;
+    watermarkReceiver.SetMaximumPendingEventCount(4);
+    EventBackpressurePolicy backpressure;
+    backpressure.SpinCount = 0;
+    backpressure.YieldCount = 0;
+    backpressure.LowWatermark = 1;
+    watermarkReceiver.SetEventBackpressurePolicy(backpressure);
+    for (ReferenceTrackingEvent& saturatingEvent : saturatingEvents) {
+        watermarkReceiver.QueueEvent(&saturatingEvent);
+    }
+    std::atomic<bool> parkedCompleted{false};
+    std::thread parkedProducer([&]() {
+        watermarkReceiver.QueueEvent(&parkedEvent);
+        parkedCompleted.store(true);
+    });
+    while (watermarkReceiver.GetEventBackpressureStatistics()
+            .ParkedProducerCount == 0) {
+        std::this_thread::yield();
+    }
+    EventDrainBudget twoEventBudget;
+    twoEventBudget.MaximumEventCount = 2;
+    watermarkReceiver.Drain(twoEventBudget);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(!parkedCompleted.load());
+    watermarkReceiver.Drain(EventDrainBudget{1, 0});
+    parkedProducer.join();
+    const EventBackpressureStatistics backpressureStatistics =
+        watermarkReceiver.GetEventBackpressureStatistics();
+    assert(backpressureStatistics.BlockedProducerCount == 1);
+    assert(backpressureStatistics.ParkedProducerCount == 1);
+    assert(backpressureStatistics.TotalBlockedNanoseconds >= 20000000);
+    assert(backpressureStatistics.MaximumBlockedNanoseconds ==
+        backpressureStatistics.TotalBlockedNanoseconds);
+    watermarkReceiver.Drain(EventDrainBudget{});
+    assert(parkedEvent.References() == 0);
+    watermarkReceiver.ResetEventBackpressureStatistics();
+    assert(watermarkReceiver.GetEventBackpressureStatistics()
+        .BlockedProducerCount == 0);
+
+    ReferenceTrackingEvent staticEvents[6];
+    {
+        StaticRecordingReceiver staticReceiver;
+        assert(staticReceiver.GetMaximumPendingEventCount() == 4);
+        staticReceiver.SetMaximumPendingEventCount(0);
+        assert(staticReceiver.GetMaximumPendingEventCount() == 4);
+        const size_t staticCapacity =
+            staticReceiver.GetRetainedEventCapacity();
+        staticReceiver.SetEventQueueOverflowPolicy(
+            EventQueueOverflowPolicy::DropOldest
+        );
+        countingAllocations.store(true);
+        staticReceiver.StackEvent(&staticEvents[0]);
+        staticReceiver.StackEvent(&staticEvents[1]);
+        staticReceiver.StackEvent(&staticEvents[2]);
+        staticReceiver.StackEvent(&staticEvents[3]);
+        staticReceiver.StackEvent(&staticEvents[4]);
+        assert(staticEvents[0].References() == 0);
+        assert(staticReceiver.GetDroppedEventCount() == 1);
+        staticReceiver.Drain(EventDrainBudget{1, 0});
+        staticReceiver.StackEvent(&staticEvents[5]);
+        staticReceiver.Drain(EventDrainBudget{});
+        staticReceiver.QueueEvent(&staticEvents[0], EventPriority::High);
+        countingAllocations.store(false);
+        assert(allocationCount.load() == 0);
+        assert(staticReceiver.GetRetainedEventCapacity() == staticCapacity);
+        assert(staticReceiver.eventCount == 5);
+        assert(staticReceiver.events[0] == &staticEvents[4]);
+        assert(staticReceiver.events[1] == &staticEvents[5]);
+        assert(staticReceiver.events[2] == &staticEvents[3]);
+        assert(staticReceiver.events[3] == &staticEvents[2]);
+        assert(staticReceiver.events[4] == &staticEvents[1]);
+        assert(staticEvents[0].References() == 1);
+        staticReceiver.Drain(EventDrainBudget{});
+
+        SteppingClock staticClock;
+        staticClock.step = 10;
+        staticReceiver.SetEventDrainClock(&staticClock);
+        staticReceiver.eventCount = 0;
+        staticReceiver.StackEvent(&staticEvents[1]);
+        staticReceiver.StackEvent(&staticEvents[2]);
+        staticReceiver.StackEvent(&staticEvents[3]);
+        staticReceiver.arrival = &staticEvents[4];
+        const EventDrainResult staticDeadline =
+            staticReceiver.Drain(EventDrainBudget{0, 15});
+        assert(staticDeadline.BudgetExhausted);
+        assert(staticDeadline.ProcessedEventCount == 2);
+        staticReceiver.SetEventDrainClock(nullptr);
+        staticReceiver.Drain(EventDrainBudget{});
+        assert(staticReceiver.eventCount == 4);
+        assert(staticReceiver.events[0] == &staticEvents[3]);
+        assert(staticReceiver.events[1] == &staticEvents[2]);
+        assert(staticReceiver.events[2] == &staticEvents[4]);
+        assert(staticReceiver.events[3] == &staticEvents[1]);
+    }
+    for (ReferenceTrackingEvent& staticEvent : staticEvents) {
+        assert(staticEvent.References() == 0);
+    }
+
+    {
+        // Nested and concurrent drains each take their own chunks
+        static OrderedEvent<0> drainEvents[256];
+        for (int index = 0; index < 256; ++index) {
+            drainEvents[index].sequence = index;
+        }
+
+        ChunkedStaticReceiver nestedQueue;
+        for (int index = 0; index < 20; ++index) {
+            nestedQueue.QueueEvent(&drainEvents[index]);
+        }
+        nestedQueue.arrivals = &drainEvents[20];
+        nestedQueue.arrivalCount = 4;
+        nestedQueue.Drain();
+        assert(nestedQueue.GetPendingEventCount() == 0);
+
+        ChunkedStaticReceiver nestedStack;
+        for (int index = 0; index < 20; ++index) {
+            nestedStack.StackEvent(&drainEvents[index]);
+        }
+        nestedStack.arrivals = &drainEvents[20];
+        nestedStack.arrivalCount = 4;
+        nestedStack.Drain();
+        assert(nestedStack.GetPendingEventCount() == 0);
+        for (int index = 0; index < 24; ++index) {
+            assert(nestedQueue.deliveries[index].load() == 1);
+            assert(nestedStack.deliveries[index].load() == 1);
+            assert(drainEvents[index].References() == 0);
+        }
+
+        static_assert(
+            EventReceiver::StaticPendingStorage<8, 2>::PendingEntryCount == 12,
+            "a collection capacity sizes each collection"
+        );
+        static OrderedEvent<0> limitedEvents[6];
+        LimitedStaticReceiver limited;
+        limited.SetEventSubmissionMode(EventSubmissionMode::LockFree);
+        assert(limited.GetEventSubmissionMode() == EventSubmissionMode::Locked);
+        limited.SetEventQueueOverflowPolicy(
+            EventQueueOverflowPolicy::RejectIncoming
+        );
+        limited.QueueEvent(&limitedEvents[3], EventPriority::High);
+        limited.QueueEvent(&limitedEvents[0]);
+        limited.QueueEvent(&limitedEvents[1]);
+        limited.QueueEvent(&limitedEvents[2]);
+        assert(limited.GetRejectedEventCount() == 1);
+        assert(limitedEvents[2].References() == 0);
+        limited.StackEvent(&limitedEvents[4]);
+        assert(limited.GetPendingEventCount() == 4);
+
+        // The full collection drops its own oldest, not the global oldest
+        limited.SetEventQueueOverflowPolicy(
+            EventQueueOverflowPolicy::DropOldest
+        );
+        limited.QueueEvent(&limitedEvents[5]);
+        assert(limited.GetDroppedEventCount() == 1);
+        assert(limitedEvents[0].References() == 0);
+        assert(limitedEvents[3].References() == 1);
+
+        limited.SetEventQueueOverflowPolicy(
+            EventQueueOverflowPolicy::BlockProducer
+        );
+        std::thread limitedProducer([&]() {
+            limited.QueueEvent(&limitedEvents[2]);
+        });
+        while (limited.GetEventBackpressureStatistics()
+            .BlockedProducerCount == 0) {
+            std::this_thread::yield();
+        }
+        assert(limited.GetPendingEventCount() == 4);
+        limited.Drain();
+        limitedProducer.join();
+        limited.Drain();
+        assert(limited.deliveredCount == 5);
+        for (OrderedEvent<0>& limitedEvent : limitedEvents) {
+            assert(limitedEvent.References() == 0);
+        }
+
+        ChunkedStaticReceiver concurrent;
+        std::atomic<bool> producing{true};
+        auto drainLoop = [&]() {
+            while (producing.load() || concurrent.GetPendingEventCount() > 0) {
+                concurrent.Drain();
+                std::this_thread::yield();
+            }
+        };
+        std::thread firstDrainer(drainLoop);
+        std::thread secondDrainer(drainLoop);
+        for (int index = 0; index < 256; ++index) {
+            if (index % 2 == 0) {
+                concurrent.QueueEvent(&drainEvents[index]);
+            } else {
+                concurrent.StackEvent(&drainEvents[index]);
+            }
+        }
+        producing.store(false);
+        firstDrainer.join();
+        secondDrainer.join();
+        for (int index = 0; index < 256; ++index) {
+            assert(concurrent.deliveries[index].load() == 1);
+            assert(drainEvents[index].References() == 0);
+        }
+    }
+
+    static OrderedEvent<0> firstTypeEvents[200];
+    static OrderedEvent<1> secondTypeEvents[200];
+    {
+        BudgetReceiver orderedReceiver;
+        orderedReceiver.SetMaximumPendingEventCount(0);
+        WorkerDispatcher workerDispatcher;
+        workerDispatcher.SetMaximumPendingEventCount(0);
+        assert(workerDispatcher.StartWorkers(2, 4));
+        assert(!workerDispatcher.StartWorkers(2, 4));
+        assert(workerDispatcher.GetDispatchWorkerCount() == 2);
+        workerDispatcher.RegisterReceiver(
+            typeid(OrderedEvent<0>), &orderedReceiver
+        );
+        workerDispatcher.RegisterReceiver(
+            typeid(OrderedEvent<1>), &orderedReceiver
+        );
+        std::vector<std::thread> workers;
+        for (size_t workerIndex = 0; workerIndex < 2; ++workerIndex) {
+            workers.emplace_back([&, workerIndex]() {
+                while (workerDispatcher.ProcessWorker(workerIndex)) {
+                }
+            });
+        }
+        for (int index = 0; index < 200; ++index) {
+            firstTypeEvents[index].sequence = index;
+            secondTypeEvents[index].sequence = index;
+            workerDispatcher.QueueEvent(&firstTypeEvents[index]);
+            workerDispatcher.QueueEvent(&secondTypeEvents[index]);
+        }
+        workerDispatcher.Dispatch();
+        workerDispatcher.StopWorkers();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        assert(workerDispatcher.GetDispatchWorkerEventCount(0) +
+            workerDispatcher.GetDispatchWorkerEventCount(1) == 400);
+        orderedReceiver.Drain(EventDrainBudget{});
+        assert(orderedReceiver.events.size() == 400);
+        int nextFirst = 0;
+        int nextSecond = 0;
+        for (IEvent* event : orderedReceiver.events) {
+            if (typeid(*event) == typeid(OrderedEvent<0>)) {
+                assert(static_cast<OrderedEvent<0>*>(event)->sequence ==
+                    nextFirst++);
+            } else {
+                assert(static_cast<OrderedEvent<1>*>(event)->sequence ==
+                    nextSecond++);
+            }
+        }
+        assert(nextFirst == 200 && nextSecond == 200);
+    }
+    for (int index = 0; index < 200; ++index) {
+        assert(firstTypeEvents[index].References() == 0);
+        assert(secondTypeEvents[index].References() == 0);
+    }
+
+    const EventTypeID firstTypeID = EventTypeRegistry::Of<OrderedEvent<0>>();
+    const EventTypeID secondTypeID = EventTypeRegistry::Of<OrderedEvent<1>>();
+    assert(firstTypeID != 0 && secondTypeID != 0);
+    assert(firstTypeID != secondTypeID);
+    assert(EventTypeRegistry::Resolve(typeid(OrderedEvent<0>)) == firstTypeID);
+    assert(EventTypeRegistry::TypeOf(secondTypeID) ==
+        std::type_index(typeid(OrderedEvent<1>)));
+    assert(EventTypeRegistry::TypeOf(0) == std::type_index(typeid(void)));
+    const IEvent& erasedEvent = firstTypeEvents[0];
+    assert(erasedEvent.GetEventTypeID() == firstTypeID);
+    {
+        const uint64_t lockedResolves =
+            EventTypeRegistry::GetLockedResolveCount();
+        for (int index = 0; index < 8; ++index) {
+            OrderedEvent<0>* freshEvent = new OrderedEvent<0>();
+            assert(freshEvent->GetEventTypeID() == firstTypeID);
+            delete freshEvent;
+        }
+        assert(EventTypeRegistry::GetLockedResolveCount() == lockedResolves);
+    }
+    {
+        BudgetReceiver idReceiver;
+        TestDispatcher idDispatcher;
+        idDispatcher.RegisterReceiver(secondTypeID, &idReceiver);
+        idDispatcher.QueueEvent(&firstTypeEvents[0]);
+        idDispatcher.QueueEvent(&secondTypeEvents[0]);
+        idDispatcher.Dispatch();
+        idReceiver.Drain(EventDrainBudget{});
+        assert(idReceiver.events.size() == 1);
+        assert(idReceiver.events[0] == &secondTypeEvents[0]);
+        idDispatcher.UnregisterReceiver(
+            std::type_index(typeid(OrderedEvent<1>)), &idReceiver
+        );
+        idDispatcher.QueueEvent(&secondTypeEvents[1]);
+        idDispatcher.Dispatch();
+        idReceiver.Drain(EventDrainBudget{});
+        assert(idReceiver.events.size() == 1);
+    }
+    assert(secondTypeEvents[0].References() == 0);
+
+    {
+        // More concurrent readers than routing slots must all get in
+        constexpr size_t readerCount =
+            ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT + 2;
+        OrderedEvent<0> barrierEvents[readerCount];
+        BudgetReceiver barrierReceiver;
+        barrierReceiver.SetMaximumPendingEventCount(0);
+        RoutingBarrierDispatcher barrierDispatcher;
+        barrierDispatcher.RegisterReceiver(firstTypeID, &barrierReceiver);
+        std::vector<std::thread> readers;
+        for (size_t index = 0; index < readerCount; ++index) {
+            readers.emplace_back([&, index]() {
+                barrierDispatcher.DispatchNow(&barrierEvents[index]);
+            });
+        }
+        {
+            std::unique_lock<std::mutex> lock(barrierDispatcher.mutex);
+            assert(barrierDispatcher.changed.wait_for(
+                lock, std::chrono::seconds(10),
+                [&]() { return barrierDispatcher.inside == readerCount; }
+            ));
+        }
+        barrierDispatcher.RegisterReceiver(secondTypeID, &barrierReceiver);
+        assert(barrierDispatcher.GetRetiredRoutingTableCount() == 1);
+        {
+            std::lock_guard<std::mutex> lock(barrierDispatcher.mutex);
+            barrierDispatcher.released = true;
+        }
+        barrierDispatcher.changed.notify_all();
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        barrierDispatcher.UnregisterReceiver(secondTypeID, &barrierReceiver);
+        assert(barrierDispatcher.GetRetiredRoutingTableCount() == 0);
+        barrierReceiver.Drain(EventDrainBudget{});
+        assert(barrierReceiver.events.size() == readerCount);
+        for (OrderedEvent<0>& barrierEvent : barrierEvents) {
+            assert(barrierEvent.References() == 0);
+        }
+    }
+
+    {
+        // Producers blocked in a full BlockProducer receiver hold no routing read
+        constexpr size_t producerCount =
+            ESPRESSIO_EVENT_DISPATCH_ROUTING_READER_COUNT + 1;
+        OrderedEvent<0> blockedEvents[producerCount + 1];
+        OrderedEvent<1> passingEvent;
+        BudgetReceiver fullReceiver;
+        BudgetReceiver passingReceiver;
+        fullReceiver.SetMaximumPendingEventCount(1);
+        fullReceiver.SetEventQueueOverflowPolicy(
+            EventQueueOverflowPolicy::BlockProducer
+        );
+        TestDispatcher blockingDispatcher;
+        blockingDispatcher.RegisterReceiver(firstTypeID, &fullReceiver);
+        blockingDispatcher.RegisterReceiver(secondTypeID, &passingReceiver);
+        blockingDispatcher.DispatchNow(&blockedEvents[producerCount]);
+        std::vector<std::thread> producers;
+        for (size_t index = 0; index < producerCount; ++index) {
+            producers.emplace_back([&, index]() {
+                blockingDispatcher.DispatchNow(&blockedEvents[index]);
+            });
+        }
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (
+            fullReceiver.GetEventBackpressureStatistics().BlockedProducerCount <
+                producerCount
+        ) {
+            assert(std::chrono::steady_clock::now() < deadline);
+            std::this_thread::yield();
+        }
+        blockingDispatcher.DispatchNow(&passingEvent);
+        blockingDispatcher.QueueEvent(&passingEvent);
+        blockingDispatcher.Dispatch();
+        blockingDispatcher.UnregisterReceiver(secondTypeID, &passingReceiver);
+        assert(blockingDispatcher.GetRetiredRoutingTableCount() == 0);
+        assert(blockingDispatcher.GetRetiredDeliveryBucketCount() == 1);
+        passingReceiver.Drain(EventDrainBudget{});
+        assert(passingReceiver.events.size() == 2);
+        while (fullReceiver.events.size() < producerCount + 1) {
+            assert(std::chrono::steady_clock::now() < deadline);
+            fullReceiver.Drain(EventDrainBudget{});
+            std::this_thread::yield();
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        blockingDispatcher.Dispatch();
+        assert(blockingDispatcher.GetRetiredDeliveryBucketCount() == 0);
+        for (OrderedEvent<0>& blockedEvent : blockedEvents) {
+            assert(blockedEvent.References() == 0);
+        }
+        assert(passingEvent.References() == 0);
+    }
+
+    {
+        // A dispatcher waiting for worker queue space holds no routing read
+        OrderedEvent<0> forwardedEvents[3];
+        BudgetReceiver forwardedReceiver;
+        forwardedReceiver.SetMaximumPendingEventCount(0);
+        BudgetReceiver churnReceiver;
+        WorkerDispatcher forwardingDispatcher;
+        forwardingDispatcher.SetMaximumPendingEventCount(0);
+        assert(forwardingDispatcher.StartWorkers(1, 1));
+        forwardingDispatcher.RegisterReceiver(firstTypeID, &forwardedReceiver);
+        for (OrderedEvent<0>& forwardedEvent : forwardedEvents) {
+            forwardingDispatcher.QueueEvent(&forwardedEvent);
+        }
+        std::thread dispatching([&]() { forwardingDispatcher.Dispatch(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        forwardingDispatcher.RegisterReceiver(secondTypeID, &churnReceiver);
+        forwardingDispatcher.UnregisterReceiver(secondTypeID, &churnReceiver);
+        assert(forwardingDispatcher.GetRetiredRoutingTableCount() == 0);
+        std::thread worker([&]() {
+            while (forwardingDispatcher.ProcessWorker(0)) {
+            }
+        });
+        dispatching.join();
+        forwardingDispatcher.StopWorkers();
+        worker.join();
+        forwardedReceiver.Drain(EventDrainBudget{});
+        assert(forwardedReceiver.events.size() == 3);
+        for (OrderedEvent<0>& forwardedEvent : forwardedEvents) {
+            assert(forwardedEvent.References() == 0);
+        }
+    }
+
+    {
+        BudgetReceiver stableReceiver;
+        BudgetReceiver churnReceiver;
+        stableReceiver.SetMaximumPendingEventCount(0);
+        churnReceiver.SetMaximumPendingEventCount(0);
+        TestDispatcher routingDispatcher;
+        routingDispatcher.SetMaximumPendingEventCount(0);
+        routingDispatcher.RegisterReceiver(firstTypeID, &stableReceiver);
+        std::atomic<bool> churning{true};
+        std::thread churn([&]() {
+            while (churning.load()) {
+                routingDispatcher.RegisterReceiver(firstTypeID, &churnReceiver);
+                routingDispatcher.UnregisterReceiver(firstTypeID, &churnReceiver);
+            }
+        });
+        for (int index = 0; index < 200; ++index) {
+            routingDispatcher.QueueEvent(&firstTypeEvents[index]);
+            routingDispatcher.Dispatch();
+        }
+        churning.store(false);
+        churn.join();
+        routingDispatcher.Dispatch();
+        assert(routingDispatcher.GetRetiredRoutingTableCount() == 0);
+        stableReceiver.Drain(EventDrainBudget{});
+        churnReceiver.Drain(EventDrainBudget{});
+        assert(stableReceiver.events.size() == 200);
+        for (int index = 0; index < 200; ++index) {
+            assert(stableReceiver.events[index] == &firstTypeEvents[index]);
+            assert(firstTypeEvents[index].References() == 0);
+        }
+    }
+
+    {
+        FamilyMemberEvent<0> firstMember;
+        FamilyMemberEvent<1> secondMember;
+        BudgetReceiver familyReceiver;
+        BudgetReceiver memberReceiver;
+        TestDispatcher familyDispatcher;
+        familyDispatcher.RegisterPolymorphicReceiver<FamilyBaseEvent>(
+            &familyReceiver
+        );
+        familyDispatcher.RegisterReceiver(
+            EventTypeRegistry::Of<FamilyMemberEvent<1>>(), &familyReceiver
+        );
+        familyDispatcher.RegisterReceiver(
+            EventTypeRegistry::Of<FamilyMemberEvent<0>>(), &memberReceiver
+        );
+        for (int round = 0; round < 2; ++round) {
+            familyDispatcher.QueueEvent(&firstMember);
+            familyDispatcher.QueueEvent(&secondMember);
+            familyDispatcher.QueueEvent(&firstTypeEvents[0]);
+            familyDispatcher.Dispatch();
+        }
+        familyReceiver.Drain(EventDrainBudget{});
+        memberReceiver.Drain(EventDrainBudget{});
+        assert(familyReceiver.events.size() == 4);
+        assert(familyReceiver.events[0] == &firstMember);
+        assert(familyReceiver.events[1] == &secondMember);
+        assert(memberReceiver.events.size() == 2);
+        familyDispatcher.UnregisterPolymorphicReceiver<FamilyBaseEvent>(
+            &familyReceiver
+        );
+        familyDispatcher.QueueEvent(&firstMember);
+        familyDispatcher.QueueEvent(&secondMember);
+        familyDispatcher.Dispatch();
+        familyReceiver.Drain(EventDrainBudget{});
+        memberReceiver.Drain(EventDrainBudget{});
+        assert(familyReceiver.events.size() == 5);
+        assert(familyReceiver.events[4] == &secondMember);
+        assert(memberReceiver.events.size() == 3);
+        assert(firstMember.References() == 0);
+        assert(secondMember.References() == 0);
+    }
+
+    {
+        DeviceEvent devices[4] = {
+            DeviceEvent(10), DeviceEvent(11), DeviceEvent(12), DeviceEvent(10)
+        };
+        BudgetReceiver firstDeviceReceiver;
+        BudgetReceiver secondDeviceReceiver;
+        BudgetReceiver typeReceiver;
+        TestDispatcher keyedDispatcher;
+        keyedDispatcher.SetUnobservedEventPolicy(
+            UnobservedEventPolicy::Discard
+        );
+        keyedDispatcher.RegisterKeyedReceiver<DeviceEvent>(
+            10, &firstDeviceReceiver
+        );
+        keyedDispatcher.RegisterKeyedReceiver<DeviceEvent>(
+            11, &secondDeviceReceiver
+        );
+        keyedDispatcher.RegisterKeyedReceiver<DeviceEvent>(
+            11, &typeReceiver
+        );
+        keyedDispatcher.RegisterReceiver(
+            EventTypeRegistry::Of<DeviceEvent>(), &typeReceiver
+        );
+        assert(keyedDispatcher.HasSubscribers<DeviceEvent>());
+        for (DeviceEvent& device : devices) {
+            keyedDispatcher.QueueEvent(&device);
+        }
+        keyedDispatcher.Dispatch();
+        firstDeviceReceiver.Drain(EventDrainBudget{});
+        secondDeviceReceiver.Drain(EventDrainBudget{});
+        typeReceiver.Drain(EventDrainBudget{});
+        assert(firstDeviceReceiver.events.size() == 2);
+        assert(firstDeviceReceiver.events[1] == &devices[3]);
+        assert(secondDeviceReceiver.events.size() == 1);
+        assert(secondDeviceReceiver.events[0] == &devices[1]);
+        assert(typeReceiver.events.size() == 4);
+
+        keyedDispatcher.UnregisterReceiver(
+            EventTypeRegistry::Of<DeviceEvent>(), &typeReceiver
+        );
+        keyedDispatcher.UnregisterKeyedReceiver<DeviceEvent>(
+            10, &firstDeviceReceiver
+        );
+        keyedDispatcher.QueueEvent(&devices[0]);
+        assert(keyedDispatcher.GetDiscardedUnobservedEventCount() == 1);
+        keyedDispatcher.DispatchNow(&devices[1]);
+        secondDeviceReceiver.Drain(EventDrainBudget{});
+        typeReceiver.Drain(EventDrainBudget{});
+        assert(secondDeviceReceiver.events.size() == 2);
+        assert(typeReceiver.events.size() == 5);
+        for (const DeviceEvent& device : devices) {
+            assert(device.References() == 0);
+        }
+    }
+
+    {
+        EventTimerWheel wheel(1000, 0);
+        ReferenceTrackingEvent soon;
+        ReferenceTrackingEvent later;
+        ReferenceTrackingEvent distant;
+        ReferenceTrackingEvent overflowing;
+        ReferenceTrackingEvent cancelled;
+        std::vector<IEvent*> fired;
+        const uint64_t overflowDeadline = ((uint64_t(1) << 37) + 5) * 1000;
+        auto record = [&](IEvent* event, EventPriority, EventDispatchMethod) {
+            fired.push_back(event);
+        };
+
+        wheel.Schedule(1500, &soon);
+        wheel.Schedule(70000, &later, EventPriority::High);
+        wheel.Schedule(300000000, &distant);
+        wheel.Schedule(overflowDeadline, &overflowing);
+        const EventTimerHandle handle = wheel.Schedule(5000, &cancelled);
+        assert(wheel.GetScheduledCount() == 5);
+        assert(soon.References() == 1);
+        assert(wheel.GetNextWakeNanoseconds() <= 2000);
+
+        assert(wheel.Advance(1999, record) == 0);
+        assert(wheel.Advance(2000, record) == 1);
+        assert(fired.back() == &soon && soon.References() == 0);
+        assert(wheel.Cancel(handle));
+        assert(!wheel.Cancel(handle));
+        assert(cancelled.References() == 0);
+        assert(wheel.Advance(69999, record) == 0);
+        assert(wheel.Advance(300000000, record) == 2);
+        assert(fired[1] == &later && fired[2] == &distant);
+        assert(wheel.Advance(overflowDeadline - 1, record) == 0);
+        assert(wheel.Advance(overflowDeadline, record) == 1);
+        assert(fired[3] == &overflowing);
+        assert(wheel.GetScheduledCount() == 0);
+        assert(wheel.GetNextWakeNanoseconds() == UINT64_MAX);
+
+        const EventTimerHandle reused = wheel.Schedule(0, &soon);
+        assert(reused.Index == handle.Index || !wheel.Cancel(handle));
+        assert(wheel.Advance(0, record) == 1);
+        assert(!wheel.Cancel(reused));
+
+        constexpr size_t timerCount = 20000;
+        std::vector<ReferenceTrackingEvent> events(timerCount);
+        std::vector<uint64_t> deadlines(timerCount);
+        std::vector<uint64_t> firedAt(timerCount, 0);
+        std::vector<EventTimerHandle> handles(timerCount);
+        const uint64_t start = overflowDeadline;
+        uint64_t seed = 12345;
+        for (size_t index = 0; index < timerCount; ++index) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            deadlines[index] = start + (seed >> 33) % 50000000;
+            handles[index] = wheel.Schedule(deadlines[index], &events[index]);
+        }
+        for (size_t index = 0; index < timerCount; index += 7) {
+            assert(wheel.Cancel(handles[index]));
+        }
+        uint64_t now = start;
+        while (wheel.GetScheduledCount() > 0) {
+            const uint64_t wake = wheel.GetNextWakeNanoseconds();
+            assert(wake > now);
+            now = wake + 3000;
+            wheel.Advance(now, [&](
+                IEvent* event, EventPriority, EventDispatchMethod
+            ) {
+                const size_t index = static_cast<size_t>(
+                    static_cast<ReferenceTrackingEvent*>(event) - events.data()
+                );
+                firedAt[index] = now;
+            });
+        }
+        for (size_t index = 0; index < timerCount; ++index) {
+            assert(events[index].References() == 0);
+            if (index % 7 == 0) {
+                assert(firedAt[index] == 0);
+            } else {
+                assert(firedAt[index] >= deadlines[index]);
+                assert(firedAt[index] < deadlines[index] + 5000);
+            }
+        }
+
+        // A throwing fire leaves its timer, and the ones after it, due
+        wheel.Schedule(now, &soon);
+        wheel.Schedule(now, &later);
+        size_t fireAttempts = 0;
+        try {
+            wheel.Advance(now, [&](IEvent*, EventPriority, EventDispatchMethod) {
+                if (++fireAttempts == 2) {
+                    throw std::runtime_error("fire failed");
+                }
+            });
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(soon.References() == 0);
+        assert(later.References() == 1);
+        assert(wheel.GetScheduledCount() == 1);
+        fired.clear();
+        assert(wheel.Advance(now, record) == 1);
+        assert(fired.size() == 1 && fired[0] == &later);
+        assert(later.References() == 0);
+
+        // fire may cancel the timer it is firing
+        const EventTimerHandle selfCancelling = wheel.Schedule(now, &soon);
+        assert(wheel.Advance(now, [&](
+            IEvent*, EventPriority, EventDispatchMethod
+        ) {
+            assert(wheel.Cancel(selfCancelling));
+        }) == 1);
+        assert(soon.References() == 0 && wheel.GetScheduledCount() == 0);
+
+        wheel.Schedule(now + 1000000, &soon);
+        wheel.Clear();
+        assert(soon.References() == 0 && wheel.GetScheduledCount() == 0);
+    }
+
+    {
+        PeriodicEventSchedule schedule(100);
+        ReferenceTrackingEvent sample;
+        std::vector<PeriodicEventTick> fastTicks;
+        std::vector<PeriodicEventEmission> emissions;
+        const PeriodicEventHandle fast = schedule.Add(
+            1000, 1000, [&](const PeriodicEventTick& tick) -> IEvent* {
+                fastTicks.push_back(tick);
+                return &sample;
+            }, EventPriority::High
+        );
+        const PeriodicEventHandle slow = schedule.Add(
+            1000, 3000, [&](const PeriodicEventTick&) -> IEvent* {
+                return &sample;
+            }
+        );
+        const PeriodicEventHandle skipping = schedule.Add(
+            1500, 1000, [](const PeriodicEventTick&) -> IEvent* {
+                return nullptr;
+            }
+        );
+        assert(!schedule.Add(0, 0, [](const PeriodicEventTick&) -> IEvent* {
+            return nullptr;
+        }).IsValid());
+        assert(schedule.GetEmitterCount() == 3);
+        assert(schedule.GetNextDueNanoseconds() == 1000);
+
+        assert(schedule.Poll(999, emissions) == 0);
+        assert(schedule.Poll(1050, emissions) == 2);
+        assert(emissions[0].Priority == EventPriority::High);
+        assert(emissions[1].Priority == EventPriority::Normal);
+        assert(schedule.GetNextDueNanoseconds() == 1500);
+
+        emissions.clear();
+        assert(schedule.Poll(2080, emissions) == 1);
+        assert(fastTicks.back().ScheduledNanoseconds == 2000);
+        assert(fastTicks.back().LatenessNanoseconds == 80);
+
+        emissions.clear();
+        assert(schedule.Poll(5700, emissions) == 2);
+        assert(fastTicks.back().ScheduledNanoseconds == 5000);
+        assert(fastTicks.back().MissedTicks == 2);
+        assert(schedule.GetNextDueNanoseconds() == 6000);
+
+        PeriodicEventStatistics statistics;
+        assert(schedule.GetStatistics(fast, statistics));
+        assert(statistics.EmittedTickCount == 3);
+        assert(statistics.MissedTickCount == 2);
+        assert(statistics.LateTickCount == 1);
+        assert(statistics.MaximumLatenessNanoseconds == 700);
+        assert(schedule.GetStatistics(slow, statistics));
+        assert(statistics.EmittedTickCount == 2 && statistics.MissedTickCount == 0);
+        assert(schedule.GetStatistics(skipping, statistics));
+        assert(statistics.EmittedTickCount == 2 && statistics.MissedTickCount == 3);
+
+        assert(schedule.Remove(fast));
+        assert(!schedule.Remove(fast));
+        assert(!schedule.GetStatistics(fast, statistics));
+        emissions.clear();
+        assert(schedule.Poll(7000, emissions) == 1);
+        assert(fastTicks.size() == 3);
+        assert(schedule.Remove(slow) && schedule.Remove(skipping));
+        assert(schedule.GetNextDueNanoseconds() == UINT64_MAX);
+        assert(schedule.GetStatistics().EmittedTickCount == 9);
+        assert(sample.References() == 0);
+    }
+
+    {
+        const char* path = "espressio_event_journal_test.evj";
+        SteppingClock clock;
+        clock.step = 1000000;
+        EventJournalTransport journal(&clock);
+        assert(journal.Open(path));
+        std::vector<std::vector<uint8_t>> packets;
+        for (uint64_t message = 1; message <= 6; ++message) {
+            packets.push_back(CreateTransportPacket(
+                message % 2 == 0 ? 0xB : 0xA, message, static_cast<uint8_t>(message)
+            ));
+            const std::vector<uint8_t>& packet = packets.back();
+            assert(journal.Send(EventTransportPacket{packet.data(), packet.size(), message}));
+        }
+        std::vector<uint8_t> invalid = packets[0];
+        invalid.pop_back();
+        assert(!journal.Send(EventTransportPacket{invalid.data(), invalid.size(), 0}));
+        assert(journal.GetRecordCount() == 6);
+        assert(journal.GetFailedAppendCount() == 1);
+        journal.Close();
+
+        std::FILE* file = std::fopen(path, "ab");
+        assert(file != nullptr);
+        const uint8_t partial[5] = {0x52, 0x4A, 0x56, 0x45, 0x01};
+        assert(std::fwrite(partial, 1, sizeof(partial), file) == sizeof(partial));
+        std::fclose(file);
+
+        EventJournalReader reader;
+        assert(reader.Open(path));
+        assert(reader.HasTruncatedTail());
+        const EventJournalIndex& index = reader.GetIndex();
+        assert(index.GetCount() == 6);
+        for (size_t position = 0; position < index.GetCount(); ++position) {
+            const EventTransportPacket packet = reader.GetPacket(index[position]);
+            assert(packet.Size == packets[position].size());
+            assert(std::memcmp(packet.Data, packets[position].data(), packet.Size) == 0);
+            assert(index[position].TimestampNanoseconds == (position + 1) * 1000000);
+        }
+        assert(index.GetEntriesOfType(0xA)->size() == 3);
+        assert(index.GetEntriesOfType(0xC) == nullptr);
+        assert(index.LowerBound(2500000) == 2);
+        assert(index.LowerBoundOfType(0xB, 2500000) == 1);
+
+        EventJournalReplay replay;
+        std::vector<uint64_t> messages;
+        EventJournalReplayOptions options;
+        options.Speed = EventJournalReplayOptions::AsFastAsPossible;
+        options.EventTypeID = 0xA;
+        options.FromNanoseconds = 2000000;
+        EventJournalReplayResult result = replay.Replay(reader, options, [&](
+            const EventTransportPacket& packet, const EventJournalEntry& entry
+        ) {
+            assert(packet.MessageID == entry.MessageID);
+            messages.push_back(entry.MessageID);
+        });
+        assert(result.ReplayedCount == 2);
+        assert((messages == std::vector<uint64_t>{3, 5}));
+
+        options = EventJournalReplayOptions{};
+        options.Speed = 2.0;
+        options.ToNanoseconds = 5000000;
+        result = replay.Replay(reader, options, [](
+            const EventTransportPacket&, const EventJournalEntry&
+        ) { });
+        assert(result.ReplayedCount == 5);
+        assert(result.ElapsedNanoseconds >= 2000000);
+
+        RecordingTransportReceiver receiver;
+        journal.SetReceiver(&receiver);
+        result = journal.Replay(reader, EventJournalReplayOptions{
+            EventJournalReplayOptions::AsFastAsPossible
+        });
+        assert(result.ReplayedCount == 6);
+        assert(receiver.transport == &journal);
+        assert(receiver.packets.size() == 6 && receiver.packets[5] == packets[5]);
+        reader.Close();
+        std::remove(path);
+    }
 }
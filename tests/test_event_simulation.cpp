@@ -0,0 +1,395 @@
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#define ESPRESSIO_EVENT_SIMULATION_MAX_STEPS_PER_INSTANT 1000
+
+#include "ESPressio_Event.hpp"
+#include "ESPressio_EventReceiver.hpp"
+#include "ESPressio_EventSimulation.hpp"
+#include "ESPressio_EventThread.hpp"
+
+using namespace ESPressio::Event;
+
+class SimulatedEvent final : public IEvent {
+    private:
+        int _references = 0;
+        EventDispatchContext _dispatchContext{};
+
+    public:
+        uint64_t createdNanoseconds = 0;
+
+        void __ref() noexcept override { ++_references; }
+        void __unref() noexcept override {
+            assert(_references > 0);
+            --_references;
+        }
+        void __dispatch() override { }
+        void __setDispatchContext(const EventDispatchContext& context) override {
+            _dispatchContext = context;
+        }
+        EventDispatchContext __getDispatchContext() const override {
+            return _dispatchContext;
+        }
+        void Queue(EventPriority = EventPriority::Normal) override { }
+        void Stack(EventPriority = EventPriority::Normal) override { }
+        uint64_t GetDispatchTimeNanoseconds() const override { return 0; }
+        uint64_t GetTimeSinceDispatchNanoseconds() const override { return 0; }
+        int References() const { return _references; }
+};
+
+struct SimulationRecord {
+    int process;
+    uint64_t nanoseconds;
+
+    bool operator==(const SimulationRecord& other) const {
+        return process == other.process && nanoseconds == other.nanoseconds;
+    }
+};
+
+// Drains like an EventThread, charging each Event's handling to virtual time
+class SimulatedConsumer final :
+    public EventReceiver,
+    public IEventSimulationProcess {
+    public:
+        EventSimulation* simulation = nullptr;
+        std::vector<SimulationRecord>* log = nullptr;
+        uint64_t handlingNanoseconds = 0;
+        size_t exhaustedCount = 0;
+
+        uint64_t GetNextSimulationWakeNanoseconds(uint64_t now) override {
+            return GetPendingEventCount() == 0
+                ? std::numeric_limits<uint64_t>::max()
+                : now;
+        }
+
+        void RunSimulationStep(uint64_t) override {
+            const EventDrainResult result = WithEvents([&](
+                IEvent* event, EventDispatchMethod, EventPriority
+            ) {
+                simulation->Consume(handlingNanoseconds);
+                log->push_back(SimulationRecord{
+                    2,
+                    simulation->GetNowNanoseconds() -
+                        static_cast<SimulatedEvent*>(event)->createdNanoseconds
+                });
+            }, GetEventDrainBudget());
+            if (result.BudgetExhausted) {
+                ++exhaustedCount;
+            }
+        }
+};
+
+// Produces a burst of Events every period, drift-free
+class SimulatedProducer final : public IEventSimulationProcess {
+    public:
+        SimulatedConsumer* consumer = nullptr;
+        std::vector<SimulationRecord>* log = nullptr;
+        SimulatedEvent* events = nullptr;
+        size_t burst = 0;
+        size_t produced = 0;
+        size_t limit = 0;
+        uint64_t period = 0;
+        uint64_t due = 0;
+
+        uint64_t GetNextSimulationWakeNanoseconds(uint64_t) override {
+            return produced == limit ? std::numeric_limits<uint64_t>::max() : due;
+        }
+
+        void RunSimulationStep(uint64_t now) override {
+            log->push_back(SimulationRecord{1, now});
+            for (size_t index = 0; index < burst && produced < limit; ++index) {
+                events[produced].createdNanoseconds = EventClock::GetNowNanoseconds();
+                consumer->QueueEvent(&events[produced++]);
+            }
+            due += period;
+        }
+};
+
+class BusyProcess final : public IEventSimulationProcess {
+    public:
+        uint64_t GetNextSimulationWakeNanoseconds(uint64_t now) override { return now; }
+        void RunSimulationStep(uint64_t) override { }
+};
+
+class BusEvent final : public Event<> {
+    public:
+        int* deliveries;
+
+        explicit BusEvent(int* deliveryCounter) : deliveries(deliveryCounter) {}
+};
+
+class BusThread final : public EventThread {
+    public:
+        std::vector<int*> received;
+        EventListenerHandlePtr listener;
+
+        BusThread() : EventThread(false) {}
+
+        void Listen() {
+            listener = RegisterListener<BusEvent>([this](BusEvent* event, EventDispatchMethod, EventPriority) {
+                ++*event->deliveries;
+                received.push_back(event->deliveries);
+            });
+        }
+};
+
+class BusLoopThread final : public EventThreadWithLoop {
+    public:
+        std::vector<int> order;
+        EventListenerHandlePtr listener;
+
+        BusLoopThread() : EventThreadWithLoop(false) {}
+
+        void Listen() {
+            listener = RegisterListener<BusEvent>([this](BusEvent* event, EventDispatchMethod, EventPriority) {
+                ++*event->deliveries;
+                order.push_back(1);
+            });
+        }
+
+    protected:
+        void OnThreadLoop() override { order.push_back(0); }
+};
+
+class InterestEvent final : public Event<> {};
+
+class SelectiveObserver final : public IEventManagerObserver {
+    public:
+        bool DeclaresEventTypeInterest() const override { return true; }
+};
+
+static std::vector<SimulationRecord> RunProducerConsumer(size_t& exhaustedCount) {
+    std::vector<SimulationRecord> log;
+    SimulatedEvent events[12];
+    {
+        EventSimulation simulation(1000);
+        assert(EventClock::GetNowNanoseconds() == 1000);
+
+        SimulatedConsumer consumer;
+        consumer.simulation = &simulation;
+        consumer.log = &log;
+        consumer.handlingNanoseconds = 300;
+        EventDrainBudget budget;
+        budget.MaximumDurationNanoseconds = 500;
+        consumer.SetEventDrainBudget(budget);
+
+        SimulatedProducer producer;
+        producer.consumer = &consumer;
+        producer.log = &log;
+        producer.events = events;
+        producer.burst = 3;
+        producer.limit = 12;
+        producer.period = 1000000;
+        producer.due = 1000000;
+
+        simulation.AddProcess(&producer);
+        simulation.AddProcess(&consumer);
+        simulation.AddProcess(&producer);
+
+        assert(simulation.RunFor(10000000));
+        assert(!simulation.HasStalled());
+        assert(simulation.GetNowNanoseconds() == 10001000);
+        assert(consumer.GetPendingEventCount() == 0);
+        exhaustedCount = consumer.exhaustedCount;
+    }
+    assert(EventClock::GetOverride() == nullptr);
+    for (SimulatedEvent& event : events) {
+        assert(event.References() == 0);
+    }
+    return log;
+}
+
+int main() {
+    assert(EventClock::GetOverride() == nullptr);
+
+    size_t exhaustedCount = 0;
+    const std::vector<SimulationRecord> first = RunProducerConsumer(exhaustedCount);
+
+    // 4 bursts; the 500 ns budget lets two 300 ns Events through per drain
+    assert(first.size() == 16);
+    assert(exhaustedCount == 4);
+    const uint64_t latencies[3] = {300, 600, 900};
+    for (size_t burst = 0; burst < 4; ++burst) {
+        const SimulationRecord* records = &first[burst * 4];
+        assert(records[0].process == 1);
+        assert(records[0].nanoseconds == 1000000 * (burst + 1));
+        for (size_t index = 0; index < 3; ++index) {
+            assert(records[index + 1].process == 2);
+            assert(records[index + 1].nanoseconds == latencies[index]);
+        }
+    }
+
+    size_t repeatExhaustedCount = 0;
+    assert(RunProducerConsumer(repeatExhaustedCount) == first);
+    assert(repeatExhaustedCount == exhaustedCount);
+
+    {
+        EventManager* defaultBus = EventManager::GetInstance();
+        assert(EventManager::GetBus(nullptr) == defaultBus);
+        assert(EventManager::GetBus("") == defaultBus);
+        assert(EventManager::GetBus("telemetry") == nullptr);
+        assert(defaultBus->GetBusName()[0] == '\0');
+
+        EventBusOptions options;
+        options.MaximumPendingEventCount = 2;
+        options.OverflowPolicy = EventQueueOverflowPolicy::RejectIncoming;
+        EventManager* telemetry = EventManager::CreateBus("telemetry", options);
+        assert(telemetry != nullptr && telemetry != defaultBus);
+        assert(std::strcmp(telemetry->GetBusName(), "telemetry") == 0);
+        assert(EventManager::GetBus("telemetry") == telemetry);
+        assert(EventManager::CreateBus("telemetry") == nullptr);
+        assert(EventManager::CreateBus("") == nullptr);
+        assert(EventManager::GetBus("missing") == nullptr);
+
+        assert(telemetry->GetMaximumPendingEventCount() == 2);
+        assert(
+            telemetry->GetEventQueueOverflowPolicy() ==
+                EventQueueOverflowPolicy::RejectIncoming
+        );
+        assert(
+            defaultBus->GetMaximumPendingEventCount() ==
+                ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT
+        );
+        assert(ESPRESSIO_EVENT_DEFAULT_MAX_PENDING_EVENT_COUNT == 64);
+        assert(
+            defaultBus->GetEventQueueOverflowPolicy() ==
+                EventQueueOverflowPolicy::BlockProducer
+        );
+
+        BusThread telemetryThread;
+        assert(telemetryThread.SetEventBus(defaultBus));
+        assert(telemetryThread.SetEventBus(telemetry));
+        assert(telemetryThread.GetEventBus() == telemetry);
+        telemetryThread.Listen();
+        BusThread defaultThread;
+        assert(defaultThread.GetEventBus() == defaultBus);
+        defaultThread.Listen();
+
+        // The bus is latched once a listener is registered
+        assert(!telemetryThread.SetEventBus(defaultBus));
+        assert(telemetryThread.GetEventBus() == telemetry);
+        assert(!defaultThread.SetEventBus(telemetry));
+        assert(defaultThread.GetEventBus() == defaultBus);
+
+        EventSimulation simulation;
+        simulation.AddProcess(defaultBus);
+        simulation.AddProcess(telemetry);
+        simulation.AddProcess(&telemetryThread);
+        simulation.AddProcess(&defaultThread);
+
+        // Only the telemetry bus fills up; the default bus keeps accepting
+        int telemetryDeliveries = 0;
+        int defaultDeliveries = 0;
+        for (int index = 0; index < 3; ++index) {
+            BusEvent* event = new BusEvent(&telemetryDeliveries);
+            event->SetEventBus(telemetry);
+            assert(event->GetEventBus() == telemetry);
+            event->Queue();
+            (new BusEvent(&defaultDeliveries))->Queue();
+        }
+        assert(telemetry->GetPendingEventCount() == 2);
+        assert(telemetry->GetRejectedEventCount() == 1);
+        assert(defaultBus->GetPendingEventCount() == 3);
+        assert(defaultBus->GetRejectedEventCount() == 0);
+
+        assert(simulation.RunFor(1000));
+        assert(telemetryDeliveries == 2);
+        assert(defaultDeliveries == 3);
+        assert(telemetryThread.received.size() == 2);
+        assert(defaultThread.received.size() == 3);
+        for (int* deliveries : telemetryThread.received) {
+            assert(deliveries == &telemetryDeliveries);
+        }
+        for (int* deliveries : defaultThread.received) {
+            assert(deliveries == &defaultDeliveries);
+        }
+
+        // Batches are split by target bus
+        BusEvent* mixed[] = {
+            new BusEvent(&telemetryDeliveries),
+            new BusEvent(&defaultDeliveries),
+            new BusEvent(&telemetryDeliveries)
+        };
+        mixed[0]->SetEventBus(telemetry);
+        mixed[2]->SetEventBus(telemetry);
+        IEvent* batch[] = { mixed[0], mixed[1], mixed[2] };
+        Event<>::QueueAll(batch);
+        assert(telemetry->GetPendingEventCount() == 2);
+        assert(defaultBus->GetPendingEventCount() == 1);
+        assert(simulation.RunFor(1000));
+        assert(telemetryDeliveries == 4);
+        assert(defaultDeliveries == 4);
+
+    }
+
+    {
+        // A loop thread runs one iteration per step while Events are pending
+        EventManager* defaultBus = EventManager::GetInstance();
+        BusLoopThread loopThread;
+        loopThread.Listen();
+        EventSimulation simulation;
+        simulation.AddProcess(defaultBus);
+        simulation.AddProcess(&loopThread);
+        assert(simulation.RunFor(1000));
+        assert(loopThread.order.empty());
+
+        int deliveries = 0;
+        (new BusEvent(&deliveries))->Queue();
+        (new BusEvent(&deliveries))->Queue();
+        assert(simulation.RunFor(1000));
+        assert(deliveries == 2);
+        assert((loopThread.order == std::vector<int>{1, 1, 0}));
+
+        loopThread.order.clear();
+        loopThread.SetProcessOrder(EventThreadProcessOrder::EventsAfterLoop);
+        (new BusEvent(&deliveries))->Queue();
+        assert(simulation.RunFor(1000));
+        assert(deliveries == 3);
+        assert((loopThread.order == std::vector<int>{0, 1}));
+    }
+
+    {
+        // One selective observer keeps its interest on each bus it declared on
+        EventManager* first = EventManager::CreateBus("interest-first");
+        EventManager* second = EventManager::CreateBus("interest-second");
+        SelectiveObserver observer;
+        assert(!first->HasSubscribers<InterestEvent>());
+        first->DeclareObserverInterest<InterestEvent>(&observer);
+        second->DeclareObserverInterest<InterestEvent>(&observer);
+        assert(first->HasSubscribers<InterestEvent>());
+        assert(second->HasSubscribers<InterestEvent>());
+        first->UnregisterObserver(&observer);
+        assert(!first->HasSubscribers<InterestEvent>());
+        assert(second->HasSubscribers<InterestEvent>());
+        second->WithdrawObserverInterest<InterestEvent>(&observer);
+        assert(!second->HasSubscribers<InterestEvent>());
+        second->UnregisterObserver(&observer);
+
+        SelectiveObserver successor;
+        first->DeclareObserverInterest<InterestEvent>(&successor);
+        assert(first->HasSubscribers<InterestEvent>());
+        first->UnregisterObserver(&successor);
+        assert(!first->HasSubscribers<InterestEvent>());
+    }
+
+    {
+        EventSimulation simulation;
+        BusyProcess busy;
+        simulation.AddProcess(&busy);
+        assert(!simulation.RunFor(1000));
+        assert(simulation.HasStalled());
+        assert(simulation.GetNowNanoseconds() == 0);
+        assert(simulation.GetStepCount() == ESPRESSIO_EVENT_SIMULATION_MAX_STEPS_PER_INSTANT);
+        simulation.RemoveProcess(&busy);
+        assert(simulation.RunFor(1000));
+        assert(simulation.GetNowNanoseconds() == 1000);
+
+        simulation.GetClock().SetNowNanoseconds(10);
+        assert(simulation.GetNowNanoseconds() == 1000);
+    }
+
+    return 0;
+}